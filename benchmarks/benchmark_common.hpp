@@ -0,0 +1,283 @@
+#ifndef __UT_BENCHMARK_COMMON_HPP__
+#define __UT_BENCHMARK_COMMON_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace unitree
+{
+namespace benchmark
+{
+/*
+ * --key value options, a bare --flag reads as "1".
+ */
+class BenchmarkOption
+{
+public:
+    BenchmarkOption(int argc, const char** argv)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string key = argv[i];
+            if (key.compare(0, 2, "--") != 0)
+            {
+                continue;
+            }
+
+            key = key.substr(2);
+            if (i + 1 < argc && std::string(argv[i + 1]).compare(0, 2, "--") != 0)
+            {
+                mOption[key] = argv[++i];
+            }
+            else
+            {
+                mOption[key] = "1";
+            }
+        }
+    }
+
+    bool Has(const std::string& key) const
+    {
+        return mOption.find(key) != mOption.end();
+    }
+
+    std::string Get(const std::string& key, const std::string& value) const
+    {
+        auto iter = mOption.find(key);
+        return iter == mOption.end() ? value : iter->second;
+    }
+
+    double Get(const std::string& key, double value) const
+    {
+        auto iter = mOption.find(key);
+        return iter == mOption.end() ? value : atof(iter->second.c_str());
+    }
+
+    /*
+     * comma separated list.
+     */
+    std::vector<std::string> GetList(const std::string& key, const std::string& value) const
+    {
+        std::vector<std::string> list;
+        std::stringstream ss(Get(key, value));
+        std::string item;
+        while (std::getline(ss, item, ','))
+        {
+            if (!item.empty())
+            {
+                list.push_back(item);
+            }
+        }
+        return list;
+    }
+
+private:
+    std::map<std::string, std::string> mOption;
+};
+
+/*
+ * Latency distribution of nanosecond samples, reported in microseconds.
+ */
+class LatencyStats
+{
+public:
+    explicit LatencyStats(std::vector<int64_t> sample) :
+        mSample(std::move(sample))
+    {
+        std::sort(mSample.begin(), mSample.end());
+    }
+
+    size_t GetNumber() const
+    {
+        return mSample.size();
+    }
+
+    /*
+     * @brief nearest rank percentile, p in [0, 100].
+     */
+    double GetPercentile(double p) const
+    {
+        if (mSample.empty())
+        {
+            return 0.0;
+        }
+
+        size_t rank = (size_t)std::ceil(p / 100.0 * mSample.size());
+        rank = std::min(std::max(rank, (size_t)1), mSample.size());
+        return mSample[rank - 1] * 1e-3;
+    }
+
+    double GetMean() const
+    {
+        if (mSample.empty())
+        {
+            return 0.0;
+        }
+
+        double sum = 0.0;
+        for (int64_t s : mSample)
+        {
+            sum += s;
+        }
+        return sum / mSample.size() * 1e-3;
+    }
+
+    double GetMax() const
+    {
+        return mSample.empty() ? 0.0 : mSample.back() * 1e-3;
+    }
+
+private:
+    std::vector<int64_t> mSample;
+};
+
+/*
+ * One result as a single line JSON object, keys in insertion order, so a
+ * run is JSON Lines that diff and parse per release.
+ */
+class BenchmarkRecord
+{
+public:
+    explicit BenchmarkRecord(const std::string& benchmark)
+    {
+        Add("benchmark", benchmark);
+    }
+
+    BenchmarkRecord& Add(const std::string& key, const std::string& value)
+    {
+        Key(key);
+        Quote(value);
+        return *this;
+    }
+
+    BenchmarkRecord& Add(const std::string& key, const char* value)
+    {
+        return Add(key, std::string(value));
+    }
+
+    BenchmarkRecord& Add(const std::string& key, double value)
+    {
+        Key(key);
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.3f", std::isfinite(value) ? value : 0.0);
+        mStream << buf;
+        return *this;
+    }
+
+    BenchmarkRecord& Add(const std::string& key, int64_t value)
+    {
+        Key(key);
+        mStream << value;
+        return *this;
+    }
+
+    BenchmarkRecord& Add(const std::string& key, uint64_t value)
+    {
+        return Add(key, (int64_t)value);
+    }
+
+    BenchmarkRecord& Add(const std::string& key, int32_t value)
+    {
+        return Add(key, (int64_t)value);
+    }
+
+    BenchmarkRecord& AddNull(const std::string& key)
+    {
+        Key(key);
+        mStream << "null";
+        return *this;
+    }
+
+    BenchmarkRecord& Add(const std::string& key, const std::vector<uint64_t>& values)
+    {
+        Key(key);
+        mStream << '[';
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            mStream << (i > 0 ? ", " : "") << values[i];
+        }
+        mStream << ']';
+        return *this;
+    }
+
+    /*
+     * @brief sample count, then percentiles, null when there were no samples.
+     */
+    BenchmarkRecord& Add(const std::string& key, const LatencyStats& stats)
+    {
+        Add(key + "_samples", (uint64_t)stats.GetNumber());
+        if (stats.GetNumber() == 0)
+        {
+            AddNull(key + "_p50_us");
+            AddNull(key + "_p99_us");
+            AddNull(key + "_p999_us");
+            AddNull(key + "_max_us");
+            AddNull(key + "_mean_us");
+            return *this;
+        }
+
+        Add(key + "_p50_us", stats.GetPercentile(50));
+        Add(key + "_p99_us", stats.GetPercentile(99));
+        Add(key + "_p999_us", stats.GetPercentile(99.9));
+        Add(key + "_max_us", stats.GetMax());
+        Add(key + "_mean_us", stats.GetMean());
+        return *this;
+    }
+
+    void Print(FILE* file = stdout) const
+    {
+        fprintf(file, "{%s}\n", mStream.str().c_str());
+        fflush(file);
+    }
+
+private:
+    void Key(const std::string& key)
+    {
+        if (mStream.tellp() > 0)
+        {
+            mStream << ", ";
+        }
+        Quote(key);
+        mStream << ": ";
+    }
+
+    /*
+     * @brief JSON string, with quote, backslash and control characters escaped.
+     */
+    void Quote(const std::string& value)
+    {
+        mStream << '"';
+        for (char c : value)
+        {
+            if (c == '"' || c == '\\')
+            {
+                mStream << '\\' << c;
+            }
+            else if ((unsigned char)c < 0x20)
+            {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", (unsigned char)c);
+                mStream << buf;
+            }
+            else
+            {
+                mStream << c;
+            }
+        }
+        mStream << '"';
+    }
+
+private:
+    std::ostringstream mStream;
+};
+
+}
+}
+
+#endif//__UT_BENCHMARK_COMMON_HPP__
@@ -0,0 +1,341 @@
+#include <unitree/common/time/deadline_timer.hpp>
+#include <unitree/common/time/sleep.hpp>
+#include <unitree/idl/go2/HeightMap_.hpp>
+#include <unitree/idl/go2/LowCmd_.hpp>
+#include <unitree/idl/go2/LowState_.hpp>
+#include <unitree/idl/hg/LowCmd_.hpp>
+#include <unitree/idl/hg/LowState_.hpp>
+#include <unitree/idl/ros2/PointCloud2_.hpp>
+#include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+
+#include <atomic>
+#include <iostream>
+
+#include "benchmark_common.hpp"
+
+using namespace unitree;
+using namespace unitree::robot;
+using namespace unitree::benchmark;
+
+/*
+ * Publisher -> subscriber latency and throughput of channels in one
+ * process, over DDS on the given interface or the in-process loopback
+ * transport. Every case runs two phases on one topic:
+ *
+ *   paced: count messages at rate, latency is write call to handler entry
+ *   burst: count messages back to back, throughput is received messages
+ *          over first write to last handler entry
+ *
+ * A sequence number is carried in a field the benchmark does not otherwise
+ * need (crc, tick or stamp). Results are JSON Lines on stdout; loopback
+ * reports no throughput_mb_s, it moves no bytes.
+ *
+ *     channel_benchmark [--transport dds|loopback] [--interface lo]
+ *                       [--config qos.json] [--type go2_lowcmd,...]
+ *                       [--queuelen 0,8] [--cloud-mb 1,10] [--map-size 128]
+ *                       [--count N] [--rate Hz]
+ *
+ * --config passes an SDK dds config file (participant, topic, writer and
+ * reader qos) to ChannelFactory::Init to compare qos profiles.
+ */
+
+const uint32_t SEQUENCE_WARMUP = 0xFFFFFFFF;
+
+/*
+ * sequence number carrier of each message type.
+ */
+inline void SetSequence(unitree_go::msg::dds_::LowCmd_& msg, uint32_t seq) { msg.crc(seq); }
+inline uint32_t GetSequence(const unitree_go::msg::dds_::LowCmd_& msg) { return msg.crc(); }
+
+inline void SetSequence(unitree_go::msg::dds_::LowState_& msg, uint32_t seq) { msg.tick(seq); }
+inline uint32_t GetSequence(const unitree_go::msg::dds_::LowState_& msg) { return msg.tick(); }
+
+inline void SetSequence(unitree_hg::msg::dds_::LowCmd_& msg, uint32_t seq) { msg.crc(seq); }
+inline uint32_t GetSequence(const unitree_hg::msg::dds_::LowCmd_& msg) { return msg.crc(); }
+
+inline void SetSequence(unitree_hg::msg::dds_::LowState_& msg, uint32_t seq) { msg.tick(seq); }
+inline uint32_t GetSequence(const unitree_hg::msg::dds_::LowState_& msg) { return msg.tick(); }
+
+inline void SetSequence(sensor_msgs::msg::dds_::PointCloud2_& msg, uint32_t seq) { msg.header().stamp().nanosec(seq); }
+inline uint32_t GetSequence(const sensor_msgs::msg::dds_::PointCloud2_& msg) { return msg.header().stamp().nanosec(); }
+
+inline void SetSequence(unitree_go::msg::dds_::HeightMap_& msg, uint32_t seq) { msg.stamp(seq); }
+inline uint32_t GetSequence(const unitree_go::msg::dds_::HeightMap_& msg) { return (uint32_t)msg.stamp(); }
+
+struct ChannelCaseParam
+{
+    std::string transport;
+    std::string type;
+    size_t bytes = 0;
+    int64_t queuelen = 0;
+    uint32_t count = 0;
+    double rate = 0.0;
+};
+
+template<typename MSG>
+class ChannelCase
+{
+public:
+    explicit ChannelCase(const ChannelCaseParam& param) :
+        mParam(param), mWarmup(false), mReceived(0), mBurstReceived(0), mBurstLast(0)
+    {}
+
+    void Run(MSG& msg, const std::string& topic)
+    {
+        const uint32_t count = mParam.count;
+        mSend.assign(count, 0);
+        mRecv.assign(count, -1);
+
+        ChannelPublisher<MSG> publisher(topic);
+        publisher.InitChannel();
+
+        ChannelSubscriber<MSG> subscriber(topic);
+        subscriber.InitChannel(std::bind(&ChannelCase::Handler, this, std::placeholders::_1), mParam.queuelen);
+
+        BenchmarkRecord record("channel");
+        record.Add("transport", mParam.transport).Add("type", mParam.type).Add("bytes", (uint64_t)mParam.bytes)
+            .Add("queuelen", mParam.queuelen).Add("count", (uint64_t)count).Add("rate_hz", mParam.rate);
+
+        /*
+         * wait for the reader to match before anything is counted
+         */
+        SetSequence(msg, SEQUENCE_WARMUP);
+        for (int32_t i = 0; i < 500 && !mWarmup; i++)
+        {
+            publisher.Write(msg);
+            common::MicroSleep(10000);
+        }
+
+        if (!mWarmup)
+        {
+            record.Add("error", "reader not matched").Print();
+            return;
+        }
+
+        common::MicroSleep(100000);
+
+        common::DeadlineTimer timer((int64_t)(1e9 / mParam.rate));
+        timer.Start();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            timer.Wait();
+            SetSequence(msg, i);
+            mSend[i] = common::DeadlineTimer::GetClock();
+            publisher.Write(msg);
+        }
+        Drain(mReceived, count);
+
+        const int64_t burstStart = common::DeadlineTimer::GetClock();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            SetSequence(msg, count + i);
+            publisher.Write(msg);
+        }
+        Drain(mBurstReceived, count);
+
+        subscriber.CloseChannel();
+        publisher.CloseChannel();
+
+        std::vector<int64_t> latency;
+        latency.reserve(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (mRecv[i] >= 0)
+            {
+                latency.push_back(mRecv[i] - mSend[i]);
+            }
+        }
+
+        const uint64_t burstReceived = mBurstReceived;
+        const double burstTime = (mBurstLast - burstStart) * 1e-9;
+        const double throughput = burstTime > 0 ? burstReceived / burstTime : 0.0;
+
+        record.Add("received", (uint64_t)latency.size()).Add("lost", (uint64_t)(count - latency.size()))
+            .Add("latency", LatencyStats(latency))
+            .Add("burst_received", burstReceived).Add("burst_lost", (uint64_t)(count - burstReceived))
+            .Add("throughput_msg_s", throughput);
+
+        /*
+         * loopback hands over pointers, bytes are never copied
+         */
+        if (mParam.transport != "loopback")
+        {
+            record.Add("throughput_mb_s", throughput * mParam.bytes / (1024.0 * 1024.0));
+        }
+
+        record.Print();
+    }
+
+private:
+    void Handler(const void* message)
+    {
+        const int64_t now = common::DeadlineTimer::GetClock();
+        const uint32_t seq = GetSequence(*(const MSG*)message);
+
+        if (seq == SEQUENCE_WARMUP)
+        {
+            mWarmup = true;
+        }
+        else if (seq < mParam.count)
+        {
+            mRecv[seq] = now;
+            mReceived++;
+        }
+        else if (seq < 2 * mParam.count)
+        {
+            mBurstLast = now;
+            mBurstReceived++;
+        }
+    }
+
+    /*
+     * @brief until all count arrived or nothing arrived for 1s.
+     */
+    void Drain(const std::atomic<uint64_t>& received, uint64_t count)
+    {
+        uint64_t last = received;
+        int64_t idle = common::DeadlineTimer::GetClock();
+        while (received < count)
+        {
+            common::MicroSleep(1000);
+            const int64_t now = common::DeadlineTimer::GetClock();
+            if (received != last)
+            {
+                last = received;
+                idle = now;
+            }
+            else if (now - idle > 1000000000)
+            {
+                break;
+            }
+        }
+    }
+
+private:
+    ChannelCaseParam mParam;
+    std::vector<int64_t> mSend;
+    std::vector<int64_t> mRecv;
+
+    std::atomic<bool> mWarmup;
+    std::atomic<uint64_t> mReceived;
+    std::atomic<uint64_t> mBurstReceived;
+    std::atomic<int64_t> mBurstLast;
+};
+
+template<typename MSG>
+void RunCase(MSG& msg, ChannelCaseParam param, const BenchmarkOption& option, uint32_t count, double rate)
+{
+    static uint32_t caseNumber = 0;
+
+    param.count = (uint32_t)option.Get("count", (double)count);
+    param.rate = option.Get("rate", rate);
+
+    const std::string topic = "bench/channel/" + param.type + "/" + std::to_string(caseNumber++);
+    ChannelCase<MSG>(param).Run(msg, topic);
+}
+
+template<typename MSG>
+void RunLowLevel(const std::string& type, ChannelCaseParam param, const BenchmarkOption& option)
+{
+    MSG msg;
+    param.type = type;
+    param.bytes = sizeof(MSG);
+    RunCase(msg, param, option, 2000, 1000.0);
+}
+
+void RunPointCloud(double megabyte, ChannelCaseParam param, const BenchmarkOption& option)
+{
+    const uint32_t pointStep = 16;
+    const uint32_t width = (uint32_t)(megabyte * 1024 * 1024 / pointStep);
+
+    sensor_msgs::msg::dds_::PointCloud2_ msg;
+    msg.height(1);
+    msg.width(width);
+    msg.point_step(pointStep);
+    msg.row_step(pointStep * width);
+    msg.data().resize((size_t)pointStep * width);
+
+    param.type = "PointCloud2_";
+    param.bytes = msg.data().size();
+    RunCase(msg, param, option, 50, 10.0);
+}
+
+void RunHeightMap(uint32_t size, ChannelCaseParam param, const BenchmarkOption& option)
+{
+    unitree_go::msg::dds_::HeightMap_ msg;
+    msg.width(size);
+    msg.height(size);
+    msg.resolution(0.06f);
+    msg.data().resize((size_t)size * size);
+
+    param.type = "HeightMap_";
+    param.bytes = msg.data().size() * sizeof(float);
+    RunCase(msg, param, option, 200, 50.0);
+}
+
+int main(int argc, const char** argv)
+{
+    BenchmarkOption option(argc, argv);
+
+    ChannelCaseParam param;
+    param.transport = option.Get("transport", "dds");
+
+    if (param.transport == "loopback")
+    {
+        ChannelFactory::Instance()->InitLoopback();
+    }
+    else if (option.Has("config"))
+    {
+        ChannelFactory::Instance()->Init(option.Get("config", ""));
+    }
+    else
+    {
+        ChannelFactory::Instance()->Init(0, option.Get("interface", "lo"));
+    }
+
+    const std::vector<std::string> type = option.GetList("type",
+        "go2_lowcmd,go2_lowstate,hg_lowcmd,hg_lowstate,pointcloud2,heightmap");
+
+    for (const std::string& queuelen : option.GetList("queuelen", "0,8"))
+    {
+        param.queuelen = atoll(queuelen.c_str());
+
+        for (const std::string& t : type)
+        {
+            if (t == "go2_lowcmd")
+            {
+                RunLowLevel<unitree_go::msg::dds_::LowCmd_>("go2_LowCmd_", param, option);
+            }
+            else if (t == "go2_lowstate")
+            {
+                RunLowLevel<unitree_go::msg::dds_::LowState_>("go2_LowState_", param, option);
+            }
+            else if (t == "hg_lowcmd")
+            {
+                RunLowLevel<unitree_hg::msg::dds_::LowCmd_>("hg_LowCmd_", param, option);
+            }
+            else if (t == "hg_lowstate")
+            {
+                RunLowLevel<unitree_hg::msg::dds_::LowState_>("hg_LowState_", param, option);
+            }
+            else if (t == "pointcloud2")
+            {
+                for (const std::string& mb : option.GetList("cloud-mb", "1,10"))
+                {
+                    RunPointCloud(atof(mb.c_str()), param, option);
+                }
+            }
+            else if (t == "heightmap")
+            {
+                RunHeightMap((uint32_t)option.Get("map-size", 128.0), param, option);
+            }
+            else
+            {
+                std::cerr << "unknown type: " << t << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
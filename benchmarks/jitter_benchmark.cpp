@@ -0,0 +1,384 @@
+#include <unitree/common/thread/recurrent_thread.hpp>
+#include <unitree/common/time/deadline_timer.hpp>
+#include <unitree/common/time/sleep.hpp>
+#include <unitree/idl/go2/LowState_.hpp>
+#include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+
+#include <atomic>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#include "benchmark_common.hpp"
+
+using namespace unitree;
+using namespace unitree::robot;
+using namespace unitree::benchmark;
+
+/*
+ * Wake-up jitter of periodic control loops, to check a robot image's kernel
+ * and sdk configuration before a controller goes on it. Every case runs one
+ * loop at one rate for a fixed time with
+ *
+ *   deadline:  common::DeadlineTimer, lateness against absolute deadlines
+ *   recurrent: common::RecurrentThread, lateness against the first wakeup
+ *              plus whole periods, signed: its timer keeps a fixed
+ *              schedule, a wakeup earlier than the first one's phase is
+ *              negative and counted early
+ *
+ * and burns --load-us of cpu per tick. A tick is missed when its load ends
+ * after the next tick's nominal time. Optional: pinning to --cpu, SCHED_FIFO
+ * at --fifo priority, mlockall, busy threads competing for the cpus and a
+ * LowState_ publisher/subscriber pair at --dds-rate on the interface.
+ * Results are JSON Lines on stdout, the histogram counts lateness in
+ * --bucket-us buckets, the first one also collects early wakeups, the last
+ * one everything from one period up.
+ *
+ *     jitter_benchmark [--timer deadline,recurrent] [--rate 500,1000,2000]
+ *                      [--duration s] [--load-us 100] [--cpu N] [--fifo 80]
+ *                      [--mlock] [--stress-threads N] [--dds-rate Hz]
+ *                      [--interface lo] [--bucket-us 10]
+ *
+ * SCHED_FIFO and mlockall need root or CAP_SYS_NICE / CAP_IPC_LOCK; the
+ * record says whether they took effect.
+ */
+
+/*
+ * LowState_ at a fixed rate over dds, published and received in this
+ * process, the traffic a controller shares its cpus with.
+ */
+class DdsTraffic
+{
+public:
+    DdsTraffic() :
+        mReceived(0)
+    {}
+
+    void Start(double rate)
+    {
+        const std::string topic = "bench/jitter/lowstate";
+
+        mPublisherPtr.reset(new ChannelPublisher<unitree_go::msg::dds_::LowState_>(topic));
+        mPublisherPtr->InitChannel();
+
+        mSubscriberPtr.reset(new ChannelSubscriber<unitree_go::msg::dds_::LowState_>(topic));
+        mSubscriberPtr->InitChannel(std::bind(&DdsTraffic::Handler, this, std::placeholders::_1), 1);
+
+        mThreadPtr = common::CreateRecurrentThreadEx("jitterdds", UT_CPU_ID_NONE, (uint64_t)(1e6 / rate), &DdsTraffic::Write, this);
+    }
+
+    /*
+     * @brief the writer stops before the channels close, all of it before
+     * the channel factory is released.
+     */
+    void Stop()
+    {
+        if (!mThreadPtr)
+        {
+            return;
+        }
+
+        mThreadPtr->Wait();
+
+        mSubscriberPtr->CloseChannel();
+        mPublisherPtr->CloseChannel();
+
+        mSubscriberPtr.reset();
+        mPublisherPtr.reset();
+        mThreadPtr.reset();
+    }
+
+    uint64_t GetReceived() const
+    {
+        return mReceived;
+    }
+
+private:
+    void Write()
+    {
+        mPublisherPtr->Write(mState);
+    }
+
+    void Handler(const void*)
+    {
+        mReceived++;
+    }
+
+private:
+    unitree_go::msg::dds_::LowState_ mState;
+    ChannelPublisherPtr<unitree_go::msg::dds_::LowState_> mPublisherPtr;
+    ChannelSubscriberPtr<unitree_go::msg::dds_::LowState_> mSubscriberPtr;
+    common::ThreadPtr mThreadPtr;
+    std::atomic<uint64_t> mReceived;
+};
+
+struct JitterCaseParam
+{
+    std::string timer;
+    double rate = 0.0;
+    double duration = 0.0;
+    int64_t loadNanosec = 0;
+    int32_t cpuId = UT_CPU_ID_NONE;
+    int32_t fifo = 0;
+    uint32_t stressThreads = 0;
+    int64_t bucketNanosec = 0;
+};
+
+class JitterCase
+{
+public:
+    explicit JitterCase(const JitterCaseParam& param) :
+        mParam(param), mPeriod((int64_t)(1e9 / param.rate)), mQuit(false), mFifoApplied(false),
+        mFirstWake(0), mPrevIndex(0), mMissed(0), mOverrun(0), mEarly(0)
+    {}
+
+    /*
+     * @brief the loop thread, kept by the caller past Run.
+     */
+    common::ThreadPtr Run(BenchmarkRecord& record)
+    {
+        mLateness.reserve((size_t)(mParam.rate * mParam.duration * 1.1) + 16);
+
+        std::vector<std::thread> stress;
+        for (uint32_t i = 0; i < mParam.stressThreads; i++)
+        {
+            stress.emplace_back(&JitterCase::StressThreadFunc, this);
+        }
+
+        common::ThreadPtr threadPtr;
+        const int64_t start = common::DeadlineTimer::GetClock();
+        if (mParam.timer == "recurrent")
+        {
+            threadPtr = common::CreateRecurrentThreadEx("jitter", mParam.cpuId, (uint64_t)(mPeriod / 1000), &JitterCase::RecurrentTick, this);
+        }
+        else
+        {
+            threadPtr = common::CreateThreadEx("jitter", mParam.cpuId, &JitterCase::DeadlineThreadFunc, this);
+        }
+
+        common::MicroSleep((uint64_t)(mParam.duration * 1e6));
+        mQuit = true;
+        threadPtr->Wait();
+        const double elapsed = (common::DeadlineTimer::GetClock() - start) * 1e-9;
+
+        for (std::thread& thread : stress)
+        {
+            thread.join();
+        }
+
+        std::vector<uint64_t> histogram((size_t)((mPeriod + mParam.bucketNanosec - 1) / mParam.bucketNanosec) + 1, 0);
+        for (int64_t lateness : mLateness)
+        {
+            const size_t bucket = lateness < 0 ? 0 : (size_t)(lateness / mParam.bucketNanosec);
+            histogram[std::min(bucket, histogram.size() - 1)]++;
+        }
+
+        const uint64_t ticks = mLateness.size();
+
+        record.Add("timer", mParam.timer).Add("rate_hz", mParam.rate).Add("period_us", mPeriod * 1e-3)
+            .Add("load_us", mParam.loadNanosec * 1e-3).Add("cpu", mParam.cpuId).Add("fifo", mParam.fifo)
+            .Add("fifo_applied", (int32_t)mFifoApplied.load()).Add("stress_threads", (uint64_t)mParam.stressThreads)
+            .Add("duration_s", elapsed).Add("ticks", ticks).Add("achieved_rate_hz", elapsed > 0 ? ticks / elapsed : 0.0)
+            .Add("missed", mMissed).Add("overruns", mOverrun).Add("early", mEarly)
+            .Add("latency", LatencyStats(mLateness))
+            .Add("histogram_bucket_us", mParam.bucketNanosec * 1e-3).Add("histogram", histogram);
+
+        return threadPtr;
+    }
+
+private:
+    int32_t DeadlineThreadFunc()
+    {
+        common::DeadlineTimer timer(mPeriod);
+        timer.Start();
+
+        while (!mQuit)
+        {
+            const int64_t lateness = timer.Wait();
+            Tick(lateness, timer.GetWakeTime() - lateness);
+        }
+
+        mOverrun = timer.GetOverrunNumber();
+        return 0;
+    }
+
+    /*
+     * RecurrentThread runs on a periodic timer of its own, expirations that
+     * pass during a late tick are merged into one call. The nominal wakeup
+     * is the latest expiration before now, at least the one after the
+     * previous tick's, and every expiration skipped is an overrun.
+     */
+    void RecurrentTick()
+    {
+        const int64_t now = common::DeadlineTimer::GetClock();
+        if (mFirstWake == 0)
+        {
+            mFirstWake = now;
+            ApplyScheduler();
+            return;
+        }
+
+        const int64_t index = std::max((now - mFirstWake) / mPeriod, mPrevIndex + 1);
+        mOverrun += (uint64_t)(index - mPrevIndex - 1);
+        mPrevIndex = index;
+
+        const int64_t nominal = mFirstWake + index * mPeriod;
+        const int64_t lateness = now - nominal;
+        if (lateness < 0)
+        {
+            mEarly++;
+        }
+
+        Tick(lateness, nominal);
+    }
+
+    void Tick(int64_t lateness, int64_t nominal)
+    {
+        if (mLateness.empty() && mParam.timer != "recurrent")
+        {
+            ApplyScheduler();
+        }
+
+        if (mQuit)
+        {
+            return;
+        }
+
+        mLateness.push_back(lateness);
+
+        const int64_t end = Spin(mParam.loadNanosec);
+        if (end - nominal > mPeriod)
+        {
+            mMissed++;
+        }
+    }
+
+    /*
+     * @brief on the loop thread, its first tick.
+     */
+    void ApplyScheduler()
+    {
+        if (mParam.fifo <= 0)
+        {
+            return;
+        }
+
+        struct sched_param sp;
+        sp.sched_priority = mParam.fifo;
+        mFifoApplied = (pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp) == 0);
+    }
+
+    /*
+     * @brief busy for nanosec, returns the clock at the end.
+     */
+    static int64_t Spin(int64_t nanosec)
+    {
+        const int64_t begin = common::DeadlineTimer::GetClock();
+        int64_t now = begin;
+        while (now - begin < nanosec)
+        {
+            now = common::DeadlineTimer::GetClock();
+        }
+        return now;
+    }
+
+    void StressThreadFunc()
+    {
+        volatile uint64_t sink = 0;
+        while (!mQuit)
+        {
+            for (uint32_t i = 0; i < 10000; i++)
+            {
+                sink = sink + i;
+            }
+        }
+    }
+
+private:
+    JitterCaseParam mParam;
+    int64_t mPeriod;
+    std::atomic<bool> mQuit;
+    std::atomic<bool> mFifoApplied;
+
+    /*
+     * loop thread only until Run reads them after Wait.
+     */
+    std::vector<int64_t> mLateness;
+    int64_t mFirstWake;
+    int64_t mPrevIndex;
+    uint64_t mMissed;
+    uint64_t mOverrun;
+    uint64_t mEarly;
+};
+
+int main(int argc, const char** argv)
+{
+    BenchmarkOption option(argc, argv);
+
+    JitterCaseParam param;
+    param.duration = option.Get("duration", 5.0);
+    param.loadNanosec = (int64_t)(option.Get("load-us", 100.0) * 1000);
+    param.cpuId = (int32_t)option.Get("cpu", (double)UT_CPU_ID_NONE);
+    param.fifo = (int32_t)option.Get("fifo", 0.0);
+    param.stressThreads = (uint32_t)option.Get("stress-threads", 0.0);
+    param.bucketNanosec = std::max((int64_t)(option.Get("bucket-us", 10.0) * 1000), (int64_t)1000);
+
+    int32_t mlocked = 0;
+    if (option.Has("mlock"))
+    {
+        mlocked = (mlockall(MCL_CURRENT | MCL_FUTURE) == 0);
+    }
+
+    const double ddsRate = option.Get("dds-rate", 0.0);
+    DdsTraffic dds;
+    if (ddsRate > 0)
+    {
+        ChannelFactory::Instance()->Init(0, option.Get("interface", "lo"));
+        dds.Start(ddsRate);
+        common::MicroSleep(500000);
+    }
+
+    /*
+     * finished loop threads are kept to the end, a common::Thread destroyed
+     * right after Wait may still be leaving its native thread.
+     */
+    std::vector<common::ThreadPtr> finished;
+
+    for (const std::string& timer : option.GetList("timer", "deadline,recurrent"))
+    {
+        param.timer = timer;
+        for (const std::string& rate : option.GetList("rate", "500,1000,2000"))
+        {
+            param.rate = atof(rate.c_str());
+            if (param.rate <= 0)
+            {
+                continue;
+            }
+
+            const uint64_t received = dds.GetReceived();
+
+            BenchmarkRecord record("jitter");
+            finished.push_back(JitterCase(param).Run(record));
+
+            record.Add("mlock", mlocked).Add("dds_rate_hz", ddsRate)
+                .Add("dds_received", dds.GetReceived() - received).Print();
+        }
+    }
+
+    /*
+     * common::Thread objects still alive when the channel factory is
+     * released crash in their destructor, so the loop threads and the dds
+     * traffic go first.
+     */
+    finished.clear();
+
+    if (ddsRate > 0)
+    {
+        dds.Stop();
+        ChannelFactory::Instance()->Release();
+    }
+
+    return 0;
+}
@@ -0,0 +1,369 @@
+#include <unitree/common/time/deadline_timer.hpp>
+#include <unitree/common/time/sleep.hpp>
+#include <unitree/robot/channel/channel_factory.hpp>
+#include <unitree/robot/client/client_base.hpp>
+#include <unitree/robot/server/server_base.hpp>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <unistd.h>
+
+#include "benchmark_common.hpp"
+
+using namespace unitree;
+using namespace unitree::robot;
+using namespace unitree::benchmark;
+
+/*
+ * Request -> response round trip of the rpc layer. An echo service derived
+ * from ServerBase answers every request with its own parameter and binary;
+ * N client threads, each with its own ClientBase, call it back to back for
+ * a fixed time per case:
+ *
+ *   json:   string parameter of size bytes, echoed in data
+ *   binary: binary parameter of size bytes, echoed in binary
+ *
+ * With --proi the server is started with the priority queue and the first
+ * --priority-threads callers send priority 1, their latency is reported
+ * apart from the normal callers'. --priority-threads is ignored without
+ * --proi. Results are JSON Lines on stdout; a latency block that got no
+ * samples, e.g. normal callers starved under --proi, has null percentiles.
+ *
+ *     rpc_benchmark [--interface lo] [--role both|server|client]
+ *                   [--threads 1,2,4,8,16] [--size 16,1024,65536]
+ *                   [--kind json,binary] [--duration s] [--timeout s]
+ *                   [--proi] [--priority-threads N]
+ *
+ * --role server runs only the echo service, --role client only the callers,
+ * to put them in two processes or on two hosts. Both sides need the same
+ * --proi.
+ */
+
+const std::string BENCH_ECHO_SERVICE_NAME = "bench_echo";
+
+const int32_t BENCH_ECHO_API_ID_JSON = 1001;
+const int32_t BENCH_ECHO_API_ID_BINARY = 1002;
+
+/*
+ * one round trip per call, no handler table, no lease.
+ */
+class EchoServer : public ServerBase
+{
+public:
+    EchoServer() : ServerBase(BENCH_ECHO_SERVICE_NAME), mRequestNumber(0)
+    {}
+
+    void Init()
+    {}
+
+    uint64_t GetRequestNumber() const
+    {
+        return mRequestNumber;
+    }
+
+protected:
+    void ServerRequestHandler(const RequestPtr& request)
+    {
+        mRequestNumber++;
+
+        Response response;
+        response.header().identity(request->header().identity());
+        response.header().status().code(UT_ROBOT_OK);
+
+        if (request->header().identity().api_id() == BENCH_ECHO_API_ID_BINARY)
+        {
+            response.binary(request->binary());
+        }
+        else
+        {
+            response.data(request->parameter());
+        }
+
+        SendResponse(response);
+    }
+
+private:
+    std::atomic<uint64_t> mRequestNumber;
+};
+
+class EchoClient : public ClientBase
+{
+public:
+    EchoClient() : ClientBase(BENCH_ECHO_SERVICE_NAME)
+    {}
+
+    void Init()
+    {}
+
+    int32_t Echo(const std::string& parameter, std::string& data, int32_t priority)
+    {
+        return Call(BENCH_ECHO_API_ID_JSON, parameter, data, priority, 0);
+    }
+
+    int32_t Echo(const std::vector<uint8_t>& parameter, std::vector<uint8_t>& data, int32_t priority)
+    {
+        return Call(BENCH_ECHO_API_ID_BINARY, parameter, data, priority, 0);
+    }
+};
+
+using EchoClientPtr = std::shared_ptr<EchoClient>;
+
+struct RpcCaseParam
+{
+    std::string kind;
+    size_t size = 0;
+    uint32_t threads = 0;
+    uint32_t priorityThreads = 0;
+    bool proi = false;
+    double duration = 0.0;
+};
+
+/*
+ * per caller results, written by its thread only.
+ */
+struct RpcCaller
+{
+    std::vector<int64_t> latency;
+    uint64_t error = 0;
+    uint64_t timeout = 0;
+    uint64_t mismatch = 0;
+};
+
+class RpcCase
+{
+public:
+    RpcCase(const RpcCaseParam& param, const std::vector<EchoClientPtr>& clients) :
+        mParam(param), mClients(clients), mQuit(false)
+    {}
+
+    void Run()
+    {
+        mJson = "{\"data\":\"" + std::string(mParam.size > 12 ? mParam.size - 12 : 0, 'x') + "\"}";
+        mBinary.assign(mParam.size, 0x5A);
+        mCallers.assign(mParam.threads, RpcCaller());
+
+        /*
+         * joined, not Wait()ed: a finished common::Thread may still be
+         * leaving its native thread when it is destroyed.
+         */
+        std::vector<std::thread> threads;
+        const int64_t start = common::DeadlineTimer::GetClock();
+        for (uint32_t i = 0; i < mParam.threads; i++)
+        {
+            threads.emplace_back(&RpcCase::CallerThreadFunc, this, i);
+        }
+
+        common::MicroSleep((uint64_t)(mParam.duration * 1e6));
+        mQuit = true;
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        const double elapsed = (common::DeadlineTimer::GetClock() - start) * 1e-9;
+
+        std::vector<int64_t> normal, priority;
+        uint64_t error = 0, timeout = 0, mismatch = 0;
+        for (uint32_t i = 0; i < mParam.threads; i++)
+        {
+            const RpcCaller& caller = mCallers[i];
+            std::vector<int64_t>& latency = IsPriority(i) ? priority : normal;
+            latency.insert(latency.end(), caller.latency.begin(), caller.latency.end());
+            error += caller.error;
+            timeout += caller.timeout;
+            mismatch += caller.mismatch;
+        }
+
+        const uint64_t calls = normal.size() + priority.size();
+
+        BenchmarkRecord record("rpc");
+        record.Add("kind", mParam.kind).Add("bytes", (uint64_t)mParam.size).Add("threads", (uint64_t)mParam.threads)
+            .Add("proi", (int32_t)mParam.proi).Add("priority_threads", (uint64_t)mParam.priorityThreads)
+            .Add("duration_s", elapsed).Add("calls", calls).Add("errors", error).Add("timeouts", timeout)
+            .Add("mismatches", mismatch).Add("calls_per_s", elapsed > 0 ? calls / elapsed : 0.0)
+            .Add("latency", LatencyStats(std::move(normal)));
+
+        if (mParam.proi && mParam.priorityThreads > 0)
+        {
+            record.Add("priority_latency", LatencyStats(std::move(priority)));
+        }
+
+        record.Print();
+    }
+
+private:
+    bool IsPriority(uint32_t index) const
+    {
+        return mParam.proi && index < mParam.priorityThreads;
+    }
+
+    void CallerThreadFunc(uint32_t index)
+    {
+        EchoClient& client = *mClients[index];
+        RpcCaller& caller = mCallers[index];
+        const int32_t priority = IsPriority(index) ? 1 : 0;
+
+        std::string data;
+        std::vector<uint8_t> binary;
+
+        while (!mQuit)
+        {
+            int32_t ret = 0;
+            bool echoed = false;
+
+            const int64_t begin = common::DeadlineTimer::GetClock();
+            if (mParam.kind == "binary")
+            {
+                ret = client.Echo(mBinary, binary, priority);
+                echoed = (binary.size() == mBinary.size());
+            }
+            else
+            {
+                ret = client.Echo(mJson, data, priority);
+                echoed = (data.size() == mJson.size());
+            }
+            const int64_t end = common::DeadlineTimer::GetClock();
+
+            if (ret == UT_ROBOT_ERR_CLIENT_API_TIMEOUT)
+            {
+                caller.timeout++;
+            }
+            else if (ret != UT_ROBOT_OK)
+            {
+                caller.error++;
+            }
+            else if (!echoed)
+            {
+                caller.mismatch++;
+            }
+            else
+            {
+                caller.latency.push_back(end - begin);
+            }
+        }
+    }
+
+private:
+    RpcCaseParam mParam;
+    std::vector<EchoClientPtr> mClients;
+    std::vector<RpcCaller> mCallers;
+
+    std::string mJson;
+    std::vector<uint8_t> mBinary;
+
+    std::atomic<bool> mQuit;
+};
+
+/*
+ * @brief until every client got an answer, i.e. its reader and writer matched.
+ */
+bool WaitServer(const std::vector<EchoClientPtr>& clients)
+{
+    for (const EchoClientPtr& client : clients)
+    {
+        std::string data;
+        int32_t ret = UT_ROBOT_ERR_CLIENT_API_TIMEOUT;
+        for (int32_t i = 0; i < 50 && ret != UT_ROBOT_OK; i++)
+        {
+            ret = client->Echo("{}", data, 0);
+        }
+
+        if (ret != UT_ROBOT_OK)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, const char** argv)
+{
+    BenchmarkOption option(argc, argv);
+
+    const std::string role = option.Get("role", "both");
+    const bool proi = option.Has("proi");
+
+    ChannelFactory::Instance()->Init(0, option.Get("interface", "lo"));
+
+    std::shared_ptr<EchoServer> server;
+    if (role == "both" || role == "server")
+    {
+        server.reset(new EchoServer());
+        server->Init();
+        server->Start(proi);
+    }
+
+    if (role == "server")
+    {
+        while (true)
+        {
+            sleep(10);
+        }
+    }
+
+    RpcCaseParam param;
+    param.proi = proi;
+    param.priorityThreads = proi ? (uint32_t)option.Get("priority-threads", 1.0) : 0;
+    param.duration = option.Get("duration", 2.0);
+
+    std::vector<uint32_t> threads;
+    uint32_t maxThreads = 0;
+    for (const std::string& n : option.GetList("threads", "1,2,4,8,16"))
+    {
+        threads.push_back((uint32_t)atoi(n.c_str()));
+        maxThreads = std::max(maxThreads, threads.back());
+    }
+
+    /*
+     * one client per caller, created once: a new client has to match the
+     * service's topics before its first call returns.
+     */
+    std::vector<EchoClientPtr> clients;
+    for (uint32_t i = 0; i < maxThreads; i++)
+    {
+        EchoClientPtr client(new EchoClient());
+        client->Init();
+        client->SetTimeout((float)option.Get("timeout", 1.0));
+        clients.push_back(client);
+    }
+
+    if (!WaitServer(clients))
+    {
+        BenchmarkRecord("rpc").Add("error", "service not matched").Print();
+    }
+    else
+    {
+        for (const std::string& kind : option.GetList("kind", "json,binary"))
+        {
+            param.kind = kind;
+            for (const std::string& size : option.GetList("size", "16,1024,65536"))
+            {
+                param.size = (size_t)atoll(size.c_str());
+                for (uint32_t n : threads)
+                {
+                    param.threads = n;
+                    RpcCase(param, std::vector<EchoClientPtr>(clients.begin(), clients.begin() + n)).Run();
+                }
+            }
+        }
+    }
+
+    /*
+     * callers are joined; clients go before the service they talk to, both
+     * before the factory that owns their dds entities.
+     *
+     * every client's reader receives every response, so a reply another
+     * caller already has may still be in this client's listener. ClientStub
+     * in the sdk library does not stop its reader's listener before its
+     * members are destroyed, which then fails in Mutex::Lock or in the dds
+     * prevent_callbacks assertion; let the listeners go idle first.
+     */
+    common::MicroSleep(200000);
+    clients.clear();
+    server.reset();
+    ChannelFactory::Instance()->Release();
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <unitree/robot/b2/sport/sport_client.hpp>
+#include <unitree/robot/client/trajectory_follow_adapter.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <iostream>
+#include <math.h>
+#include <unistd.h>
+
+using namespace unitree::robot;
+
+/*
+ * Walks a sine path. The adapter samples it on its own thread at the sport
+ * service's replan rate and only calls TrajectoryFollow when the horizon
+ * changed or its keep-alive expired.
+ */
+class Custom
+{
+public:
+    explicit Custom() : adapter(sc) {}
+
+    void Path(double t, b2::PathPoint& p)
+    {
+        const float var = t - start;
+        p.x = vx * var;
+        p.y = 0.6 * sin(M_PI * vx * var);
+        p.yaw = 2 * 0.6 * vx * M_PI * cos(M_PI * vx * var);
+        p.vx = vx;
+        p.vy = M_PI * vx * (0.6 * cos(M_PI * vx * var));
+        p.vyaw = -M_PI * vx * 2 * 0.6 * vx * M_PI * sin(M_PI * vx * var);
+    }
+
+    b2::SportClient sc;
+    TrajectoryFollowAdapter<b2::SportClient, b2::PathPoint> adapter;
+
+    double start = 0.0;
+    float vx = 0.3;
+};
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: " << argv[0] << " networkInterface" << std::endl;
+        exit(-1);
+    }
+
+    ChannelFactory::Instance()->Init(0, argv[1]);
+
+    Custom custom;
+    custom.sc.SetTimeout(10.0f);
+    custom.sc.Init();
+
+    custom.start = unitree::common::GetCurrentMonotonicTimeNanosecond() * 1e-9;
+    custom.adapter.SetPathFunction(std::bind(&Custom::Path, &custom, std::placeholders::_1, std::placeholders::_2));
+    custom.adapter.Start();
+
+    while (true)
+    {
+        sleep(10);
+        std::cout << "sent: " << custom.adapter.GetSendNumber()
+                  << ", unchanged: " << custom.adapter.GetSkipNumber()
+                  << ", last code: " << custom.adapter.GetLastCode() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <fstream>
+#include <iostream>
+#include <unitree/common/time/time_tool.hpp>
+#include <unitree/robot/g1/audio/g1_audio_stream.hpp>
+
+#include "wav.hpp"
+
+#define AUDIO_FILE_PATH "../example/g1/audio/test.wav"
+#define PACKET_MS 20
+
+int main(int argc, char const *argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: g1_audio_stream_example [NetWorkInterface(eth0)] "
+                 "[WavFile]"
+              << std::endl;
+    exit(0);
+  }
+
+  unitree::robot::ChannelFactory::Instance()->Init(0, argv[1]);
+  unitree::robot::g1::AudioClient client;
+  client.Init();
+  client.SetTimeout(10.0f);
+
+  int32_t sample_rate = -1;
+  int8_t num_channels = 0;
+  bool filestate = false;
+  std::vector<uint8_t> pcm = ReadWave(argc > 2 ? argv[2] : AUDIO_FILE_PATH,
+                                      &sample_rate, &num_channels, &filestate);
+  if (!filestate || sample_rate <= 0 || num_channels <= 0) {
+    std::cout << "audio file format error, please check!" << std::endl;
+    return -1;
+  }
+
+  /*
+   * any wav format is resampled to 16 kHz mono and played in 100 ms packets
+   */
+  unitree::robot::g1::AudioStreamParam param;
+  param.input.sample_rate = sample_rate;
+  param.input.channels = num_channels;
+
+  std::string stream_id =
+      std::to_string(unitree::common::GetCurrentTimeMillisecond());
+  unitree::robot::g1::AudioStreamPlayer player(
+      unitree::robot::g1::MakeAudioClientSink(client, "example", stream_id),
+      param);
+  player.Start();
+
+  /*
+   * simulate a jittery producer: packets arrive late in bursts
+   */
+  const size_t packet_size =
+      param.input.MillisecondToFrames(PACKET_MS) * num_channels * 2;
+  uint64_t stamp = 0;
+  for (size_t offset = 0; offset < pcm.size(); offset += packet_size) {
+    size_t size = std::min(packet_size, pcm.size() - offset);
+    player.Push(stamp++, pcm.data() + offset, size);
+    usleep((stamp % 5 == 0) ? PACKET_MS * 3000 : PACKET_MS * 500);
+  }
+
+  player.SetEndOfStream();
+  while (player.GetJitterBuffer().GetBufferedSamples() > 0) {
+    usleep(100000);
+  }
+  usleep(param.lead_ms * 1000);
+
+  std::cout << "sent: " << player.GetSentCount()
+            << ", sink error: " << player.GetSinkErrorCount()
+            << ", late: " << player.GetJitterBuffer().GetLateCount()
+            << ", underrun: " << player.GetJitterBuffer().GetUnderrunCount()
+            << std::endl;
+
+  client.PlayStop("example");
+  return 0;
+}
@@ -0,0 +1,96 @@
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <unitree/idl/hg/LowCmd_.hpp>
+#include <unitree/idl/hg/LowState_.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/robot/motion/arm_sdk_streamer.hpp>
+
+static const std::string kTopicState = "rt/lowstate";
+constexpr float kPi_2 = 1.57079632;
+
+using unitree::robot::motion::ArmSdkStreamer;
+using unitree::robot::motion::ArmSdkStreamerParam;
+using unitree::robot::motion::Trajectory;
+
+// left arm 15..21, right arm 22..28, waist 12..14
+static const std::vector<int32_t> kArmJoints = {15, 16, 17, 18, 19, 20, 21,
+                                                22, 23, 24, 25, 26, 27, 28,
+                                                12, 13, 14};
+
+std::shared_ptr<Trajectory> MakeWave(const std::array<float, 17> &from) {
+  std::shared_ptr<Trajectory> trajectory(
+      new Trajectory(kArmJoints.size(), unitree::robot::motion::TRAJECTORY_QUINTIC));
+
+  std::array<float, 17> up = {0.f, kPi_2,  0.f, kPi_2, 0.f, 0.f, 0.f,
+                              0.f, -kPi_2, 0.f, kPi_2, 0.f, 0.f, 0.f,
+                              0.f, 0.f,    0.f};
+  std::array<float, 17> wave = up;
+  wave[3] = wave[10] = kPi_2 * 0.4f;
+
+  trajectory->AddKnot(0.0, from.data());
+  trajectory->AddKnot(2.0, up.data());
+  trajectory->AddKnot(2.8, wave.data());
+  trajectory->AddKnot(3.6, up.data());
+  trajectory->AddKnot(4.4, wave.data());
+  trajectory->AddKnot(5.2, up.data());
+  trajectory->AddKnot(7.5, from.data());
+  trajectory->Finalize();
+  return trajectory;
+}
+
+int main(int argc, char const *argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: " << argv[0] << " networkInterface" << std::endl;
+    exit(-1);
+  }
+
+  unitree::robot::ChannelFactory::Instance()->Init(0, argv[1]);
+
+  unitree_hg::msg::dds_::LowState_ state_msg;
+  unitree::robot::ChannelSubscriber<unitree_hg::msg::dds_::LowState_>
+      low_state_subscriber(kTopicState);
+  low_state_subscriber.InitChannel([&](const void *msg) {
+    memcpy(&state_msg, msg, sizeof(unitree_hg::msg::dds_::LowState_));
+  }, 1);
+
+  ArmSdkStreamerParam param;
+  param.jointMap = kArmJoints;
+  param.weightIndex = unitree::robot::motion::UT_ARM_SDK_G1_WEIGHT_INDEX;
+  param.frequency = 500.0;
+  ArmSdkStreamer<unitree_hg::msg::dds_::LowCmd_> streamer(param);
+
+  std::cout << "Press ENTER to start arm ctrl ...";
+  std::cin.get();
+
+  // hold the measured pose while the weight ramps up
+  std::array<float, 17> current_jpos{};
+  for (size_t i = 0; i < kArmJoints.size(); ++i) {
+    current_jpos.at(i) = state_msg.motor_state().at(kArmJoints.at(i)).q();
+  }
+  streamer.SetPose(current_jpos.data());
+  streamer.Start();
+  streamer.SetWeight(1.0f);
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+
+  streamer.Play(MakeWave(current_jpos), 0.0);
+  while (!streamer.IsFinished()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  std::cout << "Stopping arm ctrl ..." << std::endl;
+  streamer.SetWeight(0.0f);
+  while (streamer.GetWeight() > 0.0f) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  streamer.Stop();
+
+  std::cout << "ticks: " << streamer.GetTickNumber()
+            << ", overruns: " << streamer.GetOverrunNumber()
+            << ", max lateness: " << streamer.GetMaxLateness() / 1000 << " us"
+            << std::endl;
+
+  return 0;
+}
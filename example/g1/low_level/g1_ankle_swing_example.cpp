@@ -14,6 +14,7 @@
 #include <unitree/idl/hg/LowCmd_.hpp>
 #include <unitree/idl/hg/LowState_.hpp>
 #include <unitree/robot/b2/motion_switcher/motion_switcher_client.hpp>
+#include <unitree/robot/model/g1_model.hpp>
 
 static const std::string HG_CMD_TOPIC = "rt/lowcmd";
 static const std::string HG_IMU_TORSO = "rt/secondary_imu";
@@ -46,7 +47,7 @@ class DataBuffer {
   std::shared_mutex mutex;
 };
 
-const int G1_NUM_MOTOR = 29;
+const int G1_NUM_MOTOR = unitree::robot::model::G1Dof29::JOINT_NUMBER;
 struct ImuState {
   std::array<float, 3> rpy = {};
   std::array<float, 3> omega = {};
@@ -63,23 +64,9 @@ struct MotorState {
   std::array<float, G1_NUM_MOTOR> dq = {};
 };
 
-// Stiffness for all G1 Joints
-std::array<float, G1_NUM_MOTOR> Kp{
-    60, 60, 60, 100, 40, 40,      // legs
-    60, 60, 60, 100, 40, 40,      // legs
-    60, 40, 40,                   // waist
-    40, 40, 40, 40,  40, 40, 40,  // arms
-    40, 40, 40, 40,  40, 40, 40   // arms
-};
-
-// Damping for all G1 Joints
-std::array<float, G1_NUM_MOTOR> Kd{
-    1, 1, 1, 2, 1, 1,     // legs
-    1, 1, 1, 2, 1, 1,     // legs
-    1, 1, 1,              // waist
-    1, 1, 1, 1, 1, 1, 1,  // arms
-    1, 1, 1, 1, 1, 1, 1   // arms
-};
+// Default stiffness and damping for all G1 Joints
+const std::array<float, G1_NUM_MOTOR> Kp = unitree::robot::model::G1Dof29::KP;
+const std::array<float, G1_NUM_MOTOR> Kd = unitree::robot::model::G1Dof29::KD;
 
 enum class Mode {
   PR = 0,  // Series Control for Ptich/Roll Joints
@@ -1,5 +1,3 @@
-#include <yaml-cpp/yaml.h>
-
 #include <cmath>
 #include <memory>
 #include <mutex>
@@ -13,6 +11,8 @@
 #include <unitree/idl/hg/LowCmd_.hpp>
 #include <unitree/idl/hg/LowState_.hpp>
 
+#include <unitree/robot/motion/motion_clip.hpp>
+
 #include <unitree/robot/b2/motion_switcher/motion_switcher_client.hpp>
 using namespace unitree::robot::b2;
 
@@ -154,7 +154,8 @@ class G1Example {
   double duration_;    // [3 s]
   PRorAB mode_;
   uint8_t mode_machine_;
-  std::vector<std::vector<double>> frames_data_;
+  unitree::robot::motion::MotionClip clip_;
+  std::vector<float> clip_frame_;
 
   DataBuffer<MotorState> motor_state_buffer_;
   DataBuffer<MotorCommand> motor_command_buffer_;
@@ -215,26 +216,15 @@ class G1Example {
   }
 
   void loadBehaviorLibrary(std::string behavior_name) {
+    // motion.clip is converted from behavior_lib/motion.seq at build time
     std::string resource_dir = BLIB_DIR;
-    YAML::Node motion = YAML::LoadFile(resource_dir + behavior_name + ".seq");
-
-    std::string content = motion["components"][1]["content"].as<std::string>();
-    int num_parts = motion["components"][1]["num_parts"].as<int>();
-    std::cout << "BehaviorName: " << behavior_name + ".seq\n";
-    std::cout << content << " with " << num_parts << "\n";
+    clip_.Open(resource_dir + behavior_name + ".clip");
+    clip_.Prefetch();
+    clip_frame_.resize(clip_.GetFrameStride());
 
-    auto frames = motion["components"][1]["frames"];
-
-    for (const auto &frame : frames) {
-      std::vector<double> frame_data;
-      for (const auto &element : frame) {
-        frame_data.push_back(element.as<double>());
-      }
-      frames_data_.push_back(frame_data);
-    }
-
-    std::cout << frames_data_.size() << " knots with " << frames_data_[0].size()
-              << " DOF\n";
+    std::cout << "BehaviorName: " << behavior_name + ".clip\n";
+    std::cout << clip_.GetFrameNumber() << " knots with " << clip_.GetDof()
+              << " DOF at " << clip_.GetFrameRate() << " Hz\n";
   }
 
   void ReportRPY() {
@@ -325,21 +315,21 @@ class G1Example {
         }
       } else {
         // [Stage 2]: tracking the offline trajectory
-        size_t frame_index = (size_t)((time_ - duration_) / control_dt_);
-        if (frame_index >= frames_data_.size()) {
-          frame_index = frames_data_.size() - 1;
+        double clip_time = time_ - duration_;
+        if (clip_time > clip_.GetDuration()) {
+          clip_time = clip_.GetDuration();
           time_ = 0.0;  // RESET
         }
 
+        size_t frame_index = (size_t)(clip_time * clip_.GetFrameRate());
         if (frame_index % 100 == 0)
           std::cout << "Frame Index: " << frame_index << std::endl;
 
+        motor_command_tmp.q_target.fill(0.0);
+        clip_.SampleJoints(clip_time, motor_command_tmp.q_target.data(),
+                           G1_NUM_MOTOR, clip_frame_.data());
+
         for (int i = 0; i < G1_NUM_MOTOR; ++i) {
-          size_t index_in_frame = i - LeftShoulderPitch;
-          motor_command_tmp.q_target.at(i) =
-              (i >= LeftShoulderPitch)
-                  ? frames_data_[frame_index][index_in_frame]
-                  : 0.0;
           motor_command_tmp.dq_target.at(i) = 0.0;
           motor_command_tmp.tau_ff.at(i) = 0.0;
           motor_command_tmp.kp.at(i) = GetMotorKp(G1MotorType[i]);
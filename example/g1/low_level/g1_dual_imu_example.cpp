@@ -0,0 +1,42 @@
+#include <unitree/robot/estimator/dual_imu_fusion.hpp>
+
+#include <iostream>
+#include <unistd.h>
+
+using namespace unitree::robot;
+
+// prints the pelvis orientation fused from LowState_ and the torso imu
+int main(int argc, char const *argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: g1_dual_imu_example network_interface" << std::endl;
+    exit(0);
+  }
+
+  ChannelFactory::Instance()->Init(0, argv[1]);
+
+  // torso imu as IMUState_ on rt/secondary_imu, paired by arrival time
+  estimator::DualImuFusion<> fusion;
+  fusion.InitChannel();
+
+  while (true) {
+    usleep(100000);
+    if (!fusion.Update()) {
+      std::cout << "waiting for rt/lowstate" << std::endl;
+      continue;
+    }
+
+    const estimator::DualImuEstimate &estimate = fusion.GetEstimate();
+    const Eigen::Vector3d rpy = estimate.quaternion.toRotationMatrix().eulerAngles(2, 1, 0).reverse();
+    std::cout << "tick: " << estimate.tick
+              << " rpy: " << rpy.transpose()
+              << " gyro: " << estimate.gyroscope.transpose()
+              << " source: " << estimate.source
+              << " gap: " << estimate.timeGap * 1e-6 << " ms"
+              << " angle: " << estimate.angle
+              << " pair/unpaired/reject: " << fusion.GetPairNumber() << "/"
+              << fusion.GetUnpairedNumber() << "/" << fusion.GetRejectNumber()
+              << std::endl;
+  }
+
+  return 0;
+}
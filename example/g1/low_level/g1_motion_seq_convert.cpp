@@ -0,0 +1,59 @@
+#include <yaml-cpp/yaml.h>
+
+#include <iostream>
+#include <unitree/robot/motion/motion_clip.hpp>
+
+/*
+ * Convert the JointDisplacement component of a behavior library .seq (YAML)
+ * into a binary motion clip. Column j drives motor first_joint + j; the G1
+ * arm sequences start at LeftShoulderPitch (15).
+ */
+int main(int argc, char const *argv[]) {
+  if (argc < 3) {
+    std::cout << "Usage: g1_motion_seq_convert input.seq output.clip "
+                 "[first_joint(15)]"
+              << std::endl;
+    exit(0);
+  }
+
+  int32_t first_joint = argc > 3 ? std::stoi(argv[3]) : 15;
+
+  YAML::Node motion = YAML::LoadFile(argv[1]);
+  YAML::Node components = motion["components"];
+  YAML::Node component;
+  for (size_t i = 0; i < components.size(); ++i) {
+    if (components[i]["content"].as<std::string>() == "JointDisplacement") {
+      component = components[i];
+      break;
+    }
+  }
+
+  if (!component) {
+    std::cout << "no JointDisplacement component in " << argv[1] << std::endl;
+    return -1;
+  }
+
+  float frame_rate = component["frame_rate"].as<float>();
+  std::vector<std::vector<double>> frames;
+  for (const auto &frame : component["frames"]) {
+    frames.push_back(frame.as<std::vector<double>>());
+  }
+
+  if (frames.empty()) {
+    std::cout << "empty sequence " << argv[1] << std::endl;
+    return -1;
+  }
+
+  std::vector<int32_t> joint_map(frames[0].size());
+  for (size_t j = 0; j < joint_map.size(); ++j) {
+    joint_map[j] = first_joint + (int32_t)j;
+  }
+
+  unitree::robot::motion::SaveMotionClip(argv[2], frame_rate, joint_map,
+                                         frames);
+
+  std::cout << "converted " << frames.size() << " frames with "
+            << joint_map.size() << " DOF at " << frame_rate << " Hz to "
+            << argv[2] << std::endl;
+  return 0;
+}
@@ -1,4 +1,5 @@
 #include <unitree/robot/g1/common/terminations.hpp>
+#include <unitree/robot/g1/common/safety_monitor.hpp>
 #include <boost/program_options.hpp>
 #include <thread>
 
@@ -28,10 +29,23 @@ int main(int argc, char** argv)
         lowstate = *(const LowState_*)message;
     });
 
+    // all per-motor checks in one pass, bit per condition
+    g1::SafetyMonitor monitor;
+    uint32_t reported = 0;
+
     std::cout << "Checking terminations..." << std::endl;
 
     while (true)
     {
+        int64_t now = unitree::common::GetCurrentMonotonicTimeNanosecond();
+        monitor.Check(lowstate, now);
+        monitor.CheckConnection(lowstate_subscriber->GetLastDataAvailableTime(), now);
+        for (uint32_t fresh = monitor.GetLatched() & ~reported; fresh; fresh &= fresh - 1) {
+            auto check = static_cast<g1::SafetyCheck>(fresh & -fresh);
+            std::cout << "Safety monitor tripped: " << g1::SafetyMonitor::GetCheckName(check) << std::endl;
+        }
+        reported = monitor.GetLatched();
+
         if (g1::bad_orientation(lowstate, 1.0f)) { // Tip the robot over to test bad orientation
             std::cout << "Bad orientation detected!" << std::endl;
         }
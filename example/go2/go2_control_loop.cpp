@@ -0,0 +1,99 @@
+#include <unitree/robot/control/control_loop.hpp>
+#include <unitree/robot/model/quadruped_model.hpp>
+
+#include <cmath>
+#include <iostream>
+
+using namespace unitree::robot;
+
+/*
+ * Interpolates from the measured pose to the model's stand pose, then holds
+ * it. Works for any quadruped descriptor (model::Go2, model::B2).
+ */
+template<typename Model>
+class StandPolicy
+{
+public:
+    using LowState = typename Model::LowState;
+    using LowCmd = typename Model::LowCmd;
+
+    void Start(const LowState& state, LowCmd& cmd)
+    {
+        model::GetJointPosition<Model>(state, start_pos);
+        model::SetDefaultGain<Model>(cmd);
+    }
+
+    void Step(const LowState&, LowCmd& cmd, double time)
+    {
+        float phase = std::min(1.0, time / duration);
+        model::ForEachJoint<Model>([&](auto j)
+        {
+            auto& motor = cmd.motor_cmd()[Model::MOTOR_INDEX[j]];
+            motor.q((1 - phase) * start_pos[j] + phase * Model::DEFAULT_Q[j]);
+            motor.dq(0);
+            motor.tau(0);
+        });
+    }
+
+    double duration = 2.0;
+    std::array<float, Model::JOINT_NUMBER> start_pos = {};
+};
+
+using Go2StandPolicy = StandPolicy<model::Go2>;
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: " << argv[0] << " networkInterface" << std::endl;
+        exit(-1);
+    }
+
+    std::cout << "WARNING: Make sure the robot is hung up or lying on the ground, with sport mode released." << std::endl
+              << "Press Enter to continue..." << std::endl;
+    std::cin.ignore();
+
+    ChannelFactory::Instance()->Init(0, argv[1]);
+
+    Go2StandPolicy policy;
+    ControlLoop<Go2StandPolicy> loop(policy);
+
+    // body upside down
+    loop.AddTermination("bad orientation", [](const Go2StandPolicy::LowState& state, const Go2StandPolicy::LowCmd&)
+    {
+        const auto& q = state.imu_state().quaternion();
+        return 1 - 2 * (q[1] * q[1] + q[2] * q[2]) < 0;
+    });
+    loop.AddTermination("joint velocity", [](const Go2StandPolicy::LowState& state, const Go2StandPolicy::LowCmd&)
+    {
+        for (size_t i = 0; i < model::Go2::JOINT_NUMBER; i++)
+        {
+            if (std::fabs(state.motor_state()[model::Go2::MOTOR_INDEX[i]].dq()) > 20.0f)
+            {
+                return true;
+            }
+        }
+        return false;
+    });
+
+    loop.InitChannel();
+    loop.Start();
+
+    while (true)
+    {
+        sleep(1);
+        ControlLoopStats stats = loop.GetStats();
+        std::cout << "ticks: " << stats.tickNumber
+                  << ", lateness mean/max: " << stats.meanLateness / 1000 << "/" << stats.maxLateness / 1000 << " us"
+                  << ", compute mean/max: " << stats.meanCompute / 1000 << "/" << stats.maxCompute / 1000 << " us"
+                  << ", overruns: " << stats.overrunNumber
+                  << ", stale: " << stats.staleNumber << std::endl;
+
+        if (loop.IsStopped())
+        {
+            std::cout << "stopped: " << loop.GetTrippedName() << std::endl;
+        }
+    }
+
+    return 0;
+}
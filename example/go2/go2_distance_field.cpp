@@ -0,0 +1,96 @@
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/robot/nav/distance_field.hpp>
+#include <unitree/common/lock/lock.hpp>
+
+using namespace unitree::common;
+using namespace unitree::robot;
+using namespace unitree::robot::nav;
+
+class Custom
+{
+public:
+    explicit Custom(const DistanceFieldParam& param) : field(param)
+    {}
+
+    void Init(const std::string& topic)
+    {
+        grid_subscriber.reset(new ChannelSubscriber<nav_msgs::msg::dds_::OccupancyGrid_>(topic));
+        grid_subscriber->InitChannel(std::bind(&Custom::GridMessageHandler, this, std::placeholders::_1), 1);
+    }
+
+    void Print()
+    {
+        LockGuard<Mutex> guard(mutex);
+
+        if (field.GetWidth() == 0)
+        {
+            std::cout << "grids: " << received << ", rejected: " << rejected << ", no grid yet" << std::endl;
+            return;
+        }
+
+        /*
+         * free cells closer than 0.3m to an obstacle, and obstacle cells
+         */
+        size_t near = 0, occupied = 0;
+        for (float d : field.GetField())
+        {
+            near += d >= 0.0f && d < 0.3f;
+            occupied += d < 0.0f;
+        }
+
+        uint32_t x0, y0, x1, y1;
+        field.GetUpdatedWindow(x0, y0, x1, y1);
+
+        std::cout << "grids: " << received << ", rejected: " << rejected
+                  << ", grid: " << field.GetWidth() << "x" << field.GetHeight() << " @ " << field.GetResolution()
+                  << ", occupied: " << occupied << ", within 0.3m: " << near
+                  << ", center distance: " << field.GetDistance(field.GetWidth() / 2, field.GetHeight() / 2)
+                  << ", last update: [" << x0 << ", " << x1 << ") x [" << y0 << ", " << y1 << ")" << std::endl;
+    }
+
+private:
+    void GridMessageHandler(const void* message)
+    {
+        const auto& grid = *(const nav_msgs::msg::dds_::OccupancyGrid_*)message;
+
+        LockGuard<Mutex> guard(mutex);
+        received++;
+        if (!field.Update(grid))
+        {
+            rejected++;
+        }
+    }
+
+private:
+    Mutex mutex;
+    DistanceField field;
+    uint64_t received = 0;
+    uint64_t rejected = 0;
+    ChannelSubscriberPtr<nav_msgs::msg::dds_::OccupancyGrid_> grid_subscriber;
+};
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: " << argv[0] << " networkInterface [Topic(rt/map)] [MaxDistance(2.0)]" << std::endl;
+        exit(-1);
+    }
+
+    DistanceFieldParam param;
+    param.maxDistance = argc > 3 ? std::stof(argv[3]) : 2.0f;
+    param.threadNumber = 2;
+
+    ChannelFactory::Instance()->Init(0, argv[1]);
+
+    Custom custom(param);
+    custom.Init(argc > 2 ? argv[2] : "rt/map");
+
+    while (true)
+    {
+        sleep(1);
+        custom.Print();
+    }
+
+    return 0;
+}
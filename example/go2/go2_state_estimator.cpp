@@ -0,0 +1,73 @@
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/robot/go2/estimator/state_estimator.hpp>
+#include <unitree/common/lock/lock.hpp>
+
+#define TOPIC_LOWSTATE "rt/lowstate"
+
+using namespace unitree::common;
+using namespace unitree::robot;
+using namespace unitree::robot::go2;
+
+class Custom
+{
+public:
+    void Init()
+    {
+        lowstate_subscriber.reset(new ChannelSubscriber<unitree_go::msg::dds_::LowState_>(TOPIC_LOWSTATE));
+        lowstate_subscriber->InitChannel(std::bind(&Custom::LowStateMessageHandler, this, std::placeholders::_1), 1);
+    }
+
+    void Print()
+    {
+        LockGuard<Mutex> guard(mutex);
+
+        const Eigen::Vector3d& p = estimator.GetPosition();
+        const Eigen::Vector3d v = estimator.GetBodyVelocity();
+        std::cout << "position: " << p.x() << " " << p.y() << " " << p.z()
+                  << ", body velocity: " << v.x() << " " << v.y() << " " << v.z()
+                  << ", contact: " << estimator.GetContactNumber() << std::endl;
+    }
+
+private:
+    void LowStateMessageHandler(const void* message)
+    {
+        const auto& state = *(const unitree_go::msg::dds_::LowState_*)message;
+
+        /*
+         * tick is in milliseconds
+         */
+        double dt = last_tick == 0 ? 0.002 : (state.tick() - last_tick) * 0.001;
+        last_tick = state.tick();
+
+        LockGuard<Mutex> guard(mutex);
+        estimator.Update(state, dt);
+    }
+
+private:
+    Mutex mutex;
+    StateEstimator estimator;
+    uint32_t last_tick = 0;
+    ChannelSubscriberPtr<unitree_go::msg::dds_::LowState_> lowstate_subscriber;
+};
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: " << argv[0] << " networkInterface" << std::endl;
+        exit(-1);
+    }
+
+    ChannelFactory::Instance()->Init(0, argv[1]);
+
+    Custom custom;
+    custom.Init();
+
+    while (true)
+    {
+        sleep(1);
+        custom.Print();
+    }
+
+    return 0;
+}
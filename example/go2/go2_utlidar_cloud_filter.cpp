@@ -0,0 +1,45 @@
+#include <unitree/robot/go2/utlidar/cloud_filter.hpp>
+#include <unitree/common/time/time_tool.hpp>
+
+using namespace unitree::common;
+using namespace unitree::robot;
+using namespace unitree::robot::go2;
+
+int main(int32_t argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: go2_utlidar_cloud_filter [NetWorkInterface(eth0)] [VoxelSize(0.05)] [ThreadNumber(2)]" << std::endl;
+        exit(0);
+    }
+
+    std::string networkInterface = argv[1];
+
+    CloudFilterParam param;
+    param.voxelSize = argc > 2 ? std::stof(argv[2]) : 0.05f;
+    param.threadNumber = argc > 3 ? std::stoi(argv[3]) : 2;
+
+    /*
+     * keep 0.3m..8m around the robot, drop points below the feet
+     */
+    param.minRange = 0.3f;
+    param.maxRange = 8.0f;
+    param.groundHeight = -0.35f;
+    param.maxZ = 2.0f;
+
+    ChannelFactory::Instance()->Init(0, networkInterface);
+
+    CloudFilterStage stage(param);
+    stage.Start();
+
+    std::cout << "Republish filtered cloud on " << ROBOT_UTLIDAR_CLOUD_FILTERED_TOPIC << std::endl;
+
+    while (true)
+    {
+        sleep(1);
+        std::cout << "input clouds: " << stage.GetInputCount()
+                  << ", output clouds: " << stage.GetOutputCount() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/robot/go2/utlidar/height_map.hpp>
+#include <unitree/common/lock/lock.hpp>
+
+using namespace unitree::common;
+using namespace unitree::robot;
+using namespace unitree::robot::go2;
+
+class Custom
+{
+public:
+    explicit Custom(const HeightMapParam& param) : processor(param)
+    {}
+
+    void Init()
+    {
+        height_map_subscriber.reset(new ChannelSubscriber<unitree_go::msg::dds_::HeightMap_>(ROBOT_UTLIDAR_HEIGHT_MAP_TOPIC));
+        height_map_subscriber->InitChannel(std::bind(&Custom::HeightMapMessageHandler, this, std::placeholders::_1), 1);
+    }
+
+    void Print()
+    {
+        LockGuard<Mutex> guard(mutex);
+
+        const HeightMapLayer& cost = processor.GetCost();
+        if (cost.data.empty())
+        {
+            std::cout << "maps: " << received << ", rejected: " << rejected << ", no map yet" << std::endl;
+            return;
+        }
+
+        /*
+         * cells by cost: free below 0.5, blocked at 1 (unknown included)
+         */
+        size_t free = 0, blocked = 0;
+        for (float c : cost.data)
+        {
+            free += c < 0.5f;
+            blocked += c >= 1.0f;
+        }
+
+        const HeightMapLayer& top = processor.GetLevel(processor.GetLevelNumber() - 1);
+        std::cout << "maps: " << received << ", rejected: " << rejected
+                  << ", grid: " << cost.width << "x" << cost.height << " @ " << cost.resolution
+                  << ", free: " << free << ", blocked: " << blocked << ", other: " << cost.data.size() - free - blocked
+                  << ", coarsest level: " << top.width << "x" << top.height << std::endl;
+    }
+
+private:
+    void HeightMapMessageHandler(const void* message)
+    {
+        const auto& msg = *(const unitree_go::msg::dds_::HeightMap_*)message;
+
+        LockGuard<Mutex> guard(mutex);
+        received++;
+        if (!processor.Update(msg))
+        {
+            rejected++;
+        }
+    }
+
+private:
+    Mutex mutex;
+    HeightMapProcessor processor;
+    uint64_t received = 0;
+    uint64_t rejected = 0;
+    ChannelSubscriberPtr<unitree_go::msg::dds_::HeightMap_> height_map_subscriber;
+};
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: " << argv[0] << " networkInterface [ThreadNumber(2)]" << std::endl;
+        exit(-1);
+    }
+
+    HeightMapParam param;
+    param.threadNumber = argc > 2 ? std::stoi(argv[2]) : 2;
+
+    ChannelFactory::Instance()->Init(0, argv[1]);
+
+    Custom custom(param);
+    custom.Init();
+
+    while (true)
+    {
+        sleep(1);
+        custom.Print();
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/robot/go2/utlidar/voxel_map.hpp>
+#include <unitree/common/lock/lock.hpp>
+
+using namespace unitree::common;
+using namespace unitree::robot;
+using namespace unitree::robot::go2;
+
+class Custom
+{
+public:
+    void Init()
+    {
+        voxel_map_subscriber.reset(new ChannelSubscriber<unitree_go::msg::dds_::VoxelMapCompressed_>(ROBOT_UTLIDAR_VOXEL_MAP_TOPIC));
+        voxel_map_subscriber->InitChannel(std::bind(&Custom::VoxelMapMessageHandler, this, std::placeholders::_1), 1);
+    }
+
+    void Print()
+    {
+        LockGuard<Mutex> guard(mutex);
+
+        if (map.GetVoxelNumber() == 0)
+        {
+            std::cout << "maps: " << received << ", rejected: " << rejected << ", no map yet" << std::endl;
+            return;
+        }
+
+        /*
+         * occupied voxels in a 1m box around the grid center
+         */
+        const std::array<uint16_t, 3>& width = map.GetWidth();
+        const int32_t r = (int32_t)std::ceil(0.5 / map.GetResolution());
+        const int32_t cx = width[0] / 2, cy = width[1] / 2, cz = width[2] / 2;
+
+        std::cout << "maps: " << received << ", rejected: " << rejected
+                  << ", grid: " << width[0] << "x" << width[1] << "x" << width[2] << " @ " << map.GetResolution()
+                  << ", occupied: " << map.CountOccupied()
+                  << ", near center: " << map.CountOccupied(cx - r, cy - r, cz - r, cx + r, cy + r, cz + r)
+                  << ", changed: " << map.GetChangedNumber() << (map.IsGeometryChanged() ? " (new geometry)" : "")
+                  << std::endl;
+    }
+
+private:
+    void VoxelMapMessageHandler(const void* message)
+    {
+        const auto& msg = *(const unitree_go::msg::dds_::VoxelMapCompressed_*)message;
+
+        LockGuard<Mutex> guard(mutex);
+        received++;
+        if (!map.Update(msg))
+        {
+            rejected++;
+        }
+    }
+
+private:
+    Mutex mutex;
+    VoxelMap map;
+    uint64_t received = 0;
+    uint64_t rejected = 0;
+    ChannelSubscriberPtr<unitree_go::msg::dds_::VoxelMapCompressed_> voxel_map_subscriber;
+};
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: " << argv[0] << " networkInterface" << std::endl;
+        exit(-1);
+    }
+
+    ChannelFactory::Instance()->Init(0, argv[1]);
+
+    Custom custom;
+    custom.Init();
+
+    while (true)
+    {
+        sleep(1);
+        custom.Print();
+    }
+
+    return 0;
+}
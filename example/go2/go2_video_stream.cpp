@@ -0,0 +1,102 @@
+#include <unitree/robot/go2/video/video_client.hpp>
+#include <unitree/robot/go2/video/video_stream.hpp>
+#include <unitree/common/thread/recurrent_thread.hpp>
+
+using namespace unitree::common;
+using namespace unitree::robot;
+using namespace unitree::robot::go2;
+
+int main(int32_t argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: go2_video_stream [NetWorkInterface(eth0)] [Source(rpc|topic)]" << std::endl;
+        exit(0);
+    }
+
+    std::string networkInterface = argv[1];
+    std::string source = argc > 2 ? argv[2] : "rpc";
+
+    ChannelFactory::Instance()->Init(0, networkInterface);
+
+    /*
+     * the topic carries H.264, the RPC returns JPEG
+     */
+    VideoDecoderPtr decoder;
+    if (source == "topic")
+    {
+#ifdef UT_VIDEO_ENABLE_H264
+        decoder.reset(new VideoH264Decoder());
+#else
+        decoder.reset(new VideoPassthroughDecoder(true));
+#endif
+    }
+    else
+    {
+#ifdef UT_VIDEO_ENABLE_JPEG
+        decoder.reset(new VideoJpegDecoder());
+#else
+        decoder.reset(new VideoPassthroughDecoder());
+#endif
+    }
+
+    /*
+     * the topic carries three streams, keep decode within a 30 fps frame time
+     */
+    VideoStreamParam param;
+    param.adaptive = (source == "topic");
+    param.decodeBudgetMicrosec = 33000;
+    param.latencyBudgetMicrosec = 50000;
+
+    VideoStream stream(decoder, param);
+    stream.Start();
+
+    VideoClient client;
+    ThreadPtr pollThreadPtr;
+    std::vector<uint8_t> sample;
+
+    if (source == "topic")
+    {
+        stream.Subscribe();
+    }
+    else
+    {
+        /*
+         * push RPC samples into the stream as fast as the service answers
+         */
+        client.SetTimeout(1.0f);
+        client.Init();
+
+        pollThreadPtr = CreateRecurrentThreadEx("videopoll", UT_CPU_ID_NONE, 0, [&]() {
+            if (client.GetImageSample(sample) == 0)
+            {
+                stream.Push(sample, GetCurrentTimeMicrosecond());
+            }
+        });
+    }
+
+    uint64_t lastDecoded = 0;
+    while (true)
+    {
+        sleep(1);
+
+        uint64_t decoded = stream.GetDecodedCount();
+        VideoFramePtr frame = stream.GetLatestFrame();
+
+        std::cout << "fps: " << decoded - lastDecoded
+                  << ", resolution: " << stream.GetResolution()
+                  << ", dropped: " << stream.GetDroppedCount()
+                  << ", failed: " << stream.GetFailedCount();
+        if (frame)
+        {
+            std::cout << ", frame: " << frame->width << "x" << frame->height
+                      << ", bytes: " << frame->data.size()
+                      << ", decode: " << frame->decodeTime / 1000 << "us";
+        }
+        std::cout << std::endl;
+
+        lastDecoded = decoded;
+    }
+
+    return 0;
+}
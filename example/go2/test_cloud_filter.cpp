@@ -0,0 +1,227 @@
+#include <unitree/robot/go2/utlidar/cloud_filter.hpp>
+
+#include <array>
+#include <iostream>
+#include <vector>
+
+using namespace unitree::robot::go2;
+
+using Point = std::array<float, 4>;
+
+/*
+ * x, y, z and optionally intensity as packed float32 fields.
+ */
+static sensor_msgs::msg::dds_::PointCloud2_ MakeCloud(const std::vector<Point>& points, bool intensity)
+{
+    const uint32_t dim = intensity ? 4 : 3;
+    const uint32_t count = (uint32_t)points.size();
+
+    sensor_msgs::msg::dds_::PointCloud2_ cloud;
+    cloud.height(1);
+    cloud.width(count);
+    cloud.point_step(dim * sizeof(float));
+    cloud.row_step(count * cloud.point_step());
+
+    static const char* names[4] = { "x", "y", "z", "intensity" };
+    cloud.fields().resize(dim);
+    for (uint32_t i = 0; i < dim; i++)
+    {
+        cloud.fields()[i].name(names[i]);
+        cloud.fields()[i].offset(i * sizeof(float));
+        cloud.fields()[i].datatype(UT_POINT_FIELD_FLOAT32);
+        cloud.fields()[i].count(1);
+    }
+
+    cloud.data().resize(count * cloud.point_step());
+    float* p = (float*)cloud.data().data();
+    for (const Point& point : points)
+    {
+        memcpy(p, point.data(), dim * sizeof(float));
+        p += dim;
+    }
+
+    return cloud;
+}
+
+static std::vector<Point> ReadCloud(const sensor_msgs::msg::dds_::PointCloud2_& cloud)
+{
+    const uint32_t dim = cloud.point_step() / sizeof(float);
+
+    std::vector<Point> points(cloud.width(), Point{ 0.0f, 0.0f, 0.0f, 0.0f });
+    const float* p = (const float*)cloud.data().data();
+    for (Point& point : points)
+    {
+        memcpy(point.data(), p, dim * sizeof(float));
+        p += dim;
+    }
+
+    return points;
+}
+
+static bool Filter(const CloudFilterParam& param, const sensor_msgs::msg::dds_::PointCloud2_& in,
+    std::vector<Point>& out)
+{
+    CloudFilter filter(param);
+    sensor_msgs::msg::dds_::PointCloud2_ cloud;
+    if (!filter.Filter(in, cloud))
+    {
+        return false;
+    }
+
+    out = ReadCloud(cloud);
+    return true;
+}
+
+/*
+ * The default crop is unbounded, inf and NaN points must still be dropped,
+ * with and without the voxel filter.
+ */
+static int32_t TestNonFinite()
+{
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const sensor_msgs::msg::dds_::PointCloud2_ in = MakeCloud({
+        { 1.0f, 2.0f, 0.5f },
+        { inf, 0.0f, 0.5f },
+        { 0.0f, -inf, 0.5f },
+        { 0.0f, 0.0f, nan },
+        { -1.0f, 0.5f, 1.0f } }, false);
+
+    int32_t failures = 0;
+    for (float voxelSize : { 0.0f, 0.1f })
+    {
+        CloudFilterParam param;
+        param.voxelSize = voxelSize;
+
+        std::vector<Point> out;
+        if (!Filter(param, in, out) || out.size() != 2)
+        {
+            std::cout << "FAIL: voxel " << voxelSize << " kept " << out.size() << " points" << std::endl;
+            failures++;
+            continue;
+        }
+
+        for (const Point& p : out)
+        {
+            if (!std::isfinite(p[0]) || !std::isfinite(p[1]) || !std::isfinite(p[2]))
+            {
+                std::cout << "FAIL: voxel " << voxelSize << " output is not finite" << std::endl;
+                failures++;
+                break;
+            }
+        }
+    }
+
+    return failures;
+}
+
+/*
+ * Points of two 1 m voxels, one of them on the negative side of every axis,
+ * come out as the mean of each voxel, intensity included.
+ */
+static int32_t TestVoxelMean()
+{
+    const sensor_msgs::msg::dds_::PointCloud2_ in = MakeCloud({
+        { 0.1f, 0.2f, 0.3f, 10.0f },
+        { 0.5f, 0.6f, 0.7f, 20.0f },
+        { 0.9f, 0.1f, 0.2f, 30.0f },
+        { -0.2f, -0.4f, -0.6f, 1.0f },
+        { -0.8f, -0.6f, -0.4f, 3.0f } }, true);
+
+    const Point expect[2] = {
+        { 0.5f, 0.3f, 0.4f, 20.0f },
+        { -0.5f, -0.5f, -0.5f, 2.0f } };
+
+    CloudFilterParam param;
+    param.voxelSize = 1.0f;
+
+    std::vector<Point> out;
+    if (!Filter(param, in, out) || out.size() != 2)
+    {
+        std::cout << "FAIL: voxel mean kept " << out.size() << " voxels" << std::endl;
+        return 1;
+    }
+
+    int32_t failures = 0;
+    for (const Point& e : expect)
+    {
+        bool found = false;
+        for (const Point& p : out)
+        {
+            found = found || (std::fabs(p[0] - e[0]) < 1e-5f && std::fabs(p[1] - e[1]) < 1e-5f &&
+                std::fabs(p[2] - e[2]) < 1e-5f && std::fabs(p[3] - e[3]) < 1e-4f);
+        }
+
+        if (!found)
+        {
+            std::cout << "FAIL: no voxel at " << e[0] << " " << e[1] << " " << e[2] << " " << e[3] << std::endl;
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+/*
+ * A cropped cloud split over several workers must compact to exactly the
+ * single threaded result, crop only in input order, voxelized as a set.
+ */
+static int32_t TestThreadCompaction()
+{
+    std::vector<Point> points;
+    uint32_t seed = 12345;
+    for (int32_t i = 0; i < 20000; i++)
+    {
+        Point p;
+        for (int32_t j = 0; j < 4; j++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            p[j] = (float)(seed >> 8) / (float)(1 << 24) * 8.0f - 4.0f;
+        }
+        points.push_back(p);
+    }
+    const sensor_msgs::msg::dds_::PointCloud2_ in = MakeCloud(points, true);
+
+    CloudFilterParam param;
+    param.minX = -2.0f;
+    param.maxX = 3.0f;
+    param.maxRange = 4.0f;
+    param.groundHeight = -1.0f;
+
+    int32_t failures = 0;
+    for (float voxelSize : { 0.0f, 0.5f })
+    {
+        param.voxelSize = voxelSize;
+
+        param.threadNumber = 1;
+        std::vector<Point> single;
+        Filter(param, in, single);
+
+        param.threadNumber = 4;
+        std::vector<Point> multi;
+        Filter(param, in, multi);
+
+        if (voxelSize > 0.0f)
+        {
+            std::sort(single.begin(), single.end());
+            std::sort(multi.begin(), multi.end());
+        }
+
+        if (single.empty() || single.size() >= points.size() || single != multi)
+        {
+            std::cout << "FAIL: voxel " << voxelSize << " kept " << single.size() << " points on 1 thread, "
+                      << multi.size() << " on 4, or they differ" << std::endl;
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+int main()
+{
+    int32_t failures = TestNonFinite() + TestVoxelMean() + TestThreadCompaction();
+
+    std::cout << (failures ? "FAILED" : "passed") << std::endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,44 @@
+#include <unitree/robot/go2/video/video_stream.hpp>
+
+#include <iostream>
+
+using namespace unitree::robot::go2;
+
+/*
+ * Overloads 720p until the selector steps down, then lets decode cost fall
+ * back to normal. The selector must return to 720p.
+ */
+int main()
+{
+    /*
+     * 10 ms decode budget, 720p normally costs 5 ms, 4x the pixels per step
+     */
+    VideoResolutionSelector selector(VIDEO_RESOLUTION_720P, 10000);
+    const uint64_t cost[VIDEO_RESOLUTION_NUMBER] = { 5000000, 1250000, 312500 };
+
+    for (int32_t i = 0; i < 30; i++)
+    {
+        selector.Update(VIDEO_RESOLUTION_720P, 20000000, 0);
+    }
+
+    if (selector.GetCurrent() == VIDEO_RESOLUTION_720P)
+    {
+        std::cout << "FAIL: overload did not step down" << std::endl;
+        return 1;
+    }
+
+    for (int32_t i = 0; i < 3000 && selector.GetCurrent() != VIDEO_RESOLUTION_720P; i++)
+    {
+        const int32_t current = selector.GetCurrent();
+        selector.Update(current, cost[current], 0);
+    }
+
+    if (selector.GetCurrent() != VIDEO_RESOLUTION_720P)
+    {
+        std::cout << "FAIL: stayed at resolution " << selector.GetCurrent() << " after recovery" << std::endl;
+        return 1;
+    }
+
+    std::cout << "passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/idl/ros2/String_.hpp>
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+
+using namespace unitree::robot;
+
+static int32_t failures = 0;
+
+#define CHECK(cond)                                                         \
+    do                                                                      \
+    {                                                                       \
+        if (!(cond))                                                        \
+        {                                                                   \
+            std::cout << "FAIL line " << __LINE__ << ": " #cond << std::endl; \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+/*
+ * ChannelPublisher::Write reaches ChannelSubscriber in callback mode and
+ * with a queue length, and a closed subscriber can be initialized again.
+ */
+static void TestPublishSubscribe()
+{
+    using String = std_msgs::msg::dds_::String_;
+
+    std::string direct, queued;
+    int32_t directNumber = 0, queuedNumber = 0;
+
+    ChannelSubscriber<String> directSubscriber("rt/loopback_test");
+    directSubscriber.InitChannel([&](const void* message) {
+        direct = ((const String*)message)->data();
+        directNumber++;
+    });
+
+    ChannelSubscriber<String> queuedSubscriber("rt/loopback_test");
+    queuedSubscriber.InitChannel([&](const void* message) {
+        queued = ((const String*)message)->data();
+        queuedNumber++;
+    }, 10);
+
+    ChannelPublisher<String> publisher("rt/loopback_test");
+    publisher.InitChannel();
+
+    String message;
+    message.data("hello");
+    CHECK(publisher.Write(message));
+    CHECK(direct == "hello" && directNumber == 1);
+    CHECK(queued == "hello" && queuedNumber == 1);
+    CHECK(directSubscriber.GetLastDataAvailableTime() > 0);
+
+    directSubscriber.CloseChannel();
+    message.data("closed");
+    CHECK(publisher.Write(message));
+    CHECK(direct == "hello" && directNumber == 1);
+    CHECK(queued == "closed" && queuedNumber == 2);
+
+    directSubscriber.InitChannel();
+    message.data("again");
+    CHECK(publisher.Write(message));
+    CHECK(direct == "again" && directNumber == 2);
+    CHECK(queued == "again" && queuedNumber == 3);
+
+    publisher.CloseChannel();
+    CHECK(!publisher.Write(message));
+    publisher.InitChannel();
+    CHECK(publisher.Write(message));
+    CHECK(directNumber == 3 && queuedNumber == 4);
+}
+
+/*
+ * One thread closes a reader from inside its handler while a second thread
+ * is still delivering to it. Close must return once the second delivery
+ * leaves the handler.
+ */
+static void TestCloseInHandler()
+{
+    std::promise<void> enteredPromise;
+    std::shared_future<void> entered = enteredPromise.get_future().share();
+    std::promise<void> releasePromise;
+    std::shared_future<void> release = releasePromise.get_future().share();
+
+    const int closeMessage = 1;
+    const int slowMessage = 2;
+
+    LoopbackReaderPtr reader;
+    reader.reset(new LoopbackReader([&](const void* message) {
+        if (message == &slowMessage)
+        {
+            enteredPromise.set_value();
+            release.wait();
+            // leave after the closing thread is waiting in Close
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        else if (message == &closeMessage)
+        {
+            releasePromise.set_value();
+            reader->Close();
+        }
+    }));
+
+    std::thread slow([&] { reader->Deliver(&slowMessage); });
+    entered.wait();
+
+    std::future<void> closing = std::async(std::launch::async, [&] { reader->Deliver(&closeMessage); });
+    const bool closed = closing.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    slow.join();
+
+    if (!closed)
+    {
+        std::cout << "FAIL: Close from a handler did not return" << std::endl;
+        std::_Exit(1);
+    }
+}
+
+int main()
+{
+    ChannelFactory::Instance()->InitLoopback();
+
+    TestPublishSubscribe();
+    TestCloseInHandler();
+
+    std::cout << (failures ? "FAILED" : "passed") << std::endl;
+    return failures ? 1 : 0;
+}
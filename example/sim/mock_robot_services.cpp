@@ -0,0 +1,78 @@
+#include <unitree/robot/b2/motion_switcher/motion_switcher_mock_server.hpp>
+#include <unitree/robot/g1/loco/g1_loco_mock_server.hpp>
+#include <unitree/robot/go2/sport/sport_mock_server.hpp>
+#include <unitree/robot/go2/video/video_mock_server.hpp>
+
+#include <cstring>
+#include <iostream>
+
+using namespace unitree::robot;
+
+/*
+ * Serves the high level apis of a robot with injected latency and
+ * failures, so clients can be load tested without hardware.
+ */
+int main(int argc, const char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: " << argv[0] << " go2|g1 networkInterface [latencyMicrosec] [failureRate] [payloadSize]" << std::endl;
+        exit(-1);
+    }
+
+    MockServerParam param;
+    if (argc > 3)
+    {
+        param.latencyMicrosec = atoll(argv[3]);
+        param.jitterMicrosec = param.latencyMicrosec / 10;
+    }
+    if (argc > 4)
+    {
+        param.failureRate = atof(argv[4]);
+    }
+    if (argc > 5)
+    {
+        param.payloadSize = atoll(argv[5]);
+    }
+
+    ChannelFactory::Instance()->Init(0, argv[2]);
+
+    std::vector<MockServerPtr> servers;
+    servers.push_back(MockServerPtr(new b2::MotionSwitcherMockServer("normal", "0", param)));
+
+    if (strcmp(argv[1], "go2") == 0)
+    {
+        servers.push_back(MockServerPtr(new go2::SportMockServer(param)));
+        servers.push_back(MockServerPtr(new go2::VideoMockServer(param)));
+    }
+    else if (strcmp(argv[1], "g1") == 0)
+    {
+        servers.push_back(MockServerPtr(new g1::LocoMockServer(param)));
+    }
+    else
+    {
+        std::cout << "unknown robot: " << argv[1] << std::endl;
+        exit(-1);
+    }
+
+    for (const MockServerPtr& server : servers)
+    {
+        server->Init();
+        server->Start(false);
+    }
+
+    while (true)
+    {
+        sleep(1);
+        for (const MockServerPtr& server : servers)
+        {
+            const ServerBase& base = *server;
+            std::cout << base.GetName()
+                      << " requests: " << server->GetRequestNumber()
+                      << ", failures: " << server->GetFailureNumber()
+                      << ", drops: " << server->GetDropNumber() << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <unitree/robot/sim/sim_robot.hpp>
+#include <unitree/robot/model/g1_model.hpp>
+#include <unitree/robot/model/h1_model.hpp>
+#include <unitree/robot/model/quadruped_model.hpp>
+
+#include <cstring>
+#include <iostream>
+
+using namespace unitree::robot;
+
+/*
+ * Publishes rt/lowstate and follows rt/lowcmd in place of a robot, so low
+ * level examples and controllers run without hardware.
+ */
+template<typename Model>
+void Run(const SimRobotParam& param)
+{
+    SimJointDynamics<Model> dynamics;
+    SimRobot<SimJointDynamics<Model>> robot(dynamics, param);
+
+    robot.InitChannel();
+    robot.Start();
+
+    while (true)
+    {
+        sleep(1);
+        std::cout << Model::NAME
+                  << " time: " << robot.GetTime() << " s"
+                  << ", steps: " << robot.GetStepNumber()
+                  << ", cmds: " << robot.GetCmdNumber()
+                  << ", crc errors: " << robot.GetCrcErrorNumber() << std::endl;
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: " << argv[0] << " go2|b2|h1|h1_2|g1 networkInterface [frequency] [timeScale]" << std::endl;
+        exit(-1);
+    }
+
+    SimRobotParam param;
+    if (argc > 3)
+    {
+        param.frequency = atof(argv[3]);
+    }
+    if (argc > 4)
+    {
+        param.timeScale = atof(argv[4]);
+    }
+
+    ChannelFactory::Instance()->Init(0, argv[2]);
+
+    const char* name = argv[1];
+    if (strcmp(name, "go2") == 0)
+    {
+        Run<model::Go2>(param);
+    }
+    else if (strcmp(name, "b2") == 0)
+    {
+        Run<model::B2>(param);
+    }
+    else if (strcmp(name, "h1") == 0)
+    {
+        Run<model::H1>(param);
+    }
+    else if (strcmp(name, "h1_2") == 0)
+    {
+        Run<model::H1_2>(param);
+    }
+    else if (strcmp(name, "g1") == 0)
+    {
+        Run<model::G1Dof29>(param);
+    }
+    else
+    {
+        std::cout << "unknown model: " << name << std::endl;
+        exit(-1);
+    }
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <unitree/robot/client/chunked_upload_client.hpp>
+#include <unitree/robot/server/chunked_upload_receiver.hpp>
+
+#include <cstring>
+#include <iostream>
+
+using namespace unitree::common;
+using namespace unitree::robot;
+
+const std::string UPLOAD_EXAMPLE_SERVICE_NAME = "upload_example";
+const std::string UPLOAD_EXAMPLE_API_VERSION = "1.0.0.1";
+
+const int32_t UPLOAD_EXAMPLE_API_ID_UPLOAD = 1001;
+
+/*
+ * FNV-1a over the payload, computed on both sides to check the reassembly.
+ */
+uint64_t Checksum(const uint8_t* data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/*
+ * Routes the upload api to a ChunkedUploadReceiver, answers every completed
+ * upload with its size and checksum.
+ */
+class UploadServer : public Server
+{
+public:
+    UploadServer() :
+        Server(UPLOAD_EXAMPLE_SERVICE_NAME),
+        mReceiver(std::bind(&UploadServer::UploadHandler, this, std::placeholders::_1, std::placeholders::_2,
+            std::placeholders::_3, std::placeholders::_4))
+    {}
+
+    void Init()
+    {
+        SetApiVersion(UPLOAD_EXAMPLE_API_VERSION);
+    }
+
+protected:
+    void ServerRequestHandler(const RequestPtr& request)
+    {
+        if (request->header().identity().api_id() == UPLOAD_EXAMPLE_API_ID_UPLOAD)
+        {
+            SendResponse(mReceiver.Receive(*request));
+            return;
+        }
+
+        Server::ServerRequestHandler(request);
+    }
+
+private:
+    int32_t UploadHandler(const std::string& streamId, const std::string& parameter, std::vector<uint8_t>& payload,
+        std::string& data)
+    {
+        const uint64_t checksum = Checksum(payload.data(), payload.size());
+        std::cout << "stream " << streamId << " (" << parameter << "): " << payload.size()
+                  << " bytes, checksum " << checksum << std::endl;
+
+        data = "{\"size\":" + std::to_string(payload.size()) + ",\"checksum\":" + std::to_string(checksum) + "}";
+        return UT_ROBOT_OK;
+    }
+
+private:
+    ChunkedUploadReceiver mReceiver;
+};
+
+int main(int argc, const char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: " << argv[0] << " networkInterface server|client [Size(1048576)] [ChunkSize(65536)] [Window(4)]" << std::endl;
+        exit(-1);
+    }
+
+    ChannelFactory::Instance()->Init(0, argv[1]);
+
+    if (strcmp(argv[2], "server") == 0)
+    {
+        UploadServer server;
+        server.Init();
+        server.Start(false);
+
+        while (true)
+        {
+            sleep(10);
+        }
+    }
+
+    const size_t size = argc > 3 ? atoll(argv[3]) : 1048576;
+
+    std::vector<uint8_t> payload(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        payload[i] = (uint8_t)(i * 31 + (i >> 8));
+    }
+
+    ChunkedUploadClient client(UPLOAD_EXAMPLE_SERVICE_NAME, UPLOAD_EXAMPLE_API_ID_UPLOAD);
+    client.Init();
+    client.SetTimeout(1.0f);
+    client.SetChunkSize(argc > 4 ? atoi(argv[4]) : ROBOT_UPLOAD_CHUNK_SIZE);
+    client.SetWindow(argc > 5 ? atoi(argv[5]) : ROBOT_UPLOAD_WINDOW);
+
+    /*
+     * let the client match the service before the first window goes out
+     */
+    sleep(1);
+
+    std::string data;
+    const std::string streamId = "example-" + std::to_string(GetCurrentTimeMillisecond());
+    const int64_t begin = GetCurrentMonotonicTimeMicrosecond();
+    int32_t ret = client.Upload(streamId, "{\"name\":\"payload.bin\"}", payload, data);
+    const int64_t end = GetCurrentMonotonicTimeMicrosecond();
+
+    std::cout << "upload ret: " << ret << ", committed: " << client.GetCommitted() << "/" << size
+              << ", retries: " << client.GetRetryCount() << ", time: " << (end - begin) / 1000 << " ms" << std::endl;
+
+    if (ret != UT_ROBOT_OK)
+    {
+        return -1;
+    }
+
+    std::cout << "server: " << data << ", local checksum " << Checksum(payload.data(), payload.size()) << std::endl;
+
+    return 0;
+}
@@ -1,13 +1,5 @@
-#include <mutex>
-
-// #include <go2_idl/WirelessController_.hpp>
-#include "unitree/idl/go2/WirelessController_.hpp"
+#include "unitree/robot/gamepad/gamepad.hpp"
 #include "unitree/common/thread/thread.hpp"
-#include "unitree/robot/channel/channel_subscriber.hpp"
-
-#include "advanced_gamepad.hpp"
-
-#define TOPIC_JOYSTICK "rt/wirelesscontroller"
 
 using namespace unitree::common;
 using namespace unitree::robot;
@@ -21,50 +13,47 @@ public:
     void InitDdsModel(const std::string &networkInterface = "")
     {
         ChannelFactory::Instance()->Init(0, networkInterface);
-        joystick_subscriber.reset(new ChannelSubscriber<unitree_go::msg::dds_::WirelessController_>(TOPIC_JOYSTICK));
 
-        joystick_subscriber->InitChannel(std::bind(&GamepadExample::MessageHandler, this, std::placeholders::_1), 1);
+        // decodes rt/wirelesscontroller on the subscriber thread, no locking needed
+        gamepad.InitChannel(UT_GAMEPAD_TOPIC);
     }
 
     // set gamepad dead_zone parameter
     void SetGamepadDeadZone(float deadzone)
     {
-        gamepad.dead_zone = deadzone;
+        gamepad.SetDeadZone(deadzone);
     }
 
     // set gamepad smooth parameter
     void setGamepadSmooth(float smooth)
     {
-        gamepad.smooth = smooth;
-    }
-
-    // callback function to save joystick message
-    void MessageHandler(const void *message)
-    {
-        std::lock_guard<std::mutex> lock(joystick_mutex);
-        joystick_msg = *(unitree_go::msg::dds_::WirelessController_ *)message;
+        gamepad.SetSmooth(smooth);
     }
 
     // work thread
     void Step()
     {
-        {
-            std::lock_guard<std::mutex> lock(joystick_mutex);
-            gamepad.Update(joystick_msg);
-        }
+        // pick up the newest message
+        gamepad.Update();
 
         // some operations
-        if (gamepad.A.on_press)
+        if (gamepad.OnPress(UT_GAMEPAD_KEY_A))
         {
             press_count += 1;
         }
+        if (gamepad.OnDoublePress(UT_GAMEPAD_KEY_B))
+        {
+            double_press_count += 1;
+        }
 
         // print gamepad state
-        std::cout << "lx: " << gamepad.lx << std::endl
-                  << "A: pressed: " << gamepad.A.pressed
-                  << "; on_press: " << gamepad.A.on_press
-                  << "; on_release: " << gamepad.A.on_release
+        std::cout << "lx: " << gamepad.GetLx() << std::endl
+                  << "A: pressed: " << gamepad.IsPressed(UT_GAMEPAD_KEY_A)
+                  << "; on_press: " << gamepad.OnPress(UT_GAMEPAD_KEY_A)
+                  << "; on_release: " << gamepad.OnRelease(UT_GAMEPAD_KEY_A)
+                  << "; held: " << gamepad.IsHeld(UT_GAMEPAD_KEY_A)
                   << std::endl << "press count: " << press_count
+                  << std::endl << "B double press count: " << double_press_count
                   << std::endl << "===========================" << std::endl;
     }
 
@@ -75,16 +64,12 @@ public:
     }
 
 protected:
-    ChannelSubscriberPtr<unitree_go::msg::dds_::WirelessController_> joystick_subscriber;
-    unitree_go::msg::dds_::WirelessController_ joystick_msg;
-
     Gamepad gamepad;
 
     ThreadPtr control_thread_ptr;
 
-    std::mutex joystick_mutex;
-
     int press_count = 0;
+    int double_press_count = 0;
 };
 
 int main()
@@ -105,4 +90,4 @@ int main()
         usleep(20000);
     }
     return 0;
-}
\ No newline at end of file
+}
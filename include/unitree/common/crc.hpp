@@ -0,0 +1,77 @@
+#ifndef __UT_CRC_HPP__
+#define __UT_CRC_HPP__
+
+#include <unitree/common/decl.hpp>
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * CRC-32 (polynomial 0x04c11db7, init 0xffffffff, msb first, no reflection,
+ * no final xor) over 32 bit words, most significant byte first. Same value
+ * as the bitwise crc32_core used by the low level examples, one table lookup
+ * per byte instead of one branch per bit.
+ */
+class Crc32Table
+{
+public:
+    static const Crc32Table& Instance()
+    {
+        static const Crc32Table table;
+        return table;
+    }
+
+    uint32_t operator[](uint32_t index) const
+    {
+        return mTable[index];
+    }
+
+private:
+    Crc32Table()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i << 24;
+            for (int32_t bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04c11db7 : (crc << 1);
+            }
+            mTable[i] = crc;
+        }
+    }
+
+    uint32_t mTable[256];
+};
+
+inline uint32_t Crc32Core(const uint32_t* ptr, uint32_t len)
+{
+    const Crc32Table& table = Crc32Table::Instance();
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        const uint32_t data = ptr[i];
+        crc = (crc << 8) ^ table[(crc >> 24) ^ (data >> 24)];
+        crc = (crc << 8) ^ table[(crc >> 24) ^ ((data >> 16) & 0xFF)];
+        crc = (crc << 8) ^ table[(crc >> 24) ^ ((data >> 8) & 0xFF)];
+        crc = (crc << 8) ^ table[(crc >> 24) ^ (data & 0xFF)];
+    }
+
+    return crc;
+}
+
+/*
+ * @brief crc of a low level message (LowCmd_, LowState_, ...), every word
+ *        except the trailing crc field.
+ */
+template<typename MSG>
+inline uint32_t Crc32Message(const MSG& msg)
+{
+    return Crc32Core((const uint32_t*)&msg, (sizeof(MSG) >> 2) - 1);
+}
+
+}
+}
+
+#endif//__UT_CRC_HPP__
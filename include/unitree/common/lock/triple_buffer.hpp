@@ -0,0 +1,91 @@
+#ifndef __UT_TRIPLE_BUFFER_HPP__
+#define __UT_TRIPLE_BUFFER_HPP__
+
+#include <unitree/common/decl.hpp>
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * TripleBuffer
+ *
+ * Wait-free latest-value hand-off from one writer thread to one reader
+ * thread. The writer fills its back slot and publishes it by swapping with
+ * the middle slot; the reader swaps the middle slot into its front slot when
+ * a newer value is present. Neither side ever blocks or allocates, values
+ * the reader did not pick up in time are overwritten.
+ */
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() :
+        mBack(0), mMiddle(1), mFront(2)
+    {}
+
+    /*
+     * @brief writer side, slot to fill before Publish.
+     */
+    T& GetWriteBuffer()
+    {
+        return mSlot[mBack];
+    }
+
+    void Publish()
+    {
+        mBack = mMiddle.exchange(mBack | UT_TRIPLE_BUFFER_FRESH, std::memory_order_acq_rel) & UT_TRIPLE_BUFFER_INDEX;
+    }
+
+    void Write(const T& value)
+    {
+        mSlot[mBack] = value;
+        Publish();
+    }
+
+    /*
+     * @brief reader side, take the newest published value if any.
+     * @return true if the front slot changed.
+     */
+    bool Update()
+    {
+        if (!(mMiddle.load(std::memory_order_relaxed) & UT_TRIPLE_BUFFER_FRESH))
+        {
+            return false;
+        }
+
+        mFront = mMiddle.exchange(mFront, std::memory_order_acq_rel) & UT_TRIPLE_BUFFER_INDEX;
+        return true;
+    }
+
+    /*
+     * @brief reader side, value taken by the last Update.
+     */
+    const T& GetReadBuffer() const
+    {
+        return mSlot[mFront];
+    }
+
+    T& GetReadBuffer()
+    {
+        return mSlot[mFront];
+    }
+
+private:
+    enum
+    {
+        UT_TRIPLE_BUFFER_INDEX = 0x3,
+        UT_TRIPLE_BUFFER_FRESH = 0x4
+    };
+
+    T mSlot[3];
+
+    alignas(64) uint8_t mBack;
+    alignas(64) std::atomic<uint8_t> mMiddle;
+    alignas(64) uint8_t mFront;
+};
+
+}
+}
+
+#endif//__UT_TRIPLE_BUFFER_HPP__
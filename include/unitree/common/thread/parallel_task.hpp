@@ -0,0 +1,124 @@
+#ifndef __UT_PARALLEL_TASK_HPP__
+#define __UT_PARALLEL_TASK_HPP__
+
+#include <unitree/common/thread/thread_pool.hpp>
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * @brief
+ * @class: ParallelTask
+ *
+ * Fork-join helper for data-parallel kernels. Part 0 always runs on the
+ * calling thread, parts [1, n) are dispatched to an owned ThreadPool, and
+ * Run() returns once every part has finished.
+ */
+class ParallelTask
+{
+public:
+    explicit ParallelTask(uint32_t threadNumber = 1) :
+        mThreadNumber(threadNumber == 0 ? 1 : threadNumber)
+    {
+        if (mThreadNumber > 1)
+        {
+            mThreadPoolPtr.reset(new ThreadPool(mThreadNumber - 1));
+            mFutures.reserve(mThreadNumber - 1);
+        }
+    }
+
+    ~ParallelTask()
+    {
+        if (mThreadPoolPtr)
+        {
+            mThreadPoolPtr->Quit(true);
+        }
+    }
+
+    ParallelTask(const ParallelTask&) = delete;
+    ParallelTask& operator=(const ParallelTask&) = delete;
+
+    uint32_t GetThreadNumber() const
+    {
+        return mThreadNumber;
+    }
+
+    /*
+     * @brief run func(part) for every part in [0, partNumber)
+     */
+    template<typename Func>
+    void Run(uint32_t partNumber, const Func& func)
+    {
+        if (partNumber == 0)
+        {
+            return;
+        }
+
+        mFutures.clear();
+
+        for (uint32_t part = 1; part < partNumber; part++)
+        {
+            FuturePtr future;
+            if (mThreadPoolPtr)
+            {
+                future = mThreadPoolPtr->AddTaskFuture([&func, part]() {
+                    func(part);
+                    return 0;
+                });
+            }
+
+            if (future)
+            {
+                mFutures.push_back(future);
+            }
+            else
+            {
+                func(part);
+            }
+        }
+
+        func(0);
+
+        for (const FuturePtr& future : mFutures)
+        {
+            future->Wait();
+        }
+    }
+
+    /*
+     * @brief split [0, count) into one contiguous range per thread and run func(part, begin, end)
+     * @return number of parts used
+     */
+    template<typename Func>
+    uint32_t Range(size_t count, const Func& func)
+    {
+        uint32_t partNumber = mThreadNumber;
+        if (count < partNumber)
+        {
+            partNumber = count == 0 ? 1 : (uint32_t)count;
+        }
+
+        const size_t step = (count + partNumber - 1) / partNumber;
+
+        Run(partNumber, [&func, count, step](uint32_t part) {
+            size_t begin = std::min(count, step * part);
+            size_t end = std::min(count, begin + step);
+            func(part, begin, end);
+        });
+
+        return partNumber;
+    }
+
+private:
+    uint32_t mThreadNumber;
+    ThreadPoolPtr mThreadPoolPtr;
+    std::vector<FuturePtr> mFutures;
+};
+
+using ParallelTaskPtr = std::shared_ptr<ParallelTask>;
+
+}
+}
+
+#endif//__UT_PARALLEL_TASK_HPP__
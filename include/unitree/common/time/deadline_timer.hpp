@@ -0,0 +1,108 @@
+#ifndef __UT_DEADLINE_TIMER_HPP__
+#define __UT_DEADLINE_TIMER_HPP__
+
+#include <unitree/common/decl.hpp>
+
+#include <cerrno>
+#include <time.h>
+
+namespace unitree
+{
+namespace common
+{
+/*
+ * DeadlineTimer
+ *
+ * Fixed period wakeups on absolute CLOCK_MONOTONIC deadlines. The period
+ * does not drift with the work done between waits; a wakeup later than one
+ * period re-anchors the schedule at the current time instead of returning
+ * immediately for every missed tick. Not thread safe, owned by one loop.
+ */
+class DeadlineTimer
+{
+public:
+    explicit DeadlineTimer(int64_t periodNanosec) :
+        mPeriod(periodNanosec), mDeadline(0), mWakeTime(0), mOverrunNumber(0)
+    {}
+
+    static int64_t GetClock()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+    }
+
+    /*
+     * @brief first deadline is one period from now.
+     */
+    void Start()
+    {
+        mDeadline = GetClock();
+        mOverrunNumber = 0;
+    }
+
+    /*
+     * @brief sleep until the next deadline.
+     * @return lateness of the wakeup in nanoseconds.
+     */
+    int64_t Wait()
+    {
+        mDeadline += mPeriod;
+
+        struct timespec ts;
+        ts.tv_sec = mDeadline / 1000000000;
+        ts.tv_nsec = mDeadline % 1000000000;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+        {}
+
+        mWakeTime = GetClock();
+        const int64_t lateness = mWakeTime - mDeadline;
+        if (lateness > mPeriod)
+        {
+            mOverrunNumber++;
+            mDeadline = mWakeTime;
+        }
+
+        return lateness;
+    }
+
+    int64_t GetPeriod() const
+    {
+        return mPeriod;
+    }
+
+    /*
+     * @brief deadline of the last Wait, the nominal tick time.
+     */
+    int64_t GetDeadline() const
+    {
+        return mDeadline;
+    }
+
+    /*
+     * @brief clock read right after the last Wait returned.
+     */
+    int64_t GetWakeTime() const
+    {
+        return mWakeTime;
+    }
+
+    /*
+     * @brief wakeups more than one period late since Start.
+     */
+    uint64_t GetOverrunNumber() const
+    {
+        return mOverrunNumber;
+    }
+
+private:
+    int64_t mPeriod;
+    int64_t mDeadline;
+    int64_t mWakeTime;
+    uint64_t mOverrunNumber;
+};
+
+}
+}
+
+#endif//__UT_DEADLINE_TIMER_HPP__
@@ -0,0 +1,109 @@
+#ifndef __UT_ROBOT_B2_MOTION_SWITCHER_MOCK_SERVER_HPP__
+#define __UT_ROBOT_B2_MOTION_SWITCHER_MOCK_SERVER_HPP__
+
+#include <unitree/robot/server/mock_server.hpp>
+#include <unitree/robot/b2/motion_switcher/motion_switcher_api.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+namespace b2
+{
+/*
+ * MotionSwitcherMockServer
+ *
+ * Keeps the selected mode and the silent flag. CheckMode reports the mode
+ * given to SelectMode, an empty name after ReleaseMode.
+ */
+class MotionSwitcherMockServer : public MockServer
+{
+public:
+    explicit MotionSwitcherMockServer(const std::string& name = "normal", const std::string& form = "0",
+        const MockServerParam& param = MockServerParam()) :
+        MockServer(MOTION_SWITCHER_SERVICE_NAME, param), mSilent(false)
+    {
+        mMode.name = name;
+        mMode.form = form;
+    }
+
+    ~MotionSwitcherMockServer()
+    {}
+
+    void Init()
+    {
+        SetApiVersion(MOTION_SWITCHER_API_VERSION);
+        UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(MOTION_SWITCHER_API_ID_CHECK_MODE, &MotionSwitcherMockServer::CheckMode);
+        UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(MOTION_SWITCHER_API_ID_SELECT_MODE, &MotionSwitcherMockServer::SelectMode);
+        UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(MOTION_SWITCHER_API_ID_RELEASE_MODE, &MotionSwitcherMockServer::ReleaseMode);
+        UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(MOTION_SWITCHER_API_ID_SET_SILENT, &MotionSwitcherMockServer::SetSilent);
+        UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(MOTION_SWITCHER_API_ID_GET_SILENT, &MotionSwitcherMockServer::GetSilent);
+    }
+
+private:
+    int32_t CheckMode(const std::string&, std::string& data)
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+        data = common::ToJsonString(mMode);
+        return UT_ROBOT_OK;
+    }
+
+    int32_t SelectMode(const std::string& parameter, std::string&)
+    {
+        JsonizeModeName json;
+        try
+        {
+            common::FromJsonString(parameter, json);
+        }
+        catch (const common::Exception&)
+        {
+            return UT_ROBOT_ERR_SERVER_API_PARAMETER;
+        }
+
+        common::LockGuard<common::Mutex> guard(mMutex);
+        mMode.name = json.name;
+        return UT_ROBOT_OK;
+    }
+
+    int32_t ReleaseMode(const std::string&, std::string&)
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+        mMode.name.clear();
+        return UT_ROBOT_OK;
+    }
+
+    int32_t SetSilent(const std::string& parameter, std::string&)
+    {
+        JsonizeSilent json;
+        try
+        {
+            common::FromJsonString(parameter, json);
+        }
+        catch (const common::Exception&)
+        {
+            return UT_ROBOT_ERR_SERVER_API_PARAMETER;
+        }
+
+        mSilent = json.silent;
+        return UT_ROBOT_OK;
+    }
+
+    int32_t GetSilent(const std::string&, std::string& data)
+    {
+        JsonizeSilent json;
+        json.silent = mSilent;
+        data = common::ToJsonString(json);
+        return UT_ROBOT_OK;
+    }
+
+private:
+    common::Mutex mMutex;
+    JsonizeModeName mMode;
+    std::atomic<bool> mSilent;
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_B2_MOTION_SWITCHER_MOCK_SERVER_HPP__
@@ -2,6 +2,7 @@
 #define __UT_ROBOT_SDK_CHANNEL_FACTORY_HPP__
 
 #include <unitree/common/dds/dds_factory_model.hpp>
+#include <unitree/robot/channel/channel_loopback.hpp>
 
 namespace unitree
 {
@@ -26,6 +27,16 @@ public:
     void Init(const std::string& configFileName = "");
     void Init(const common::JsonMap& jsonMap);
 
+    /*
+     * In-process transport instead of DDS for tests and simulation.
+     * ChannelPublisher and ChannelSubscriber created afterwards exchange
+     * messages by pointer within this process, see ChannelLoopback.
+     */
+    void InitLoopback()
+    {
+        ChannelLoopback::Instance()->Enable();
+    }
+
     void Release();
 
     template<typename MSG>
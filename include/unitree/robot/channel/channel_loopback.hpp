@@ -0,0 +1,377 @@
+#ifndef __UT_ROBOT_SDK_CHANNEL_LOOPBACK_HPP__
+#define __UT_ROBOT_SDK_CHANNEL_LOOPBACK_HPP__
+
+#include <unitree/common/exception.hpp>
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/common/time/time_tool.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+#include <vector>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief: LoopbackReader
+ *
+ * One subscriber of a loopback topic. The handler is called without any lock
+ * held, so handlers may publish to each other's topics. Close waits for
+ * deliveries in flight on other threads, so the handler is never called
+ * after Close returns; a Close from inside the handler does not wait for
+ * itself.
+ */
+class LoopbackReader
+{
+public:
+    using Handler = std::function<void(const void*)>;
+
+    explicit LoopbackReader(const Handler& handler) :
+        mHandler(handler), mClosed(false), mActive(0), mLastDataAvailableTime(0)
+    {}
+
+    void Deliver(const void* message)
+    {
+        mActive++;
+        if (!mClosed)
+        {
+            Frame frame(this);
+            mLastDataAvailableTime = common::GetCurrentMonotonicTimeNanosecond();
+            mHandler(message);
+        }
+
+        // Close may be waiting for any count, not only 0, when it was called
+        // from a handler, so every decrement after it wakes it up.
+        mActive--;
+        if (mClosed)
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            mIdle.notify_all();
+        }
+    }
+
+    void Close()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mClosed = true;
+
+        const int32_t self = Frame::Count(this);
+        mIdle.wait(lock, [&] { return mActive == self; });
+    }
+
+    int64_t GetLastDataAvailableTime() const
+    {
+        return mLastDataAvailableTime;
+    }
+
+private:
+    /*
+     * deliveries on the calling thread, innermost first, so a Close from
+     * inside a handler does not wait for itself.
+     */
+    class Frame
+    {
+    public:
+        explicit Frame(const LoopbackReader* reader) :
+            mReader(reader), mPrev(Top())
+        {
+            Top() = this;
+        }
+
+        ~Frame()
+        {
+            Top() = mPrev;
+        }
+
+        static int32_t Count(const LoopbackReader* reader)
+        {
+            int32_t count = 0;
+            for (const Frame* f = Top(); f != nullptr; f = f->mPrev)
+            {
+                count += (f->mReader == reader);
+            }
+            return count;
+        }
+
+    private:
+        static const Frame*& Top()
+        {
+            static thread_local const Frame* top = nullptr;
+            return top;
+        }
+
+        const LoopbackReader* mReader;
+        const Frame* mPrev;
+    };
+
+private:
+    Handler mHandler;
+    std::atomic<bool> mClosed;
+    std::atomic<int32_t> mActive;
+    std::atomic<int64_t> mLastDataAvailableTime;
+
+    std::mutex mMutex;
+    std::condition_variable mIdle;
+};
+
+using LoopbackReaderPtr = std::shared_ptr<LoopbackReader>;
+
+
+/*
+ * @brief: LoopbackTopic
+ *
+ * Readers are kept in a copy on write list, a write takes a snapshot under
+ * the lock and delivers without holding it.
+ */
+class LoopbackTopic
+{
+public:
+    using ReaderList = std::vector<LoopbackReaderPtr>;
+    using ReaderListPtr = std::shared_ptr<const ReaderList>;
+
+    explicit LoopbackTopic(const std::type_info& type) :
+        mType(type), mReaders(new ReaderList())
+    {}
+
+    const std::type_info& GetType() const
+    {
+        return mType;
+    }
+
+    void AddReader(const LoopbackReaderPtr& reader)
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+        std::shared_ptr<ReaderList> readers(new ReaderList(*mReaders));
+        readers->push_back(reader);
+        mReaders = readers;
+    }
+
+    void RemoveReader(const LoopbackReaderPtr& reader)
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+        std::shared_ptr<ReaderList> readers(new ReaderList());
+        for (const LoopbackReaderPtr& r : *mReaders)
+        {
+            if (r != reader)
+            {
+                readers->push_back(r);
+            }
+        }
+        mReaders = readers;
+    }
+
+    bool Write(const void* message)
+    {
+        ReaderListPtr readers;
+        {
+            common::LockGuard<common::Mutex> guard(mMutex);
+            readers = mReaders;
+        }
+
+        for (const LoopbackReaderPtr& r : *readers)
+        {
+            r->Deliver(message);
+        }
+
+        return true;
+    }
+
+private:
+    const std::type_info& mType;
+    common::Mutex mMutex;
+    ReaderListPtr mReaders;
+};
+
+using LoopbackTopicPtr = std::shared_ptr<LoopbackTopic>;
+
+
+/*
+ * @brief: LoopbackChannel
+ *
+ * Same Write/GetLastDataAvailableTime surface as DdsTopicChannel. A write
+ * calls every reader's handler with the address of the caller's message in
+ * the caller's thread, nothing is serialized, copied or queued.
+ */
+template<typename MSG>
+class LoopbackChannel
+{
+public:
+    explicit LoopbackChannel(const LoopbackTopicPtr& topic) :
+        mTopic(topic)
+    {}
+
+    ~LoopbackChannel()
+    {
+        if (mReader)
+        {
+            mTopic->RemoveReader(mReader);
+            mReader->Close();
+        }
+    }
+
+    void SetReader(const std::function<void(const void*)>& handler)
+    {
+        mReader.reset(new LoopbackReader(handler));
+        mTopic->AddReader(mReader);
+    }
+
+    bool Write(const MSG& message, int64_t /*waitMicrosec*/)
+    {
+        return mTopic->Write((const void*)&message);
+    }
+
+    int64_t GetLastDataAvailableTime() const
+    {
+        if (mReader)
+        {
+            return mReader->GetLastDataAvailableTime();
+        }
+
+        return 0;
+    }
+
+private:
+    LoopbackTopicPtr mTopic;
+    LoopbackReaderPtr mReader;
+};
+
+template<typename MSG>
+using LoopbackChannelPtr = std::shared_ptr<LoopbackChannel<MSG>>;
+
+
+/*
+ * @brief: ChannelLoopback
+ *
+ * In-process transport behind ChannelPublisher and ChannelSubscriber, turned
+ * on by ChannelFactory::InitLoopback. Topics are matched by name and the
+ * message type must agree, as it would have to on DDS.
+ *
+ * Handlers run synchronously inside Write, also for subscribers created with
+ * a queue length, which keeps a controller and a simulated robot in one
+ * process deterministic.
+ *
+ * The channel of a ChannelPublisher or ChannelSubscriber is kept here,
+ * keyed by the object that opened it, so that those templates keep the
+ * layout libunitree_sdk2 was built with. Instantiations the library
+ * already contains (e.g. ChannelSubscriber<ConfigChangeStatus_>) may be
+ * taken from it at link time and then always use DDS.
+ */
+class ChannelLoopback
+{
+public:
+    static ChannelLoopback* Instance()
+    {
+        static ChannelLoopback inst;
+        return &inst;
+    }
+
+    void Enable()
+    {
+        mEnabled = true;
+    }
+
+    bool IsEnabled() const
+    {
+        return mEnabled;
+    }
+
+    template<typename MSG>
+    LoopbackChannelPtr<MSG> CreateSendChannel(const std::string& name)
+    {
+        return LoopbackChannelPtr<MSG>(new LoopbackChannel<MSG>(GetTopic(name, typeid(MSG))));
+    }
+
+    template<typename MSG>
+    LoopbackChannelPtr<MSG> CreateRecvChannel(const std::string& name, const std::function<void(const void*)>& callback)
+    {
+        LoopbackChannelPtr<MSG> channelPtr(new LoopbackChannel<MSG>(GetTopic(name, typeid(MSG))));
+        channelPtr->SetReader(callback);
+        return channelPtr;
+    }
+
+    template<typename MSG>
+    void Attach(const void* owner, const LoopbackChannelPtr<MSG>& channelPtr)
+    {
+        std::shared_ptr<void> prev;
+        {
+            common::LockGuard<common::Mutex> guard(mMutex);
+            std::shared_ptr<void>& entry = mChannels[owner];
+            prev.swap(entry);
+            entry = channelPtr;
+        }
+    }
+
+    template<typename MSG>
+    LoopbackChannelPtr<MSG> Find(const void* owner)
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+
+        auto iter = mChannels.find(owner);
+        if (iter == mChannels.end())
+        {
+            return LoopbackChannelPtr<MSG>();
+        }
+
+        return std::static_pointer_cast<LoopbackChannel<MSG>>(iter->second);
+    }
+
+    /*
+     * @brief the channel is released outside the lock, closing a reader
+     *        waits for its handlers.
+     */
+    void Detach(const void* owner)
+    {
+        std::shared_ptr<void> channelPtr;
+        {
+            common::LockGuard<common::Mutex> guard(mMutex);
+
+            auto iter = mChannels.find(owner);
+            if (iter == mChannels.end())
+            {
+                return;
+            }
+
+            channelPtr.swap(iter->second);
+            mChannels.erase(iter);
+        }
+    }
+
+private:
+    ChannelLoopback() :
+        mEnabled(false)
+    {}
+
+    LoopbackTopicPtr GetTopic(const std::string& name, const std::type_info& type)
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+
+        LoopbackTopicPtr& topic = mTopics[name];
+        if (!topic)
+        {
+            topic.reset(new LoopbackTopic(type));
+        }
+        else if (topic->GetType() != type)
+        {
+            UT_THROW(common::CommonException, "loopback channel type mismatch: " + name);
+        }
+
+        return topic;
+    }
+
+private:
+    std::atomic<bool> mEnabled;
+    common::Mutex mMutex;
+    std::map<std::string, LoopbackTopicPtr> mTopics;
+    std::map<const void*, std::shared_ptr<void>> mChannels;
+};
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_CHANNEL_LOOPBACK_HPP__
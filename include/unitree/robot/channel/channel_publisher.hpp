@@ -15,9 +15,25 @@ public:
         mChannelName(channelName)
     {}
 
+    ~ChannelPublisher()
+    {
+        if (ChannelLoopback::Instance()->IsEnabled())
+        {
+            ChannelLoopback::Instance()->Detach(this);
+        }
+    }
+
     void InitChannel()
     {
-        mChannelPtr = ChannelFactory::Instance()->CreateSendChannel<MSG>(mChannelName);
+        if (ChannelLoopback::Instance()->IsEnabled())
+        {
+            ChannelLoopback::Instance()->Attach<MSG>(this,
+                ChannelLoopback::Instance()->CreateSendChannel<MSG>(mChannelName));
+        }
+        else
+        {
+            mChannelPtr = ChannelFactory::Instance()->CreateSendChannel<MSG>(mChannelName);
+        }
     }
 
     bool Write(const MSG& msg, int64_t waitMicrosec = 0)
@@ -26,6 +42,14 @@ public:
         {
             return mChannelPtr->Write(msg, waitMicrosec);
         }
+        else if (ChannelLoopback::Instance()->IsEnabled())
+        {
+            LoopbackChannelPtr<MSG> loopbackPtr = ChannelLoopback::Instance()->Find<MSG>(this);
+            if (loopbackPtr)
+            {
+                return loopbackPtr->Write(msg, waitMicrosec);
+            }
+        }
 
         return false;
     }
@@ -33,6 +57,10 @@ public:
     void CloseChannel()
     {
         mChannelPtr.reset();
+        if (ChannelLoopback::Instance()->IsEnabled())
+        {
+            ChannelLoopback::Instance()->Detach(this);
+        }
     }
 
     const std::string& GetChannelName() const
@@ -19,6 +19,14 @@ public:
         mChannelName(channelName), mQueueLen(queuelen), mHandler(handler)
     {}
 
+    ~ChannelSubscriber()
+    {
+        if (ChannelLoopback::Instance()->IsEnabled())
+        {
+            ChannelLoopback::Instance()->Detach(this);
+        }
+    }
+
     void InitChannel(const std::function<void(const void*)>& handler, int64_t queuelen = 0)
     {
         mHandler = handler;
@@ -29,19 +37,29 @@ public:
 
     void InitChannel()
     {
-        if (mHandler)
+        if (!mHandler)
         {
-            mChannelPtr = ChannelFactory::Instance()->CreateRecvChannel<MSG>(mChannelName, mHandler, mQueueLen);
+            UT_THROW(common::CommonException, "subscribe handler is invalid");
+        }
+
+        if (ChannelLoopback::Instance()->IsEnabled())
+        {
+            ChannelLoopback::Instance()->Attach<MSG>(this,
+                ChannelLoopback::Instance()->CreateRecvChannel<MSG>(mChannelName, mHandler));
         }
         else
         {
-            UT_THROW(common::CommonException, "subscribe handler is invalid");
+            mChannelPtr = ChannelFactory::Instance()->CreateRecvChannel<MSG>(mChannelName, mHandler, mQueueLen);
         }
     }
 
     void CloseChannel()
     {
         mChannelPtr.reset();
+        if (ChannelLoopback::Instance()->IsEnabled())
+        {
+            ChannelLoopback::Instance()->Detach(this);
+        }
     }
 
     int64_t GetLastDataAvailableTime() const
@@ -50,6 +68,14 @@ public:
         {
             return mChannelPtr->GetLastDataAvailableTime();
         }
+        else if (ChannelLoopback::Instance()->IsEnabled())
+        {
+            LoopbackChannelPtr<MSG> loopbackPtr = ChannelLoopback::Instance()->Find<MSG>(this);
+            if (loopbackPtr)
+            {
+                return loopbackPtr->GetLastDataAvailableTime();
+            }
+        }
 
         return -1;
     }
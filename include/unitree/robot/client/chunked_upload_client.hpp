@@ -0,0 +1,337 @@
+#ifndef __UT_ROBOT_SDK_CHUNKED_UPLOAD_CLIENT_HPP__
+#define __UT_ROBOT_SDK_CHUNKED_UPLOAD_CLIENT_HPP__
+
+#include <unitree/robot/client/client_base.hpp>
+#include <unitree/common/time/time_tool.hpp>
+
+#include <atomic>
+#include <deque>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief
+ * @class: ChunkedUploadClient
+ *
+ * Uploads a large binary payload to one api of a service as a sequence of
+ * chunks instead of a single Request. Up to window chunks are in flight;
+ * each response acknowledges the contiguous byte count the server has
+ * committed, and the client goes back to that offset on a gap or timeout.
+ * Progress survives a failed Upload: calling Upload again with the same
+ * stream id and resume set queries the server and continues from there.
+ *
+ * Chunks are slices of the caller buffer; each is copied exactly once, into
+ * the reused Request binary right before it is written.
+ */
+class ChunkedUploadClient
+{
+public:
+    explicit ChunkedUploadClient(const std::string& name, int32_t apiId) :
+        mName(name), mApiId(apiId), mLeaseId(0), mTimeout(ROBOT_CLIENT_TIMEOUT),
+        mChunkSize(ROBOT_UPLOAD_CHUNK_SIZE), mWindow(ROBOT_UPLOAD_WINDOW), mMaxRetry(3),
+        mCommitted(0), mRetryCount(0)
+    {}
+
+    ~ChunkedUploadClient()
+    {}
+
+    void Init()
+    {
+        mClientStubPtr = ClientStubPtr(new ClientStub());
+        mClientStubPtr->Init(mName);
+    }
+
+    void SetTimeout(int64_t timeout)
+    {
+        mTimeout = timeout;
+    }
+
+    void SetTimeout(float timeout)
+    {
+        mTimeout = (int64_t)(timeout * 1000000);
+    }
+
+    void SetChunkSize(uint32_t chunkSize)
+    {
+        mChunkSize = chunkSize > 0 ? chunkSize : ROBOT_UPLOAD_CHUNK_SIZE;
+    }
+
+    void SetWindow(uint32_t window)
+    {
+        mWindow = window > 0 ? window : 1;
+    }
+
+    void SetMaxRetry(uint32_t maxRetry)
+    {
+        mMaxRetry = maxRetry;
+    }
+
+    void SetLeaseId(int64_t leaseId)
+    {
+        mLeaseId = leaseId;
+    }
+
+    /*
+     * @brief upload size bytes as stream streamId. parameter is passed through
+     *        to the server handler with the completed payload.
+     * @param resume: continue from the offset the server has committed.
+     * @return UT_ROBOT_OK, or the first error. data is the handler output.
+     */
+    int32_t Upload(const std::string& streamId, const std::string& parameter, const uint8_t* buffer,
+        size_t size, std::string& data, bool resume = false)
+    {
+        if (!mClientStubPtr)
+        {
+            return UT_ROBOT_ERR_CLIENT_SEND;
+        }
+
+        mParameter.streamId = streamId;
+        mParameter.total = size;
+        mParameter.parameter = parameter;
+        mCommitted = 0;
+        mRetryCount = 0;
+
+        if (resume)
+        {
+            UploadChunkData ack;
+            int32_t ret = Query(ack);
+            if (ret != UT_ROBOT_OK)
+            {
+                return ret;
+            }
+            if (ack.complete)
+            {
+                mCommitted = size;
+                data = ack.data;
+                return UT_ROBOT_OK;
+            }
+            mCommitted = std::min<uint64_t>(ack.committed, size);
+        }
+
+        std::deque<InFlight> inflight;
+        uint64_t next = mCommitted;
+        uint32_t retry = 0;
+
+        while (true)
+        {
+            /*
+             * fill the window. the last chunk is sent even for an empty payload
+             * so the server sees completion.
+             */
+            while (inflight.size() < mWindow && (next < size || (size == 0 && inflight.empty())))
+            {
+                size_t n = std::min<uint64_t>(mChunkSize, size - next);
+                RequestFuturePtr futurePtr = SendChunk(next, buffer + next, n);
+                if (!futurePtr)
+                {
+                    Discard(inflight);
+                    return UT_ROBOT_ERR_CLIENT_SEND;
+                }
+
+                inflight.push_back(InFlight{futurePtr, next + n});
+                next += n;
+            }
+
+            if (inflight.empty())
+            {
+                /*
+                 * every chunk acknowledged but the server never reported completion
+                 */
+                return UT_ROBOT_ERR_CLIENT_API_DATA;
+            }
+
+            InFlight front = inflight.front();
+            inflight.pop_front();
+
+            const ResponsePtr& responsePtr = front.futurePtr->GetResponse(mTimeout);
+            UploadChunkData ack;
+            int32_t ret = ParseResponse(responsePtr, ack);
+
+            if (ret == UT_ROBOT_ERR_CLIENT_API_TIMEOUT)
+            {
+                if (++retry > mMaxRetry)
+                {
+                    Discard(inflight);
+                    return UT_ROBOT_ERR_CLIENT_UPLOAD_RETRY;
+                }
+
+                mRetryCount++;
+                Discard(inflight);
+                next = mCommitted;
+                continue;
+            }
+            else if (ret != UT_ROBOT_OK)
+            {
+                Discard(inflight);
+                return ret;
+            }
+
+            if (ack.committed > mCommitted)
+            {
+                mCommitted = std::min<uint64_t>(ack.committed, size);
+                retry = 0;
+            }
+
+            if (ack.complete)
+            {
+                Discard(inflight);
+                mCommitted = size;
+                data = ack.data;
+                return UT_ROBOT_OK;
+            }
+
+            /*
+             * the server dropped a chunk, resend from its committed offset
+             */
+            if (ack.committed < front.end)
+            {
+                if (++retry > mMaxRetry)
+                {
+                    Discard(inflight);
+                    return UT_ROBOT_ERR_CLIENT_UPLOAD_RETRY;
+                }
+
+                mRetryCount++;
+                Discard(inflight);
+                next = mCommitted;
+            }
+        }
+    }
+
+    int32_t Upload(const std::string& streamId, const std::string& parameter, const std::vector<uint8_t>& buffer,
+        std::string& data, bool resume = false)
+    {
+        return Upload(streamId, parameter, buffer.data(), buffer.size(), data, resume);
+    }
+
+    /*
+     * @brief bytes acknowledged by the server for the last Upload.
+     */
+    uint64_t GetCommitted() const
+    {
+        return mCommitted;
+    }
+
+    uint64_t GetRetryCount() const
+    {
+        return mRetryCount;
+    }
+
+private:
+    struct InFlight
+    {
+        RequestFuturePtr futurePtr;
+        uint64_t end;
+    };
+
+    int32_t Query(UploadChunkData& ack)
+    {
+        mParameter.sequence = ROBOT_UPLOAD_SEQUENCE_QUERY;
+        mParameter.offset = 0;
+
+        SetHeader();
+        mRequest.parameter(common::ToJsonString(mParameter));
+        mRequest.binary().clear();
+
+        RequestFuturePtr futurePtr = mClientStubPtr->SendRequest(mRequest, mTimeout);
+        if (!futurePtr)
+        {
+            return UT_ROBOT_ERR_CLIENT_SEND;
+        }
+
+        return ParseResponse(futurePtr->GetResponse(mTimeout), ack);
+    }
+
+    RequestFuturePtr SendChunk(uint64_t offset, const uint8_t* data, size_t size)
+    {
+        mParameter.sequence = (int64_t)(offset / mChunkSize);
+        mParameter.offset = offset;
+
+        SetHeader();
+        mRequest.parameter(common::ToJsonString(mParameter));
+        mRequest.binary().assign(data, data + size);
+
+        return mClientStubPtr->SendRequest(mRequest, mTimeout);
+    }
+
+    void SetHeader()
+    {
+        static std::atomic<int64_t> requestId(common::GetCurrentTimeNanosecond());
+
+        RequestHeader& header = mRequest.header();
+        header.identity().id(++requestId);
+        header.identity().api_id(mApiId);
+        header.lease().id(mLeaseId);
+        header.policy().priority(0);
+        header.policy().noreply(false);
+    }
+
+    int32_t ParseResponse(const ResponsePtr& responsePtr, UploadChunkData& ack)
+    {
+        if (!responsePtr)
+        {
+            return UT_ROBOT_ERR_CLIENT_API_TIMEOUT;
+        }
+
+        if (responsePtr->header().identity().api_id() != mApiId)
+        {
+            return UT_ROBOT_ERR_CLIENT_API_NOT_MATCH;
+        }
+
+        int32_t code = responsePtr->header().status().code();
+        if (code != UT_ROBOT_OK)
+        {
+            return code;
+        }
+
+        try
+        {
+            common::FromJsonString(responsePtr->data(), ack);
+        }
+        catch (const common::Exception&)
+        {
+            return UT_ROBOT_ERR_CLIENT_API_DATA;
+        }
+
+        return UT_ROBOT_OK;
+    }
+
+    /*
+     * abandon outstanding chunks, late responses are dropped by the stub.
+     * GetResponse takes a future out of the stub queue after its wait; 0
+     * would wait forever for a lost response, so wait the least possible.
+     */
+    void Discard(std::deque<InFlight>& inflight)
+    {
+        for (InFlight& f : inflight)
+        {
+            f.futurePtr->GetResponse(1);
+        }
+        inflight.clear();
+    }
+
+private:
+    std::string mName;
+    int32_t mApiId;
+    int64_t mLeaseId;
+    int64_t mTimeout;
+    uint32_t mChunkSize;
+    uint32_t mWindow;
+    uint32_t mMaxRetry;
+
+    uint64_t mCommitted;
+    uint64_t mRetryCount;
+
+    Request mRequest;
+    UploadChunkParameter mParameter;
+    ClientStubPtr mClientStubPtr;
+};
+
+using ChunkedUploadClientPtr = std::shared_ptr<ChunkedUploadClient>;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_CHUNKED_UPLOAD_CLIENT_HPP__
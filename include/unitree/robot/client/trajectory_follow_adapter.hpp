@@ -0,0 +1,322 @@
+#ifndef __UT_ROBOT_SDK_TRAJECTORY_FOLLOW_ADAPTER_HPP__
+#define __UT_ROBOT_SDK_TRAJECTORY_FOLLOW_ADAPTER_HPP__
+
+#include <unitree/robot/client/client.hpp>
+#include <unitree/common/exception.hpp>
+#include <unitree/common/thread/recurrent_thread.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <unitree/common/lock/lock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * most points TrajectoryFollow accepts in one call.
+ */
+const uint32_t UT_TRAJECTORY_FOLLOW_MAX_POINT = 30;
+
+/*
+ * TrajectoryFollowParam
+ */
+struct TrajectoryFollowParam
+{
+    /*
+     * horizon layout, 1..UT_TRAJECTORY_FOLLOW_MAX_POINT points.
+     */
+    uint32_t pointNumber = 30;
+    float pointInterval = 0.06f;
+
+    /*
+     * minimum time between two horizon checks, about the rate the sport
+     * service replans at. Updates in between return without generating.
+     */
+    double sendInterval = 0.05;
+
+    /*
+     * an unchanged horizon is resent after keepAlive so the service never
+     * runs past its end. Must stay below pointNumber * pointInterval.
+     */
+    double keepAlive = 0.5;
+
+    /*
+     * a new horizon is unchanged when every point is within these bounds of
+     * the last sent horizon at the same absolute time.
+     */
+    float positionTolerance = 0.01f;
+    float yawTolerance = 0.02f;
+    float velocityTolerance = 0.02f;
+
+    int32_t cpuId = UT_CPU_ID_NONE;
+};
+
+/*
+ * TrajectoryFollowAdapter
+ *
+ * Rate adapter between a path source running at control rate and
+ * SportClient::TrajectoryFollow, for any sport client taking
+ * std::vector<PathPoint>& (e.g. b2::SportClient). The horizon is generated
+ * in place into a preallocated buffer only on check ticks, compared with
+ * the horizon the service already holds (shifted by the elapsed time), and
+ * sent only when it differs or the keep-alive expires. A failed call is
+ * retried on the next check tick, never sooner. Update can be called at any
+ * rate from the control loop, or Start runs it on a thread of its own so the
+ * blocking RPC never stalls the caller. While one Update is in the RPC,
+ * Update from other threads returns false and SetPathFunction and Reset do
+ * not wait for it.
+ */
+template<typename SportClient, typename PathPoint>
+class TrajectoryFollowAdapter
+{
+public:
+    /*
+     * @brief fill the path state at absolute time (seconds, caller's clock).
+     *        timeFromStart is set by the adapter.
+     */
+    using PathFunction = std::function<void(double time, PathPoint& point)>;
+
+    TrajectoryFollowAdapter(SportClient& client, const TrajectoryFollowParam& param = TrajectoryFollowParam()) :
+        mClient(client), mParam(param), mLastCheckTime(-param.sendInterval), mLastSendTime(0.0), mSent(false),
+        mBusy(false), mReset(false), mQuit(false), mSendNumber(0), mSkipNumber(0), mLastCode(UT_ROBOT_OK)
+    {
+        if (mParam.pointNumber == 0 || mParam.pointNumber > UT_TRAJECTORY_FOLLOW_MAX_POINT)
+        {
+            UT_THROW(common::CommonException, "trajectory follow point number out of range: " +
+                std::to_string(mParam.pointNumber));
+        }
+
+        mPath.resize(mParam.pointNumber);
+        mSentPath.resize(mParam.pointNumber);
+    }
+
+    ~TrajectoryFollowAdapter()
+    {
+        Stop();
+    }
+
+    void SetPathFunction(const PathFunction& function)
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+        mFunction = function;
+    }
+
+    /*
+     * @brief run Update every sendInterval on the monotonic clock.
+     */
+    void Start()
+    {
+        if (!mThreadPtr)
+        {
+            mQuit = false;
+            mThreadPtr = common::CreateRecurrentThreadEx("trajfollow", mParam.cpuId,
+                (uint64_t)(mParam.sendInterval * 1e6), &TrajectoryFollowAdapter::ThreadFunc, this);
+        }
+    }
+
+    /*
+     * @brief wait for a running Update, RPC included, to return.
+     */
+    void Stop()
+    {
+        if (mThreadPtr)
+        {
+            mQuit = true;
+            mThreadPtr->Wait();
+            mThreadPtr.reset();
+        }
+    }
+
+    /*
+     * @brief forget the sent horizon, the next check tick always sends.
+     */
+    void Reset()
+    {
+        mReset = true;
+    }
+
+    /*
+     * @brief generate and send the horizon starting at now if due.
+     * @return true if TrajectoryFollow was called.
+     */
+    bool Update(double now)
+    {
+        if (mBusy.exchange(true))
+        {
+            return false;
+        }
+
+        const bool called = UpdateHorizon(now);
+        mBusy = false;
+
+        return called;
+    }
+
+    uint64_t GetSendNumber() const
+    {
+        return mSendNumber;
+    }
+
+    /*
+     * @brief horizons generated on a send tick but found unchanged.
+     */
+    uint64_t GetSkipNumber() const
+    {
+        return mSkipNumber;
+    }
+
+    int32_t GetLastCode() const
+    {
+        return mLastCode;
+    }
+
+private:
+    void ThreadFunc()
+    {
+        if (mQuit)
+        {
+            return;
+        }
+
+        Update(common::GetCurrentMonotonicTimeNanosecond() * 1e-9);
+    }
+
+    /*
+     * @brief body of Update, one caller at a time. mMutex only guards
+     *        mFunction, the horizons belong to the caller.
+     */
+    bool UpdateHorizon(double now)
+    {
+        if (now - mLastCheckTime < mParam.sendInterval)
+        {
+            return false;
+        }
+
+        PathFunction function;
+        {
+            common::LockGuard<common::Mutex> guard(mMutex);
+            function = mFunction;
+        }
+
+        if (!function)
+        {
+            return false;
+        }
+        mLastCheckTime = now;
+
+        if (mReset.exchange(false))
+        {
+            mSent = false;
+        }
+
+        for (uint32_t i = 0; i < mParam.pointNumber; i++)
+        {
+            const float offset = i * mParam.pointInterval;
+            function(now + offset, mPath[i]);
+            mPath[i].timeFromStart = offset;
+        }
+
+        if (mSent && now - mLastSendTime < mParam.keepAlive && !Changed(now - mLastSendTime))
+        {
+            mSkipNumber++;
+            return false;
+        }
+
+        mLastCode = mClient.TrajectoryFollow(mPath);
+        mSendNumber++;
+
+        if (mLastCode == UT_ROBOT_OK)
+        {
+            mPath.swap(mSentPath);
+            mLastSendTime = now;
+            mSent = true;
+        }
+        else
+        {
+            mSent = false;
+        }
+
+        return true;
+    }
+
+    /*
+     * @brief compare mPath with the sent horizon elapsed seconds later.
+     *        points past the end of the sent horizon are not compared, the
+     *        keep-alive extends the horizon before the service runs out.
+     *        a single point horizon can not be interpolated and always differs.
+     */
+    bool Changed(double elapsed) const
+    {
+        const uint32_t n = mParam.pointNumber;
+        if (n < 2)
+        {
+            return true;
+        }
+        const float end = mSentPath[n - 1].timeFromStart;
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            const float t = (float)(mPath[i].timeFromStart + elapsed);
+            if (t > end)
+            {
+                break;
+            }
+
+            const uint32_t k = std::min(n - 2, (uint32_t)(t / mParam.pointInterval));
+            const PathPoint& a = mSentPath[k];
+            const PathPoint& b = mSentPath[k + 1];
+            const float s = (t - a.timeFromStart) / (b.timeFromStart - a.timeFromStart);
+            const PathPoint& p = mPath[i];
+
+            if (std::fabs(a.x + (b.x - a.x) * s - p.x) > mParam.positionTolerance ||
+                std::fabs(a.y + (b.y - a.y) * s - p.y) > mParam.positionTolerance ||
+                std::fabs(WrapAngle(a.yaw + WrapAngle(b.yaw - a.yaw) * s - p.yaw)) > mParam.yawTolerance ||
+                std::fabs(a.vx + (b.vx - a.vx) * s - p.vx) > mParam.velocityTolerance ||
+                std::fabs(a.vy + (b.vy - a.vy) * s - p.vy) > mParam.velocityTolerance ||
+                std::fabs(a.vyaw + (b.vyaw - a.vyaw) * s - p.vyaw) > mParam.velocityTolerance)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /*
+     * @brief angle difference to [-pi, pi], yaw may wrap between points.
+     */
+    static float WrapAngle(float angle)
+    {
+        return std::remainder(angle, 2.0f * (float)M_PI);
+    }
+
+private:
+    SportClient& mClient;
+    TrajectoryFollowParam mParam;
+
+    common::Mutex mMutex;
+    PathFunction mFunction;
+    std::vector<PathPoint> mPath;
+    std::vector<PathPoint> mSentPath;
+    double mLastCheckTime;
+    double mLastSendTime;
+    bool mSent;
+
+    std::atomic<bool> mBusy;
+    std::atomic<bool> mReset;
+    std::atomic<bool> mQuit;
+
+    std::atomic<uint64_t> mSendNumber;
+    std::atomic<uint64_t> mSkipNumber;
+    std::atomic<int32_t> mLastCode;
+
+    common::ThreadPtr mThreadPtr;
+};
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_TRAJECTORY_FOLLOW_ADAPTER_HPP__
@@ -0,0 +1,415 @@
+#ifndef __UT_ROBOT_CONTROL_LOOP_HPP__
+#define __UT_ROBOT_CONTROL_LOOP_HPP__
+
+#include <unitree/common/crc.hpp>
+#include <unitree/common/lock/triple_buffer.hpp>
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/time/deadline_timer.hpp>
+#include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/idl/go2/LowCmd_.hpp>
+#include <unitree/idl/go2/LowState_.hpp>
+#include <unitree/idl/hg/LowCmd_.hpp>
+#include <unitree/idl/hg/LowState_.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+const std::string UT_CONTROL_LOWCMD_TOPIC = "rt/lowcmd";
+const std::string UT_CONTROL_LOWSTATE_TOPIC = "rt/lowstate";
+
+/*
+ * servo mode of MotorCmd_::mode, both message families.
+ */
+const uint8_t UT_CONTROL_MOTOR_MODE_SERVO = 0x01;
+
+/*
+ * @brief message family specific LowCmd_ header, filled once before the
+ *        first tick. overloads are picked by the policy's message types.
+ */
+inline void InitLowCmd(unitree_go::msg::dds_::LowCmd_& cmd, const unitree_go::msg::dds_::LowState_&)
+{
+    cmd.head()[0] = 0xFE;
+    cmd.head()[1] = 0xEF;
+    cmd.level_flag(0xFF);
+    cmd.gpio(0);
+    for (auto& motor : cmd.motor_cmd())
+    {
+        motor.mode(UT_CONTROL_MOTOR_MODE_SERVO);
+    }
+}
+
+inline void InitLowCmd(unitree_hg::msg::dds_::LowCmd_& cmd, const unitree_hg::msg::dds_::LowState_& state)
+{
+    cmd.mode_pr(state.mode_pr());
+    cmd.mode_machine(state.mode_machine());
+    for (auto& motor : cmd.motor_cmd())
+    {
+        motor.mode(UT_CONTROL_MOTOR_MODE_SERVO);
+    }
+}
+
+/*
+ * ControlLoopParam
+ */
+struct ControlLoopParam
+{
+    std::string stateTopic = UT_CONTROL_LOWSTATE_TOPIC;
+    std::string cmdTopic = UT_CONTROL_LOWCMD_TOPIC;
+
+    double frequency = 500.0;
+    int32_t cpuId = UT_CPU_ID_NONE;
+
+    /*
+     * ticks without a new LowState_ before the loop trips with
+     * TERMINATION_STATE_TIMEOUT: the loop keeps running and publishing, the
+     * policy is no longer stepped and every joint is held in damping until
+     * Resume. 0 disables the check.
+     */
+    uint32_t stateTimeoutTick = 50;
+
+    /*
+     * kd applied to every joint after a termination trips.
+     */
+    float dampingKd = 2.0f;
+};
+
+/*
+ * ControlLoopStats
+ *
+ * Times in nanoseconds. lateness is wakeup time minus deadline, compute is
+ * state pickup to publish.
+ */
+struct ControlLoopStats
+{
+    uint64_t tickNumber = 0;
+    uint64_t overrunNumber = 0;
+    uint64_t staleNumber = 0;
+    int64_t maxLateness = 0;
+    int64_t meanLateness = 0;
+    int64_t maxCompute = 0;
+    int64_t meanCompute = 0;
+};
+
+/*
+ * ControlLoop
+ *
+ * Fixed rate low level control on its own thread. The LowState_ handler
+ * copies each message into a triple buffer, the loop picks up the newest one
+ * at every deadline without locking, runs the policy, checks terminations,
+ * stamps the crc and publishes LowCmd_ from the same thread. Once a
+ * termination trips (or state stops arriving) the policy is no longer called
+ * and every joint is held in damping until Resume.
+ *
+ * Policy provides the message family and two calls:
+ *
+ *     struct MyPolicy
+ *     {
+ *         using LowState = unitree_go::msg::dds_::LowState_;
+ *         using LowCmd = unitree_go::msg::dds_::LowCmd_;
+ *
+ *         // first tick with valid state, or after Resume
+ *         void Start(const LowState& state, LowCmd& cmd);
+ *         // every tick, time in seconds since Start
+ *         void Step(const LowState& state, LowCmd& cmd, double time);
+ *     };
+ */
+template<typename Policy>
+class ControlLoop
+{
+public:
+    using LowState = typename Policy::LowState;
+    using LowCmd = typename Policy::LowCmd;
+
+    /*
+     * @brief checked after every Step. true stops calling the policy, the
+     *        loop keeps publishing with every joint held in damping until Resume.
+     */
+    using Termination = std::function<bool(const LowState& state, const LowCmd& cmd)>;
+
+    /*
+     * termination index reported for a LowState_ timeout.
+     */
+    static const int32_t TERMINATION_STATE_TIMEOUT = -2;
+    static const int32_t TERMINATION_NONE = -1;
+
+    explicit ControlLoop(Policy& policy, const ControlLoopParam& param = ControlLoopParam()) :
+        mPolicy(policy), mParam(param), mPeriod((int64_t)(1e9 / param.frequency)),
+        mQuit(false), mTripped(TERMINATION_NONE), mResume(false)
+    {
+        ResetStats();
+    }
+
+    ~ControlLoop()
+    {
+        Stop();
+    }
+
+    /*
+     * @brief add a named termination check, before Start.
+     */
+    void AddTermination(const std::string& name, const Termination& termination)
+    {
+        mTerminationName.push_back(name);
+        mTermination.push_back(termination);
+    }
+
+    /*
+     * @brief subscribe LowState_, otherwise states come from SetState.
+     */
+    void InitChannel()
+    {
+        mSubscriberPtr.reset(new ChannelSubscriber<LowState>(mParam.stateTopic));
+        mSubscriberPtr->InitChannel(std::bind(&ControlLoop::LowStateHandler, this, std::placeholders::_1), 1);
+    }
+
+    void Start()
+    {
+        if (mThreadPtr)
+        {
+            return;
+        }
+
+        if (!mPublisherPtr)
+        {
+            mPublisherPtr.reset(new ChannelPublisher<LowCmd>(mParam.cmdTopic));
+            mPublisherPtr->InitChannel();
+        }
+
+        mQuit = false;
+        mThreadPtr = common::CreateThreadEx("ctrlloop", mParam.cpuId, &ControlLoop::LoopThreadFunc, this);
+    }
+
+    void Stop()
+    {
+        if (mSubscriberPtr)
+        {
+            mSubscriberPtr->CloseChannel();
+            mSubscriberPtr.reset();
+        }
+
+        if (mThreadPtr)
+        {
+            mQuit = true;
+            mThreadPtr->Wait();
+            mThreadPtr.reset();
+        }
+    }
+
+    /*
+     * @brief hand a state to the loop, e.g. from another transport.
+     *        single writer: either this or InitChannel.
+     */
+    void SetState(const LowState& state)
+    {
+        mState.Write(state);
+    }
+
+    /*
+     * @brief leave damping and restart the policy on the next tick.
+     */
+    void Resume()
+    {
+        mResume = true;
+    }
+
+    bool IsStopped() const
+    {
+        return mTripped != TERMINATION_NONE;
+    }
+
+    /*
+     * @brief index of the tripped termination in AddTermination order,
+     *        TERMINATION_STATE_TIMEOUT or TERMINATION_NONE.
+     */
+    int32_t GetTripped() const
+    {
+        return mTripped;
+    }
+
+    std::string GetTrippedName() const
+    {
+        const int32_t tripped = mTripped;
+        if (tripped >= 0)
+        {
+            return mTerminationName[tripped];
+        }
+        return tripped == TERMINATION_STATE_TIMEOUT ? "state timeout" : "";
+    }
+
+    ControlLoopStats GetStats() const
+    {
+        ControlLoopStats stats;
+        stats.tickNumber = mTickNumber;
+        stats.overrunNumber = mOverrunNumber;
+        stats.staleNumber = mStaleNumber;
+        stats.maxLateness = mMaxLateness;
+        stats.maxCompute = mMaxCompute;
+        if (stats.tickNumber > 0)
+        {
+            stats.meanLateness = mSumLateness / (int64_t)stats.tickNumber;
+            stats.meanCompute = mSumCompute / (int64_t)stats.tickNumber;
+        }
+        return stats;
+    }
+
+    void ResetStats()
+    {
+        mTickNumber = 0;
+        mOverrunNumber = 0;
+        mStaleNumber = 0;
+        mMaxLateness = 0;
+        mSumLateness = 0;
+        mMaxCompute = 0;
+        mSumCompute = 0;
+    }
+
+private:
+    void LowStateHandler(const void* message)
+    {
+        mState.Write(*(const LowState*)message);
+    }
+
+    int32_t LoopThreadFunc()
+    {
+        common::DeadlineTimer timer(mPeriod);
+        timer.Start();
+
+        bool received = false;
+        bool started = false;
+        uint32_t staleTick = 0;
+        uint64_t overrun = 0;
+        int64_t startTime = 0;
+
+        while (!mQuit)
+        {
+            const int64_t lateness = timer.Wait();
+
+            if (mState.Update())
+            {
+                received = true;
+                staleTick = 0;
+            }
+            else if (received)
+            {
+                staleTick++;
+                mStaleNumber++;
+            }
+
+            if (!received)
+            {
+                continue;
+            }
+
+            const LowState& state = mState.GetReadBuffer();
+
+            if (!started)
+            {
+                InitLowCmd(mCmd, state);
+                started = true;
+                mResume = true;
+            }
+
+            if (mResume.exchange(false))
+            {
+                mTripped = TERMINATION_NONE;
+                startTime = timer.GetWakeTime();
+                mPolicy.Start(state, mCmd);
+            }
+
+            if (mTripped == TERMINATION_NONE && mParam.stateTimeoutTick > 0 && staleTick >= mParam.stateTimeoutTick)
+            {
+                mTripped = TERMINATION_STATE_TIMEOUT;
+            }
+
+            if (mTripped == TERMINATION_NONE)
+            {
+                mPolicy.Step(state, mCmd, (timer.GetWakeTime() - startTime) * 1e-9);
+                mTripped = CheckTermination(state);
+            }
+
+            if (mTripped != TERMINATION_NONE)
+            {
+                Damping(state);
+            }
+
+            mCmd.crc(common::Crc32Message(mCmd));
+            mPublisherPtr->Write(mCmd);
+
+            const int64_t compute = common::DeadlineTimer::GetClock() - timer.GetWakeTime();
+            if (lateness > mMaxLateness)
+            {
+                mMaxLateness = lateness;
+            }
+            if (compute > mMaxCompute)
+            {
+                mMaxCompute = compute;
+            }
+            mSumLateness += lateness;
+            mSumCompute += compute;
+            mOverrunNumber += timer.GetOverrunNumber() - overrun;
+            overrun = timer.GetOverrunNumber();
+            mTickNumber++;
+        }
+
+        return 0;
+    }
+
+    int32_t CheckTermination(const LowState& state) const
+    {
+        for (size_t i = 0; i < mTermination.size(); i++)
+        {
+            if (mTermination[i](state, mCmd))
+            {
+                return (int32_t)i;
+            }
+        }
+        return TERMINATION_NONE;
+    }
+
+    void Damping(const LowState& state)
+    {
+        auto& motor = mCmd.motor_cmd();
+        const auto& motorState = state.motor_state();
+        for (size_t i = 0; i < motor.size() && i < motorState.size(); i++)
+        {
+            motor[i].q(motorState[i].q());
+            motor[i].dq(0.0f);
+            motor[i].kp(0.0f);
+            motor[i].kd(mParam.dampingKd);
+            motor[i].tau(0.0f);
+        }
+    }
+
+private:
+    Policy& mPolicy;
+    ControlLoopParam mParam;
+    int64_t mPeriod;
+
+    std::vector<std::string> mTerminationName;
+    std::vector<Termination> mTermination;
+
+    common::TripleBuffer<LowState> mState;
+    LowCmd mCmd;
+
+    std::shared_ptr<ChannelPublisher<LowCmd>> mPublisherPtr;
+    std::shared_ptr<ChannelSubscriber<LowState>> mSubscriberPtr;
+    common::ThreadPtr mThreadPtr;
+    std::atomic<bool> mQuit;
+    std::atomic<int32_t> mTripped;
+    std::atomic<bool> mResume;
+
+    std::atomic<uint64_t> mTickNumber;
+    std::atomic<uint64_t> mOverrunNumber;
+    std::atomic<uint64_t> mStaleNumber;
+    std::atomic<int64_t> mMaxLateness;
+    std::atomic<int64_t> mSumLateness;
+    std::atomic<int64_t> mMaxCompute;
+    std::atomic<int64_t> mSumCompute;
+};
+
+}
+}
+
+#endif//__UT_ROBOT_CONTROL_LOOP_HPP__
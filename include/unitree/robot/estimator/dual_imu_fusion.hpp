@@ -0,0 +1,456 @@
+#ifndef __UT_ROBOT_ESTIMATOR_DUAL_IMU_FUSION_HPP__
+#define __UT_ROBOT_ESTIMATOR_DUAL_IMU_FUSION_HPP__
+
+#include <unitree/common/lock/triple_buffer.hpp>
+#include <unitree/common/time/deadline_timer.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/robot/estimator/imu_preintegrator.hpp>
+#include <unitree/robot/model/g1_model.hpp>
+#include <unitree/idl/hg/IMUState_.hpp>
+#include <unitree/idl/hg/LowState_.hpp>
+#include <unitree/idl/hg_doubleimu/doubleIMUState_.hpp>
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <type_traits>
+
+namespace unitree
+{
+namespace robot
+{
+namespace estimator
+{
+const std::string UT_DUAL_IMU_PRIMARY_TOPIC = "rt/lowstate";
+const std::string UT_DUAL_IMU_SECONDARY_TOPIC = "rt/secondary_imu";
+
+/*
+ * true for imu messages with a tick() in the LowState_ tick clock, e.g.
+ * doubleIMUState_. IMUState_ on rt/secondary_imu has none.
+ */
+template<typename IMU, typename = void>
+struct ImuHasTick : std::false_type
+{};
+
+template<typename IMU>
+struct ImuHasTick<IMU, decltype((void)std::declval<const IMU&>().tick())> : std::true_type
+{};
+
+/*
+ * source flags of a fused estimate.
+ */
+enum
+{
+    UT_DUAL_IMU_PRIMARY     = 0x1,
+    UT_DUAL_IMU_SECONDARY   = 0x2
+};
+
+/*
+ * DualImuFusionParam
+ */
+struct DualImuFusionParam
+{
+    std::string primaryTopic = UT_DUAL_IMU_PRIMARY_TOPIC;
+    std::string secondaryTopic = UT_DUAL_IMU_SECONDARY_TOPIC;
+
+    /*
+     * largest |tick difference| accepted when pairing the two streams, for a
+     * secondary type with a tick.
+     */
+    uint32_t maxTickGap = 5;
+
+    /*
+     * largest |arrival time difference| in ns accepted when pairing, for a
+     * secondary type without a tick.
+     */
+    int64_t maxTimeGap = 5000000;
+
+    /*
+     * weight of the secondary imu when both agree, 0..1.
+     */
+    double secondaryWeight = 0.5;
+
+    /*
+     * disagreement beyond either bound rejects one of the two samples.
+     */
+    double maxAngle = 0.2;      // rad
+    double maxGyroError = 1.0;  // rad/s
+
+    /*
+     * joints between the primary (pelvis) and secondary (torso) imu, applied
+     * as yaw (z), roll (x), pitch (y) in that order. -1 for a locked joint.
+     */
+    std::array<int32_t, 3> waistJoint = {
+        model::G1Dof29::WAIST_YAW, model::G1Dof29::WAIST_ROLL, model::G1Dof29::WAIST_PITCH
+    };
+
+    /*
+     * fixed rotation of the secondary imu in the frame after the waist joints.
+     */
+    Eigen::Quaterniond mount = Eigen::Quaterniond::Identity();
+};
+
+/*
+ * DualImuEstimate
+ *
+ * Orientation (body to world, w x y z) and body angular velocity of the
+ * primary imu frame.
+ */
+struct DualImuEstimate
+{
+    uint32_t tick = 0;
+    int64_t time = 0;
+    Eigen::Quaterniond quaternion = Eigen::Quaterniond::Identity();
+    Eigen::Vector3d gyroscope = Eigen::Vector3d::Zero();
+
+    /*
+     * UT_DUAL_IMU_PRIMARY / UT_DUAL_IMU_SECONDARY, the samples that went in.
+     */
+    uint32_t source = 0;
+    int32_t tickGap = 0;
+    int64_t timeGap = 0;
+    double angle = 0.0;
+    double gyroError = 0.0;
+};
+
+/*
+ * DualImuFusion
+ *
+ * Pairs every LowState_ with the SecondaryIMU sample closest in tick, or in
+ * arrival time when SecondaryIMU has no tick (IMUState_, the torso imu on
+ * rt/secondary_imu), brings the secondary sample into the primary frame
+ * through the waist joints of that same LowState_ and blends both. When the two disagree by
+ * more than maxAngle or maxGyroError the sample further from the prediction
+ * of the previous estimate is rejected; without a matching secondary sample
+ * the primary is used alone.
+ *
+ * The secondary handler only stores into a fixed ring, the fusion runs in
+ * the LowState_ handler on fixed size types, nothing allocates after
+ * construction. One reader takes the newest estimate with Update and
+ * GetEstimate.
+ */
+template<typename SecondaryIMU = unitree_hg::msg::dds_::IMUState_>
+class DualImuFusion
+{
+public:
+    explicit DualImuFusion(const DualImuFusionParam& param = DualImuFusionParam()) :
+        mParam(param), mSecondaryNumber(0), mHasEstimate(false),
+        mPairNumber(0), mUnpairedNumber(0), mRejectNumber(0)
+    {
+        for (auto& slot : mRing)
+        {
+            slot.seq.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~DualImuFusion()
+    {
+        CloseChannel();
+    }
+
+    void InitChannel()
+    {
+        mSecondaryPtr.reset(new ChannelSubscriber<SecondaryIMU>(mParam.secondaryTopic));
+        mSecondaryPtr->InitChannel(std::bind(&DualImuFusion::SecondaryHandler, this, std::placeholders::_1), 1);
+        mPrimaryPtr.reset(new ChannelSubscriber<unitree_hg::msg::dds_::LowState_>(mParam.primaryTopic));
+        mPrimaryPtr->InitChannel(std::bind(&DualImuFusion::PrimaryHandler, this, std::placeholders::_1), 1);
+    }
+
+    void CloseChannel()
+    {
+        if (mPrimaryPtr)
+        {
+            mPrimaryPtr->CloseChannel();
+            mPrimaryPtr.reset();
+        }
+        if (mSecondaryPtr)
+        {
+            mSecondaryPtr->CloseChannel();
+            mSecondaryPtr.reset();
+        }
+    }
+
+    /*
+     * @brief handlers for ChannelSubscriber::InitChannel, or call them from
+     *        existing handlers.
+     */
+    void SecondaryHandler(const void* message)
+    {
+        AddSecondary(*(const SecondaryIMU*)message, common::DeadlineTimer::GetClock());
+    }
+
+    void PrimaryHandler(const void* message)
+    {
+        AddPrimary(*(const unitree_hg::msg::dds_::LowState_*)message, common::DeadlineTimer::GetClock());
+    }
+
+    /*
+     * @brief store one secondary sample received at time (DeadlineTimer
+     *        clock, ns). Single writer.
+     */
+    void AddSecondary(const SecondaryIMU& imu, int64_t time)
+    {
+        uint32_t tick = 0;
+        if constexpr (PAIR_BY_TICK)
+        {
+            tick = imu.tick();
+        }
+
+        AddSecondary(imu, tick, time);
+    }
+
+    /*
+     * @brief store a sample of any type with quaternion() and gyroscope(),
+     *        tick is only used to pair when SecondaryIMU has one.
+     */
+    template<typename IMU>
+    void AddSecondary(const IMU& imu, uint32_t tick, int64_t time)
+    {
+        const uint64_t number = mSecondaryNumber.load(std::memory_order_relaxed);
+        Slot& slot = mRing[number % UT_DUAL_IMU_RING_SIZE];
+
+        const uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+        slot.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.sample.tick = tick;
+        slot.sample.time = time;
+        const auto& q = imu.quaternion();
+        const auto& g = imu.gyroscope();
+        for (int32_t i = 0; i < 4; i++)
+        {
+            slot.sample.quaternion[i] = q[i];
+        }
+        for (int32_t i = 0; i < 3; i++)
+        {
+            slot.sample.gyroscope[i] = g[i];
+        }
+
+        slot.seq.store(seq + 2, std::memory_order_release);
+        mSecondaryNumber.store(number + 1, std::memory_order_release);
+    }
+
+    /*
+     * @brief fuse one LowState_ received at time with the best matching
+     *        secondary sample.
+     */
+    void AddPrimary(const unitree_hg::msg::dds_::LowState_& state, int64_t time)
+    {
+        const uint32_t tick = state.tick();
+        DualImuEstimate& estimate = mEstimate.GetWriteBuffer();
+        estimate.tick = tick;
+        estimate.time = time;
+        estimate.angle = 0.0;
+        estimate.gyroError = 0.0;
+        estimate.tickGap = 0;
+        estimate.timeGap = 0;
+
+        const Eigen::Quaterniond qp = GetImuQuaternion(state.imu_state());
+        const Eigen::Vector3d wp = GetImuGyroscope(state.imu_state());
+
+        Sample sample;
+        if (!FindSecondary(tick, time, sample))
+        {
+            mUnpairedNumber++;
+            Output(estimate, qp, wp, UT_DUAL_IMU_PRIMARY);
+            return;
+        }
+        mPairNumber++;
+
+        estimate.tickGap = PAIR_BY_TICK ? (int32_t)(sample.tick - tick) : 0;
+        estimate.timeGap = sample.time - time;
+
+        // secondary -> primary frame: q_s = q_p * q_waist * q_mount
+        Eigen::Quaterniond qw;
+        Eigen::Vector3d ww;
+        Waist(state, qw, ww);
+        const Eigen::Quaterniond rel = qw * mParam.mount;
+
+        Eigen::Quaterniond qs(sample.quaternion[0], sample.quaternion[1], sample.quaternion[2], sample.quaternion[3]);
+        const double norm = qs.norm();
+        if (!(norm > 0.5 && norm < 1.5))
+        {
+            mRejectNumber++;
+            Output(estimate, qp, wp, UT_DUAL_IMU_PRIMARY);
+            return;
+        }
+        qs.coeffs() /= norm;
+
+        const Eigen::Quaterniond qsp = qs * rel.conjugate();
+        const Eigen::Vector3d wsp = rel * Eigen::Vector3d(sample.gyroscope[0], sample.gyroscope[1], sample.gyroscope[2]) - ww;
+
+        estimate.angle = qp.angularDistance(qsp);
+        estimate.gyroError = (wp - wsp).norm();
+
+        if (estimate.angle <= mParam.maxAngle && estimate.gyroError <= mParam.maxGyroError)
+        {
+            const double w = mParam.secondaryWeight;
+            Output(estimate, qp.slerp(w, qsp), (1.0 - w) * wp + w * wsp,
+                UT_DUAL_IMU_PRIMARY | UT_DUAL_IMU_SECONDARY);
+            return;
+        }
+
+        // disagreement: keep the one closer to the previous estimate
+        mRejectNumber++;
+        if (mHasEstimate && mLast.angularDistance(qsp) + 0.1 * (mLastGyro - wsp).norm() <
+            mLast.angularDistance(qp) + 0.1 * (mLastGyro - wp).norm())
+        {
+            Output(estimate, qsp, wsp, UT_DUAL_IMU_SECONDARY);
+        }
+        else
+        {
+            Output(estimate, qp, wp, UT_DUAL_IMU_PRIMARY);
+        }
+    }
+
+    /*
+     * @brief reader side, take the newest estimate.
+     * @return true if a new estimate arrived since the previous call.
+     */
+    bool Update()
+    {
+        return mEstimate.Update();
+    }
+
+    const DualImuEstimate& GetEstimate() const
+    {
+        return mEstimate.GetReadBuffer();
+    }
+
+    /*
+     * LowState_ with a matching secondary sample / without / with one side rejected.
+     */
+    uint64_t GetPairNumber() const
+    {
+        return mPairNumber;
+    }
+
+    uint64_t GetUnpairedNumber() const
+    {
+        return mUnpairedNumber;
+    }
+
+    uint64_t GetRejectNumber() const
+    {
+        return mRejectNumber;
+    }
+
+private:
+    enum
+    {
+        UT_DUAL_IMU_RING_SIZE = 32
+    };
+
+    static constexpr bool PAIR_BY_TICK = ImuHasTick<SecondaryIMU>::value;
+
+    struct Sample
+    {
+        uint32_t tick;
+        int64_t time;
+        float quaternion[4];
+        float gyroscope[3];
+    };
+
+    struct Slot
+    {
+        std::atomic<uint32_t> seq;
+        Sample sample;
+    };
+
+    /*
+     * newest-first scan of the ring, stops once samples move away from the
+     * primary's tick, or its time for a secondary without a tick.
+     */
+    bool FindSecondary(uint32_t tick, int64_t time, Sample& best) const
+    {
+        const uint64_t number = mSecondaryNumber.load(std::memory_order_acquire);
+        const uint64_t depth = number < UT_DUAL_IMU_RING_SIZE - 1 ? number : UT_DUAL_IMU_RING_SIZE - 1;
+        bool found = false;
+        uint64_t bestDistance = PAIR_BY_TICK ? (uint64_t)mParam.maxTickGap + 1 : (uint64_t)mParam.maxTimeGap + 1;
+
+        for (uint64_t i = 1; i <= depth; i++)
+        {
+            const Slot& slot = mRing[(number - i) % UT_DUAL_IMU_RING_SIZE];
+
+            const uint32_t seq = slot.seq.load(std::memory_order_acquire);
+            Sample sample = slot.sample;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if ((seq & 1) || slot.seq.load(std::memory_order_relaxed) != seq)
+            {
+                continue;
+            }
+
+            const int64_t gap = PAIR_BY_TICK ? (int64_t)(int32_t)(sample.tick - tick) : sample.time - time;
+            const uint64_t distance = gap < 0 ? (uint64_t)-gap : (uint64_t)gap;
+            if (distance < bestDistance)
+            {
+                best = sample;
+                bestDistance = distance;
+                found = true;
+            }
+            else if (found && gap < 0)
+            {
+                break;
+            }
+        }
+
+        return found;
+    }
+
+    /*
+     * waist rotation and its angular velocity in the primary frame.
+     */
+    void Waist(const unitree_hg::msg::dds_::LowState_& state, Eigen::Quaterniond& q, Eigen::Vector3d& w) const
+    {
+        static const Eigen::Vector3d axis[3] = { Eigen::Vector3d::UnitZ(), Eigen::Vector3d::UnitX(), Eigen::Vector3d::UnitY() };
+        const auto& motor = state.motor_state();
+
+        q.setIdentity();
+        w.setZero();
+        for (int32_t i = 0; i < 3; i++)
+        {
+            const int32_t joint = mParam.waistJoint[i];
+            if (joint < 0)
+            {
+                continue;
+            }
+            w += q * (axis[i] * motor[joint].dq());
+            q = q * Eigen::Quaterniond(Eigen::AngleAxisd(motor[joint].q(), axis[i]));
+        }
+    }
+
+    void Output(DualImuEstimate& estimate, const Eigen::Quaterniond& q, const Eigen::Vector3d& w, uint32_t source)
+    {
+        estimate.quaternion = q.normalized();
+        estimate.gyroscope = w;
+        estimate.source = source;
+        mLast = estimate.quaternion;
+        mLastGyro = w;
+        mHasEstimate = true;
+        mEstimate.Publish();
+    }
+
+private:
+    DualImuFusionParam mParam;
+
+    Slot mRing[UT_DUAL_IMU_RING_SIZE];
+    std::atomic<uint64_t> mSecondaryNumber;
+
+    Eigen::Quaterniond mLast;
+    Eigen::Vector3d mLastGyro;
+    bool mHasEstimate;
+    common::TripleBuffer<DualImuEstimate> mEstimate;
+
+    std::atomic<uint64_t> mPairNumber;
+    std::atomic<uint64_t> mUnpairedNumber;
+    std::atomic<uint64_t> mRejectNumber;
+
+    std::shared_ptr<ChannelSubscriber<unitree_hg::msg::dds_::LowState_>> mPrimaryPtr;
+    std::shared_ptr<ChannelSubscriber<SecondaryIMU>> mSecondaryPtr;
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_ESTIMATOR_DUAL_IMU_FUSION_HPP__
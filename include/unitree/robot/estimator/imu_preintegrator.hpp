@@ -0,0 +1,251 @@
+#ifndef __UT_ROBOT_ESTIMATOR_IMU_PREINTEGRATOR_HPP__
+#define __UT_ROBOT_ESTIMATOR_IMU_PREINTEGRATOR_HPP__
+
+#include <eigen3/Eigen/Dense>
+
+namespace unitree
+{
+namespace robot
+{
+namespace estimator
+{
+/*
+ * standard gravity, world z up.
+ */
+const double UT_GRAVITY = 9.80665;
+
+inline Eigen::Matrix3d Skew(const Eigen::Vector3d& v)
+{
+    Eigen::Matrix3d m;
+    m << 0.0, -v.z(), v.y(),
+         v.z(), 0.0, -v.x(),
+         -v.y(), v.x(), 0.0;
+    return m;
+}
+
+/*
+ * SO(3) exponential map.
+ */
+inline Eigen::Matrix3d ExpSO3(const Eigen::Vector3d& phi)
+{
+    const double angle = phi.norm();
+    if (angle < 1e-8)
+    {
+        return Eigen::Matrix3d::Identity() + Skew(phi);
+    }
+    return Eigen::AngleAxisd(angle, phi / angle).toRotationMatrix();
+}
+
+/*
+ * SO(3) right jacobian.
+ */
+inline Eigen::Matrix3d RightJacobianSO3(const Eigen::Vector3d& phi)
+{
+    const double angle = phi.norm();
+    const Eigen::Matrix3d K = Skew(phi);
+    if (angle < 1e-6)
+    {
+        return Eigen::Matrix3d::Identity() - 0.5 * K;
+    }
+
+    const double angle2 = angle * angle;
+    return Eigen::Matrix3d::Identity() - (1.0 - std::cos(angle)) / angle2 * K
+        + (angle - std::sin(angle)) / (angle2 * angle) * K * K;
+}
+
+/*
+ * IMUState_ quaternion is w, x, y, z, body to world.
+ */
+template<typename IMU>
+inline Eigen::Quaterniond GetImuQuaternion(const IMU& imu)
+{
+    const auto& q = imu.quaternion();
+    return Eigen::Quaterniond(q[0], q[1], q[2], q[3]).normalized();
+}
+
+template<typename IMU>
+inline Eigen::Vector3d GetImuGyroscope(const IMU& imu)
+{
+    const auto& g = imu.gyroscope();
+    return Eigen::Vector3d(g[0], g[1], g[2]);
+}
+
+template<typename IMU>
+inline Eigen::Vector3d GetImuAccelerometer(const IMU& imu)
+{
+    const auto& a = imu.accelerometer();
+    return Eigen::Vector3d(a[0], a[1], a[2]);
+}
+
+/*
+ * ImuPreintegrator
+ *
+ * On-manifold IMU preintegration between two control ticks (Forster et al.).
+ * Samples are integrated into relative rotation, velocity and position
+ * increments expressed in the body frame at the start of the interval, with
+ * first order jacobians to the gyroscope and accelerometer biases so a bias
+ * update does not require reintegration. Fixed size types only, Reset and
+ * Integrate never allocate.
+ */
+class ImuPreintegrator
+{
+public:
+    ImuPreintegrator()
+    {
+        mGyroBias.setZero();
+        mAccBias.setZero();
+        Reset();
+    }
+
+    void Reset()
+    {
+        mDeltaTime = 0.0;
+        mDeltaR.setIdentity();
+        mDeltaV.setZero();
+        mDeltaP.setZero();
+        mDRdBg.setZero();
+        mDVdBa.setZero();
+        mDVdBg.setZero();
+        mDPdBa.setZero();
+        mDPdBg.setZero();
+        mSampleNumber = 0;
+    }
+
+    void SetBias(const Eigen::Vector3d& gyroBias, const Eigen::Vector3d& accBias)
+    {
+        mGyroBias = gyroBias;
+        mAccBias = accBias;
+    }
+
+    /*
+     * @brief integrate one sample held for dt seconds.
+     *        gyro in rad/s, acc is specific force in m/s^2, both in body frame.
+     */
+    void Integrate(const Eigen::Vector3d& gyro, const Eigen::Vector3d& acc, double dt)
+    {
+        if (dt <= 0.0)
+        {
+            return;
+        }
+
+        const Eigen::Vector3d w = gyro - mGyroBias;
+        const Eigen::Vector3d a = acc - mAccBias;
+        const double dt2 = dt * dt;
+
+        const Eigen::Matrix3d Ra = mDeltaR * Skew(a);
+
+        mDeltaP += mDeltaV * dt + 0.5 * mDeltaR * a * dt2;
+        mDeltaV += mDeltaR * a * dt;
+
+        mDPdBa += mDVdBa * dt - 0.5 * mDeltaR * dt2;
+        mDPdBg += mDVdBg * dt - 0.5 * Ra * mDRdBg * dt2;
+        mDVdBa -= mDeltaR * dt;
+        mDVdBg -= Ra * mDRdBg * dt;
+
+        const Eigen::Vector3d phi = w * dt;
+        const Eigen::Matrix3d dR = ExpSO3(phi);
+        mDRdBg = dR.transpose() * mDRdBg - RightJacobianSO3(phi) * dt;
+        mDeltaR = mDeltaR * dR;
+
+        /*
+         * keep the rotation orthonormal over long intervals
+         */
+        if ((++mSampleNumber & 0xff) == 0)
+        {
+            mDeltaR = Eigen::Quaterniond(mDeltaR).normalized().toRotationMatrix();
+        }
+
+        mDeltaTime += dt;
+    }
+
+    template<typename IMU>
+    void Integrate(const IMU& imu, double dt)
+    {
+        Integrate(GetImuGyroscope(imu), GetImuAccelerometer(imu), dt);
+    }
+
+    /*
+     * @brief propagate a world frame state over the integrated interval.
+     *        rotation is body to world, gravity points down world z.
+     */
+    void Predict(Eigen::Matrix3d& rotation, Eigen::Vector3d& velocity, Eigen::Vector3d& position) const
+    {
+        const Eigen::Vector3d g(0.0, 0.0, -UT_GRAVITY);
+        const double t = mDeltaTime;
+
+        position += velocity * t + 0.5 * g * t * t + rotation * mDeltaP;
+        velocity += g * t + rotation * mDeltaV;
+        rotation = rotation * mDeltaR;
+    }
+
+    /*
+     * @brief increments corrected to new biases, first order.
+     */
+    void GetCorrected(const Eigen::Vector3d& gyroBias, const Eigen::Vector3d& accBias,
+        Eigen::Matrix3d& deltaR, Eigen::Vector3d& deltaV, Eigen::Vector3d& deltaP) const
+    {
+        const Eigen::Vector3d dbg = gyroBias - mGyroBias;
+        const Eigen::Vector3d dba = accBias - mAccBias;
+
+        deltaR = mDeltaR * ExpSO3(mDRdBg * dbg);
+        deltaV = mDeltaV + mDVdBg * dbg + mDVdBa * dba;
+        deltaP = mDeltaP + mDPdBg * dbg + mDPdBa * dba;
+    }
+
+    double GetDeltaTime() const
+    {
+        return mDeltaTime;
+    }
+
+    const Eigen::Matrix3d& GetDeltaR() const
+    {
+        return mDeltaR;
+    }
+
+    const Eigen::Vector3d& GetDeltaV() const
+    {
+        return mDeltaV;
+    }
+
+    const Eigen::Vector3d& GetDeltaP() const
+    {
+        return mDeltaP;
+    }
+
+    const Eigen::Vector3d& GetGyroBias() const
+    {
+        return mGyroBias;
+    }
+
+    const Eigen::Vector3d& GetAccBias() const
+    {
+        return mAccBias;
+    }
+
+    uint32_t GetSampleNumber() const
+    {
+        return mSampleNumber;
+    }
+
+private:
+    double mDeltaTime;
+    Eigen::Matrix3d mDeltaR;
+    Eigen::Vector3d mDeltaV;
+    Eigen::Vector3d mDeltaP;
+
+    Eigen::Matrix3d mDRdBg;
+    Eigen::Matrix3d mDVdBa;
+    Eigen::Matrix3d mDVdBg;
+    Eigen::Matrix3d mDPdBa;
+    Eigen::Matrix3d mDPdBg;
+
+    Eigen::Vector3d mGyroBias;
+    Eigen::Vector3d mAccBias;
+    uint32_t mSampleNumber;
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_ESTIMATOR_IMU_PREINTEGRATOR_HPP__
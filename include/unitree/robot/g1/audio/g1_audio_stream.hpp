@@ -0,0 +1,699 @@
+#ifndef __UT_ROBOT_G1_AUDIO_STREAM_HPP__
+#define __UT_ROBOT_G1_AUDIO_STREAM_HPP__
+
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/common/thread/recurrent_thread.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <unitree/idl/go2/AudioData_.hpp>
+#include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <map>
+
+#include "g1_audio_client.hpp"
+
+namespace unitree {
+namespace robot {
+namespace g1 {
+/*
+ * PlayStream expects 16 kHz mono pcm16, asr consumes the same format.
+ */
+const int32_t AUDIO_STREAM_SAMPLE_RATE = 16000;
+const int32_t AUDIO_STREAM_CHANNELS = 1;
+
+/*
+ * interleaved little-endian pcm16
+ */
+struct AudioFormat {
+  int32_t sample_rate = AUDIO_STREAM_SAMPLE_RATE;
+  int32_t channels = AUDIO_STREAM_CHANNELS;
+
+  size_t MillisecondToFrames(uint32_t ms) const {
+    return (size_t)sample_rate * ms / 1000;
+  }
+};
+
+/*
+ * AudioJitterBuffer
+ *
+ * Reorders packets by stamp (any monotonic unit, e.g. AudioData_ time_frame)
+ * and releases samples only after target_samples are buffered. Packets older
+ * than the last released one are dropped as late. On underrun the missing
+ * samples are filled with silence and the buffer prefills again, so a jittery
+ * sender costs latency once instead of a click on every late packet.
+ * SetEndOfStream releases a tail shorter than target_samples; once it has
+ * drained, the next packet starts a new stream with its own stamps.
+ * Thread safe.
+ */
+class AudioJitterBuffer {
+ public:
+  AudioJitterBuffer(size_t target_samples, size_t max_samples)
+      : target_samples_(target_samples),
+        max_samples_(std::max(max_samples, target_samples)) {}
+
+  void Push(uint64_t stamp, const int16_t* samples, size_t count) {
+    if (count == 0) {
+      return;
+    }
+
+    common::LockGuard<common::Mutex> guard(mutex_);
+    if (has_released_ && stamp <= released_stamp_) {
+      late_count_++;
+      return;
+    }
+
+    auto result = packets_.emplace(stamp, Packet());
+    if (!result.second) {
+      return;
+    }
+    result.first->second.samples.assign(samples, samples + count);
+    buffered_ += count;
+
+    while (buffered_ > max_samples_ && !packets_.empty()) {
+      Release(packets_.begin());
+      overflow_count_++;
+    }
+  }
+
+  /*
+   * @brief fill count samples, padding with silence.
+   * @return number of buffered samples written, 0 while prefilling.
+   */
+  size_t Pop(int16_t* out, size_t count) {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    if (!playing_) {
+      if (buffered_ == 0 || (buffered_ < target_samples_ && !end_of_stream_)) {
+        std::memset(out, 0, count * sizeof(int16_t));
+        return 0;
+      }
+      playing_ = true;
+    }
+
+    return PopLocked(out, count);
+  }
+
+  /*
+   * @brief take exactly count samples if available, without silence padding.
+   */
+  bool PopExact(int16_t* out, size_t count) {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    if (buffered_ < count ||
+        (!playing_ && !end_of_stream_ && buffered_ < target_samples_)) {
+      return false;
+    }
+    playing_ = true;
+
+    return PopLocked(out, count) == count;
+  }
+
+  /*
+   * @brief the sender is done: release what is buffered without waiting for
+   *        target_samples. Cleared when the buffer has drained.
+   */
+  void SetEndOfStream() {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    end_of_stream_ = buffered_ > 0;
+    if (!end_of_stream_) {
+      Restart();
+    }
+  }
+
+  bool IsEndOfStream() const {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    return end_of_stream_;
+  }
+
+  void Clear() {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    packets_.clear();
+    buffered_ = 0;
+    Restart();
+  }
+
+  size_t GetBufferedSamples() const {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    return buffered_;
+  }
+
+  uint64_t GetLateCount() const { return late_count_; }
+  uint64_t GetOverflowCount() const { return overflow_count_; }
+  uint64_t GetUnderrunCount() const { return underrun_count_; }
+
+ private:
+  struct Packet {
+    std::vector<int16_t> samples;
+    size_t offset = 0;
+  };
+
+  size_t PopLocked(int16_t* out, size_t count) {
+    size_t written = 0;
+    while (written < count && !packets_.empty()) {
+      auto iter = packets_.begin();
+      Packet& packet = iter->second;
+      size_t n = std::min(count - written, packet.samples.size() - packet.offset);
+      std::memcpy(out + written, packet.samples.data() + packet.offset,
+                  n * sizeof(int16_t));
+      packet.offset += n;
+      buffered_ -= n;
+      written += n;
+      if (packet.offset == packet.samples.size()) {
+        Release(iter);
+      }
+    }
+
+    if (written < count) {
+      std::memset(out + written, 0, (count - written) * sizeof(int16_t));
+      if (end_of_stream_) {
+        Restart();
+      } else {
+        underrun_count_++;
+        playing_ = false;
+      }
+    } else if (end_of_stream_ && buffered_ == 0) {
+      Restart();
+    }
+
+    return written;
+  }
+
+  void Restart() {
+    playing_ = false;
+    end_of_stream_ = false;
+    has_released_ = false;
+  }
+
+  void Release(std::map<uint64_t, Packet>::iterator iter) {
+    buffered_ -= iter->second.samples.size() - iter->second.offset;
+    released_stamp_ = iter->first;
+    has_released_ = true;
+    packets_.erase(iter);
+  }
+
+ private:
+  mutable common::Mutex mutex_;
+  std::map<uint64_t, Packet> packets_;
+  size_t target_samples_;
+  size_t max_samples_;
+  size_t buffered_ = 0;
+  bool playing_ = false;
+  bool end_of_stream_ = false;
+  bool has_released_ = false;
+  uint64_t released_stamp_ = 0;
+  std::atomic<uint64_t> late_count_{0};
+  std::atomic<uint64_t> overflow_count_{0};
+  std::atomic<uint64_t> underrun_count_{0};
+};
+
+/*
+ * AudioResampler
+ *
+ * Streaming linear interpolation resampler. Channels are remixed first:
+ * averaged down to a mono output, copied from a mono input to every output
+ * channel, otherwise mapped one to one with extra input channels dropped and
+ * missing output channels silent. The fractional position and last input
+ * frame carry over between calls, so arbitrary packet sizes resample without
+ * seams.
+ */
+class AudioResampler {
+ public:
+  AudioResampler(const AudioFormat& input, const AudioFormat& output)
+      : input_(input),
+        output_(output),
+        step_((double)input.sample_rate / output.sample_rate),
+        prev_(output.channels, 0.0f) {}
+
+  const AudioFormat& GetInputFormat() const { return input_; }
+  const AudioFormat& GetOutputFormat() const { return output_; }
+
+  /*
+   * @brief resample frames input frames and append to out.
+   */
+  void Process(const int16_t* in, size_t frames, std::vector<int16_t>& out) {
+    const int32_t in_channels = input_.channels;
+    const int32_t out_channels = output_.channels;
+    if (frames == 0) {
+      return;
+    }
+
+    if (input_.sample_rate == output_.sample_rate &&
+        in_channels == out_channels) {
+      out.insert(out.end(), in, in + frames * in_channels);
+      return;
+    }
+
+    /*
+     * remix into out_channels interleaved float frames first
+     */
+    mixed_.resize(frames * out_channels);
+    if (in_channels == out_channels) {
+      for (size_t i = 0; i < frames * out_channels; i++) {
+        mixed_[i] = in[i];
+      }
+    } else if (out_channels == 1) {
+      const float scale = 1.0f / in_channels;
+      for (size_t i = 0; i < frames; i++) {
+        float sum = 0.0f;
+        for (int32_t c = 0; c < in_channels; c++) {
+          sum += in[i * in_channels + c];
+        }
+        mixed_[i] = sum * scale;
+      }
+    } else {
+      for (size_t i = 0; i < frames; i++) {
+        for (int32_t c = 0; c < out_channels; c++) {
+          float v = 0.0f;
+          if (in_channels == 1) {
+            v = in[i];
+          } else if (c < in_channels) {
+            v = in[i * in_channels + c];
+          }
+          mixed_[i * out_channels + c] = v;
+        }
+      }
+    }
+
+    /*
+     * position -1 refers to the last frame of the previous call
+     */
+    const double last = (double)frames - 1.0;
+    while (pos_ < last) {
+      int64_t index = (int64_t)std::floor(pos_);
+      float frac = (float)(pos_ - index);
+      const float* a = index < 0 ? prev_.data() : &mixed_[index * out_channels];
+      const float* b = &mixed_[(index + 1) * out_channels];
+      for (int32_t c = 0; c < out_channels; c++) {
+        float v = a[c] + (b[c] - a[c]) * frac;
+        out.push_back((int16_t)std::max(-32768.0f, std::min(32767.0f, v)));
+      }
+      pos_ += step_;
+    }
+
+    pos_ -= (double)frames;
+    std::copy(mixed_.end() - out_channels, mixed_.end(), prev_.begin());
+  }
+
+  void Reset() {
+    pos_ = 0.0;
+    std::fill(prev_.begin(), prev_.end(), 0.0f);
+  }
+
+ private:
+  AudioFormat input_;
+  AudioFormat output_;
+  double step_;
+  double pos_ = 0.0;
+  std::vector<float> prev_;
+  std::vector<float> mixed_;
+};
+
+/*
+ * sink for steady sized pcm16 packets, returns 0 on success.
+ */
+using AudioSink = std::function<int32_t(const std::vector<uint8_t>&)>;
+
+inline AudioSink MakeAudioClientSink(AudioClient& client,
+                                     const std::string& app_name,
+                                     const std::string& stream_id) {
+  return [&client, app_name, stream_id](const std::vector<uint8_t>& pcm) {
+    return client.PlayStream(app_name, stream_id, pcm);
+  };
+}
+
+inline AudioSink MakeAudioPublisherSink(
+    ChannelPublisherPtr<unitree_go::msg::dds_::AudioData_> publisher) {
+  auto msg = std::make_shared<unitree_go::msg::dds_::AudioData_>();
+  return [publisher, msg](const std::vector<uint8_t>& pcm) {
+    msg->time_frame(common::GetCurrentTimeMillisecond());
+    msg->data(pcm);
+    return publisher->Write(*msg) ? 0 : -1;
+  };
+}
+
+/*
+ * AudioStreamParam
+ */
+struct AudioStreamParam {
+  /*
+   * format of pushed pcm, buffered as is and resampled to output when it
+   * leaves the jitter buffer.
+   */
+  AudioFormat input;
+  AudioFormat output;
+
+  /*
+   * audio buffered before playout starts and upper bound of the buffer.
+   */
+  uint32_t jitter_delay_ms = 200;
+  uint32_t max_buffer_ms = 2000;
+
+  /*
+   * packet size handed to the sink.
+   */
+  uint32_t chunk_ms = 100;
+
+  /*
+   * how far the sink is fed ahead of real time, covers sink call jitter.
+   */
+  uint32_t lead_ms = 300;
+
+  int32_t cpu_id = UT_CPU_ID_NONE;
+};
+
+/*
+ * AudioStreamPlayer
+ *
+ * Push pcm packets from any thread (TTS, network, AudioData_ topic); a pacing
+ * thread feeds the sink with chunk_ms packets at real-time rate, lead_ms ahead
+ * of the playback clock. Packets are buffered in input format and resampled on
+ * the pacing thread in playout order, so the resampler state always runs over
+ * adjacent audio, however the packets arrived. Underruns inside an utterance
+ * are padded with silence; an idle buffer sends nothing.
+ */
+class AudioStreamPlayer {
+ public:
+  explicit AudioStreamPlayer(const AudioSink& sink,
+                             const AudioStreamParam& param = AudioStreamParam())
+      : param_(param),
+        sink_(sink),
+        buffer_(param.input.MillisecondToFrames(param.jitter_delay_ms) *
+                    param.input.channels,
+                param.input.MillisecondToFrames(param.max_buffer_ms) *
+                    param.input.channels),
+        resampler_(param.input, param.output),
+        chunk_samples_(param.output.MillisecondToFrames(param.chunk_ms) *
+                       param.output.channels) {
+    input_chunk_.resize(param.input.MillisecondToFrames(param.chunk_ms) *
+                        param.input.channels);
+    chunk_.resize(chunk_samples_ * sizeof(int16_t));
+  }
+
+  virtual ~AudioStreamPlayer() { Stop(); }
+
+  void Start() {
+    if (!thread_ptr_) {
+      thread_ptr_ = common::CreateRecurrentThreadEx(
+          "audioplay", param_.cpu_id, param_.chunk_ms * 250,
+          &AudioStreamPlayer::PlayThreadFunc, this);
+    }
+  }
+
+  void Subscribe(const std::string& topic) {
+    subscriber_ptr_.reset(
+        new ChannelSubscriber<unitree_go::msg::dds_::AudioData_>(topic));
+    subscriber_ptr_->InitChannel(
+        std::bind(&AudioStreamPlayer::AudioDataHandler, this,
+                  std::placeholders::_1));
+  }
+
+  void Stop() {
+    if (subscriber_ptr_) {
+      subscriber_ptr_->CloseChannel();
+      subscriber_ptr_.reset();
+    }
+
+    /*
+     * RecurrentThread::Wait ends the loop and joins, the destructor would
+     * cancel the thread instead.
+     */
+    if (thread_ptr_) {
+      thread_ptr_->Wait();
+      thread_ptr_.reset();
+    }
+  }
+
+  /*
+   * @brief queue pcm16 bytes in input format.
+   */
+  void Push(uint64_t stamp, const uint8_t* data, size_t size) {
+    const size_t channels = param_.input.channels;
+    buffer_.Push(stamp, (const int16_t*)data,
+                 size / (sizeof(int16_t) * channels) * channels);
+    received_++;
+  }
+
+  void Push(uint64_t stamp, const std::vector<uint8_t>& data) {
+    Push(stamp, data.data(), data.size());
+  }
+
+  /*
+   * @brief the utterance is complete: play out what is buffered, also when
+   *        it is shorter than jitter_delay_ms.
+   */
+  void SetEndOfStream() { buffer_.SetEndOfStream(); }
+
+  /*
+   * @brief drop buffered audio, e.g. when a new utterance interrupts.
+   */
+  void Clear() {
+    buffer_.Clear();
+    reset_ = true;
+  }
+
+  const AudioJitterBuffer& GetJitterBuffer() const { return buffer_; }
+  uint64_t GetReceivedCount() const { return received_; }
+  uint64_t GetSentCount() const { return sent_; }
+  uint64_t GetSinkErrorCount() const { return sink_error_; }
+
+ private:
+  void AudioDataHandler(const void* message) {
+    const auto& msg = *(const unitree_go::msg::dds_::AudioData_*)message;
+    Push(msg.time_frame(), msg.data());
+  }
+
+  void PlayThreadFunc() {
+    const uint64_t now = common::GetCurrentMonotonicTimeNanosecond();
+    const uint64_t chunk_ns = (uint64_t)param_.chunk_ms * 1000000;
+    const uint64_t lead_ns = (uint64_t)param_.lead_ms * 1000000;
+
+    /*
+     * sink clock restarts from now after an idle period
+     */
+    if (play_clock_ < now) {
+      play_clock_ = now;
+    }
+
+    if (reset_.exchange(false)) {
+      pending_.clear();
+      resampler_.Reset();
+    }
+
+    while (play_clock_ < now + lead_ns) {
+      if (!FillChunk()) {
+        break;
+      }
+
+      if (sink_(chunk_) == 0) {
+        sent_++;
+      } else {
+        sink_error_++;
+      }
+      play_clock_ += chunk_ns;
+    }
+  }
+
+  /*
+   * @brief resample input chunks from the buffer until an output chunk is
+   *        pending. When the buffer releases nothing, a remainder is padded
+   *        with silence and sent, and the resampler starts over.
+   */
+  bool FillChunk() {
+    const size_t frames = input_chunk_.size() / param_.input.channels;
+    while (pending_.size() < chunk_samples_) {
+      if (buffer_.Pop(input_chunk_.data(), input_chunk_.size()) == 0) {
+        resampler_.Reset();
+        if (pending_.empty()) {
+          return false;
+        }
+        pending_.resize(chunk_samples_, 0);
+        break;
+      }
+      resampler_.Process(input_chunk_.data(), frames, pending_);
+    }
+
+    std::memcpy(chunk_.data(), pending_.data(), chunk_.size());
+    pending_.erase(pending_.begin(), pending_.begin() + chunk_samples_);
+    return true;
+  }
+
+ private:
+  AudioStreamParam param_;
+  AudioSink sink_;
+
+  AudioJitterBuffer buffer_;
+
+  /*
+   * pacing thread only, Clear hands its reset over through reset_.
+   */
+  AudioResampler resampler_;
+  std::vector<int16_t> input_chunk_;
+  std::vector<int16_t> pending_;
+  std::atomic<bool> reset_{false};
+
+  size_t chunk_samples_;
+  std::vector<uint8_t> chunk_;
+  uint64_t play_clock_ = 0;
+
+  ChannelSubscriberPtr<unitree_go::msg::dds_::AudioData_> subscriber_ptr_;
+  common::ThreadPtr thread_ptr_;
+
+  std::atomic<uint64_t> received_{0};
+  std::atomic<uint64_t> sent_{0};
+  std::atomic<uint64_t> sink_error_{0};
+};
+
+/*
+ * AudioCapture
+ *
+ * Capture side for asr: microphone packets (AudioData_ topic or raw pcm from
+ * Push) are reordered, then resampled to output in stream order and delivered
+ * as chunk_ms packets on a worker thread. Nothing is padded; lead_ms is unused.
+ */
+class AudioCapture {
+ public:
+  using Handler = std::function<void(const std::vector<uint8_t>&)>;
+
+  explicit AudioCapture(const Handler& handler,
+                        const AudioStreamParam& param = AudioStreamParam())
+      : param_(param),
+        handler_(handler),
+        buffer_(param.input.MillisecondToFrames(param.jitter_delay_ms) *
+                    param.input.channels,
+                param.input.MillisecondToFrames(param.max_buffer_ms) *
+                    param.input.channels),
+        resampler_(param.input, param.output),
+        chunk_samples_(param.output.MillisecondToFrames(param.chunk_ms) *
+                       param.output.channels) {
+    input_chunk_.resize(param.input.MillisecondToFrames(param.chunk_ms) *
+                        param.input.channels);
+    chunk_.resize(chunk_samples_ * sizeof(int16_t));
+  }
+
+  virtual ~AudioCapture() { Stop(); }
+
+  void Start() {
+    if (!thread_ptr_) {
+      thread_ptr_ = common::CreateRecurrentThreadEx(
+          "audiocapture", param_.cpu_id, param_.chunk_ms * 500,
+          &AudioCapture::CaptureThreadFunc, this);
+    }
+  }
+
+  void Subscribe(const std::string& topic) {
+    subscriber_ptr_.reset(
+        new ChannelSubscriber<unitree_go::msg::dds_::AudioData_>(topic));
+    subscriber_ptr_->InitChannel(std::bind(
+        &AudioCapture::AudioDataHandler, this, std::placeholders::_1));
+  }
+
+  void Stop() {
+    if (subscriber_ptr_) {
+      subscriber_ptr_->CloseChannel();
+      subscriber_ptr_.reset();
+    }
+
+    if (thread_ptr_) {
+      thread_ptr_->Wait();
+      thread_ptr_.reset();
+    }
+  }
+
+  void Push(uint64_t stamp, const uint8_t* data, size_t size) {
+    const size_t channels = param_.input.channels;
+    buffer_.Push(stamp, (const int16_t*)data,
+                 size / (sizeof(int16_t) * channels) * channels);
+  }
+
+  void Push(uint64_t stamp, const std::vector<uint8_t>& data) {
+    Push(stamp, data.data(), data.size());
+  }
+
+  /*
+   * @brief the recording is complete: deliver what is buffered, the last
+   *        packet may be shorter than chunk_ms.
+   */
+  void SetEndOfStream() {
+    buffer_.SetEndOfStream();
+    end_of_stream_ = true;
+  }
+
+  const AudioJitterBuffer& GetJitterBuffer() const { return buffer_; }
+
+ private:
+  void AudioDataHandler(const void* message) {
+    const auto& msg = *(const unitree_go::msg::dds_::AudioData_*)message;
+    Push(msg.time_frame(), msg.data());
+  }
+
+  void CaptureThreadFunc() {
+    const size_t channels = param_.input.channels;
+    while (buffer_.PopExact(input_chunk_.data(), input_chunk_.size())) {
+      resampler_.Process(input_chunk_.data(), input_chunk_.size() / channels,
+                         pending_);
+      Deliver();
+    }
+
+    /*
+     * the buffer releases a tail short of a chunk at the end of the stream;
+     * once it has drained, the resampled remainder is the last packet.
+     */
+    if (end_of_stream_) {
+      if (buffer_.IsEndOfStream()) {
+        size_t n = buffer_.Pop(input_chunk_.data(), input_chunk_.size());
+        resampler_.Process(input_chunk_.data(), n / channels, pending_);
+        Deliver();
+      }
+
+      if (!buffer_.IsEndOfStream()) {
+        if (!pending_.empty()) {
+          const uint8_t* tail = (const uint8_t*)pending_.data();
+          tail_.assign(tail, tail + pending_.size() * sizeof(int16_t));
+          handler_(tail_);
+          pending_.clear();
+        }
+        resampler_.Reset();
+        end_of_stream_ = false;
+      }
+    }
+  }
+
+  void Deliver() {
+    size_t offset = 0;
+    while (pending_.size() - offset >= chunk_samples_) {
+      std::memcpy(chunk_.data(), pending_.data() + offset, chunk_.size());
+      handler_(chunk_);
+      offset += chunk_samples_;
+    }
+    pending_.erase(pending_.begin(), pending_.begin() + offset);
+  }
+
+ private:
+  AudioStreamParam param_;
+  Handler handler_;
+
+  AudioJitterBuffer buffer_;
+  std::atomic<bool> end_of_stream_{false};
+
+  /*
+   * worker thread only
+   */
+  AudioResampler resampler_;
+  std::vector<int16_t> input_chunk_;
+  std::vector<int16_t> pending_;
+
+  size_t chunk_samples_;
+  std::vector<uint8_t> chunk_;
+  std::vector<uint8_t> tail_;
+
+  ChannelSubscriberPtr<unitree_go::msg::dds_::AudioData_> subscriber_ptr_;
+  common::ThreadPtr thread_ptr_;
+};
+}  // namespace g1
+}  // namespace robot
+}  // namespace unitree
+
+#endif  // __UT_ROBOT_G1_AUDIO_STREAM_HPP__
@@ -0,0 +1,247 @@
+#pragma once
+
+/**
+ * Fused version of the checks in terminations.hpp. All per-motor checks are
+ * evaluated in one pass over structure-of-arrays state, the result is a
+ * bitmask of tripped conditions with the time each one first tripped.
+ */
+
+#include <unitree/robot/g1/common/terminations.hpp>
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace unitree {
+namespace robot {
+namespace g1 {
+
+enum SafetyCheck : uint32_t
+{
+    SAFETY_BAD_ORIENTATION  = 1u << 0,
+    SAFETY_ANG_VEL          = 1u << 1,
+    SAFETY_JOINT_POS        = 1u << 2,
+    SAFETY_JOINT_VEL        = 1u << 3,
+    SAFETY_JOINT_TORQUE     = 1u << 4,
+    SAFETY_WINDING_OVERHEAT = 1u << 5,
+    SAFETY_CASING_OVERHEAT  = 1u << 6,
+    SAFETY_LOW_BATTERY      = 1u << 7,
+    SAFETY_LOST_CONNECTION  = 1u << 8,
+    SAFETY_ALL              = (1u << 9) - 1
+};
+
+constexpr int kSafetyCheckNumber = 9;
+
+/**
+ * Scalar limits, same defaults as the functions in terminations.hpp.
+ * Per-joint position, velocity and torque limits are set on the monitor.
+ */
+struct SafetyLimits
+{
+    float orientation = 1.0f;
+    float ang_vel = 6.0f;
+    float joint_vel = 10.0f;
+    float winding_temp = 120.0f;
+    float casing_temp = 85.0f;
+    float battery_soc = 20.0f;
+    int64_t timeout_ms = 1000;
+};
+
+class SafetyMonitor
+{
+public:
+    static constexpr int kMotorNumber = 35;
+
+    // padded to whole vector registers, padding lanes never trip
+    static constexpr int kStride = (kMotorNumber + 7) / 8 * 8;
+
+    explicit SafetyMonitor(const SafetyLimits & limits = SafetyLimits(), uint32_t enabled = SAFETY_ALL)
+        : limits_(limits), enabled_(enabled), cos_orientation_(std::cos(limits.orientation))
+    {
+        const float inf = std::numeric_limits<float>::infinity();
+        q_min_.fill(-inf);
+        q_max_.fill(inf);
+        dq_max_.fill(inf);
+        tau_max_.fill(inf);
+        winding_max_.fill(std::numeric_limits<int16_t>::max());
+        casing_max_.fill(std::numeric_limits<int16_t>::max());
+        for (int i = 0; i < kMotorNumber; ++i)
+        {
+            dq_max_[i] = limits.joint_vel;
+            SetTemperatureLimit(i, limits.winding_temp, limits.casing_temp);
+        }
+        q_.fill(0.0f);
+        dq_.fill(0.0f);
+        tau_.fill(0.0f);
+        winding_.fill(0);
+        casing_.fill(0);
+        Reset();
+    }
+
+    // Limits of one motor, pass infinity to disable a bound.
+    void SetJointLimit(int motor, float q_min, float q_max, float dq_max, float tau_max)
+    {
+        q_min_[motor] = q_min;
+        q_max_[motor] = q_max;
+        dq_max_[motor] = dq_max;
+        tau_max_[motor] = tau_max;
+    }
+
+    // Temperatures are reported in whole degrees and compared as integers.
+    void SetTemperatureLimit(int motor, float winding, float casing)
+    {
+        winding_max_[motor] = (int16_t)std::floor(winding);
+        casing_max_[motor] = (int16_t)std::floor(casing);
+    }
+
+    void SetEnabled(uint32_t enabled) { enabled_ = enabled; }
+
+    // Clear the latched mask and first-trip timestamps.
+    void Reset()
+    {
+        latched_ = 0;
+        first_trip_ns_.fill(0);
+    }
+
+    /**
+     * @brief evaluate every enabled check on one LowState_.
+     * @return conditions tripped by this state.
+     */
+    uint32_t Check(const unitree_hg::msg::dds_::LowState_ & lowstate, int64_t now_ns)
+    {
+        // AoS -> SoA, the only strided pass over the message
+        const auto & motors = lowstate.motor_state();
+        for (int i = 0; i < kMotorNumber; ++i)
+        {
+            const auto & motor = motors[i];
+            q_[i] = motor.q();
+            dq_[i] = motor.dq();
+            tau_[i] = motor.tau_est();
+            casing_[i] = motor.temperature()[0];
+            winding_[i] = motor.temperature()[1];
+        }
+
+        // one fused pass, each comparison lowers to a packed compare and or
+        int pos = 0, vel = 0, torque = 0, winding = 0, casing = 0;
+        for (int i = 0; i < kStride; ++i)
+        {
+            pos |= (q_[i] < q_min_[i]) | (q_[i] > q_max_[i]);
+            vel |= std::fabs(dq_[i]) > dq_max_[i];
+            torque |= std::fabs(tau_[i]) > tau_max_[i];
+            winding |= winding_[i] > winding_max_[i];
+            casing |= casing_[i] > casing_max_[i];
+        }
+
+        uint32_t mask = 0;
+        mask |= pos ? SAFETY_JOINT_POS : 0;
+        mask |= vel ? SAFETY_JOINT_VEL : 0;
+        mask |= torque ? SAFETY_JOINT_TORQUE : 0;
+        mask |= winding ? SAFETY_WINDING_OVERHEAT : 0;
+        mask |= casing ? SAFETY_CASING_OVERHEAT : 0;
+
+        const auto & imu = lowstate.imu_state();
+        const auto & quat = imu.quaternion();
+        const auto & gyro = imu.gyroscope();
+
+        // angle to upright from projected gravity z, compared as cosine
+        const float up = 1.0f - 2.0f * (quat[1] * quat[1] + quat[2] * quat[2]);
+        mask |= up < cos_orientation_ ? SAFETY_BAD_ORIENTATION : 0;
+        mask |= (std::fabs(gyro[0]) > limits_.ang_vel || std::fabs(gyro[1]) > limits_.ang_vel ||
+                 std::fabs(gyro[2]) > limits_.ang_vel) ? SAFETY_ANG_VEL : 0;
+
+        return Latch(mask, now_ns);
+    }
+
+    uint32_t CheckBattery(const unitree_hg::msg::dds_::BmsState_ & bms_state, int64_t now_ns)
+    {
+        return Latch(bms_state.soc() < limits_.battery_soc ? SAFETY_LOW_BATTERY : 0, now_ns);
+    }
+
+    /**
+     * @brief last_data_ns is the arrival time of the newest LowState_, e.g.
+     *        ChannelSubscriber::GetLastDataAvailableTime().
+     */
+    uint32_t CheckConnection(int64_t last_data_ns, int64_t now_ns)
+    {
+        return Latch(now_ns - last_data_ns > limits_.timeout_ms * 1000000 ? SAFETY_LOST_CONNECTION : 0, now_ns);
+    }
+
+    // Every condition tripped since the last Reset.
+    uint32_t GetLatched() const { return latched_; }
+
+    // Time a condition first tripped since the last Reset, 0 if never.
+    int64_t GetFirstTripTime(SafetyCheck check) const
+    {
+        return first_trip_ns_[__builtin_ctz(check)];
+    }
+
+    /**
+     * @brief motors violating the per-motor part of check in the last
+     *        Check, bit i is motor i. Slow path, call after a trip.
+     */
+    uint64_t GetJointMask(SafetyCheck check) const
+    {
+        uint64_t mask = 0;
+        for (int i = 0; i < kMotorNumber; ++i)
+        {
+            bool bad = false;
+            switch (check)
+            {
+            case SAFETY_JOINT_POS: bad = q_[i] < q_min_[i] || q_[i] > q_max_[i]; break;
+            case SAFETY_JOINT_VEL: bad = std::fabs(dq_[i]) > dq_max_[i]; break;
+            case SAFETY_JOINT_TORQUE: bad = std::fabs(tau_[i]) > tau_max_[i]; break;
+            case SAFETY_WINDING_OVERHEAT: bad = winding_[i] > winding_max_[i]; break;
+            case SAFETY_CASING_OVERHEAT: bad = casing_[i] > casing_max_[i]; break;
+            default: break;
+            }
+            mask |= bad ? (1ull << i) : 0;
+        }
+        return mask;
+    }
+
+    static const char * GetCheckName(SafetyCheck check)
+    {
+        static const char * names[kSafetyCheckNumber] = {
+            "bad orientation", "angular velocity", "joint position", "joint velocity", "joint torque",
+            "winding overheat", "casing overheat", "low battery", "lost connection"
+        };
+        return names[__builtin_ctz(check)];
+    }
+
+private:
+    uint32_t Latch(uint32_t mask, int64_t now_ns)
+    {
+        mask &= enabled_;
+        uint32_t fresh = mask & ~latched_;
+        latched_ |= mask;
+        while (fresh)
+        {
+            first_trip_ns_[__builtin_ctz(fresh)] = now_ns;
+            fresh &= fresh - 1;
+        }
+        return mask;
+    }
+
+    SafetyLimits limits_;
+    uint32_t enabled_;
+    float cos_orientation_;
+    uint32_t latched_;
+    std::array<int64_t, kSafetyCheckNumber> first_trip_ns_;
+
+    alignas(32) std::array<float, kStride> q_;
+    alignas(32) std::array<float, kStride> dq_;
+    alignas(32) std::array<float, kStride> tau_;
+    alignas(32) std::array<int16_t, kStride> winding_;
+    alignas(32) std::array<int16_t, kStride> casing_;
+
+    alignas(32) std::array<float, kStride> q_min_;
+    alignas(32) std::array<float, kStride> q_max_;
+    alignas(32) std::array<float, kStride> dq_max_;
+    alignas(32) std::array<float, kStride> tau_max_;
+    alignas(32) std::array<int16_t, kStride> winding_max_;
+    alignas(32) std::array<int16_t, kStride> casing_max_;
+};
+
+}
+}
+}
@@ -0,0 +1,250 @@
+#ifndef __UT_ROBOT_G1_DEX3_HAND_HPP__
+#define __UT_ROBOT_G1_DEX3_HAND_HPP__
+
+#include <unitree/common/lock/triple_buffer.hpp>
+#include <unitree/common/time/deadline_timer.hpp>
+#include <unitree/idl/hg/HandCmd_.hpp>
+#include <unitree/idl/hg/HandState_.hpp>
+#include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/robot/model/dex3_model.hpp>
+
+#include <algorithm>
+#include <array>
+
+namespace unitree {
+namespace robot {
+namespace g1 {
+
+const std::string DEX3_LEFT_CMD_TOPIC = "rt/dex3/left/cmd";
+const std::string DEX3_RIGHT_CMD_TOPIC = "rt/dex3/right/cmd";
+const std::string DEX3_LEFT_STATE_TOPIC = "rt/lf/dex3/left/state";
+const std::string DEX3_RIGHT_STATE_TOPIC = "rt/lf/dex3/right/state";
+
+constexpr int kDex3MotorNumber = 7;
+constexpr int kDex3SensorNumber = 9;
+constexpr int kDex3TaxelNumber = 12;
+
+enum class Dex3Side { kLeft = 0, kRight = 1 };
+
+/*
+ * MotorCmd_::mode of a Dex3 motor: id in bits 0-3, status in bits 4-6,
+ * timeout in bit 7.
+ */
+constexpr uint8_t DEX3_MOTOR_STATUS_ENABLE = 0x01;
+
+constexpr uint8_t PackDex3Mode(uint8_t id, uint8_t status = DEX3_MOTOR_STATUS_ENABLE,
+                               bool timeout = false) {
+  return (uint8_t)((id & 0x0F) | ((status & 0x07) << 4) | ((timeout ? 1 : 0) << 7));
+}
+
+constexpr uint8_t Dex3ModeId(uint8_t mode) { return mode & 0x0F; }
+constexpr uint8_t Dex3ModeStatus(uint8_t mode) { return (mode >> 4) & 0x07; }
+constexpr bool Dex3ModeTimeout(uint8_t mode) { return (mode >> 7) & 0x01; }
+
+/*
+ * Fixed size copy of HandState_. Tactile data is row major
+ * [sensor][taxel] so one pad or the whole hand is a contiguous float range.
+ */
+struct Dex3HandState {
+  int64_t time = 0;
+
+  std::array<float, kDex3MotorNumber> q = {};
+  std::array<float, kDex3MotorNumber> dq = {};
+  std::array<float, kDex3MotorNumber> tau = {};
+  std::array<int16_t, kDex3MotorNumber> temperature = {};
+  std::array<uint32_t, kDex3MotorNumber> motor_state = {};
+
+  alignas(32) std::array<float, kDex3SensorNumber * kDex3TaxelNumber> pressure = {};
+  alignas(32) std::array<float, kDex3SensorNumber * kDex3TaxelNumber> tactile_temperature = {};
+  std::array<uint32_t, kDex3SensorNumber> lost = {};
+
+  float power_v = 0.0f;
+  float power_a = 0.0f;
+  std::array<uint32_t, 2> error = {};
+};
+
+/*
+ * Dex3Hand
+ *
+ * One hand of the Dex3-1. The HandCmd_ vectors are sized once and every
+ * command is written in place, so steady state control does not allocate.
+ * The state handler copies each HandState_ into a fixed size Dex3HandState
+ * and hands it to the control thread through a triple buffer.
+ *
+ * Command calls and Write from one thread, Update/GetState from one thread.
+ */
+class Dex3Hand {
+ public:
+  explicit Dex3Hand(Dex3Side side) : side_(side) {
+    const bool left = side == Dex3Side::kLeft;
+    cmd_topic_ = left ? DEX3_LEFT_CMD_TOPIC : DEX3_RIGHT_CMD_TOPIC;
+    state_topic_ = left ? DEX3_LEFT_STATE_TOPIC : DEX3_RIGHT_STATE_TOPIC;
+    q_min_ = left ? model::Dex3Left::Q_MIN : model::Dex3Right::Q_MIN;
+    q_max_ = left ? model::Dex3Left::Q_MAX : model::Dex3Right::Q_MAX;
+
+    cmd_.motor_cmd().resize(kDex3MotorNumber);
+    for (int i = 0; i < kDex3MotorNumber; ++i) {
+      auto &motor = cmd_.motor_cmd()[i];
+      motor.mode(PackDex3Mode(i));
+      motor.kp(model::Dex3Left::KP[i]);
+      motor.kd(model::Dex3Left::KD[i]);
+    }
+  }
+
+  ~Dex3Hand() { CloseChannel(); }
+
+  // override before Init, e.g. for a hand not behind the lf state relay
+  void SetTopic(const std::string &cmd_topic, const std::string &state_topic) {
+    cmd_topic_ = cmd_topic;
+    state_topic_ = state_topic;
+  }
+
+  void Init() {
+    publisher_.reset(new ChannelPublisher<unitree_hg::msg::dds_::HandCmd_>(cmd_topic_));
+    publisher_->InitChannel();
+    subscriber_.reset(new ChannelSubscriber<unitree_hg::msg::dds_::HandState_>(state_topic_));
+    subscriber_->InitChannel(std::bind(&Dex3Hand::StateHandler, this, std::placeholders::_1), 1);
+  }
+
+  void CloseChannel() {
+    if (subscriber_) {
+      subscriber_->CloseChannel();
+      subscriber_.reset();
+    }
+    if (publisher_) {
+      publisher_->CloseChannel();
+      publisher_.reset();
+    }
+  }
+
+  /*
+   * Command side, takes effect on the next Write.
+   */
+  void SetCommand(int motor, float q, float dq, float kp, float kd, float tau) {
+    auto &cmd = cmd_.motor_cmd()[motor];
+    cmd.q(q);
+    cmd.dq(dq);
+    cmd.kp(kp);
+    cmd.kd(kd);
+    cmd.tau(tau);
+  }
+
+  // position targets, clamped to the joint limits, gains left as they are
+  void SetPosition(const std::array<float, kDex3MotorNumber> &q) {
+    auto &motor = cmd_.motor_cmd();
+    for (int i = 0; i < kDex3MotorNumber; ++i) {
+      motor[i].q(std::min(std::max(q[i], q_min_[i]), q_max_[i]));
+      motor[i].dq(0.0f);
+      motor[i].tau(0.0f);
+    }
+  }
+
+  // 0 is the lower joint limit, 1 the upper one
+  void SetNormalizedPosition(const std::array<float, kDex3MotorNumber> &ratio) {
+    std::array<float, kDex3MotorNumber> q;
+    for (int i = 0; i < kDex3MotorNumber; ++i) {
+      q[i] = q_min_[i] + ratio[i] * (q_max_[i] - q_min_[i]);
+    }
+    SetPosition(q);
+  }
+
+  void SetGain(float kp, float kd) {
+    for (auto &motor : cmd_.motor_cmd()) {
+      motor.kp(kp);
+      motor.kd(kd);
+    }
+  }
+
+  // status/timeout of every motor, e.g. timeout=true to release the hand
+  void SetMode(uint8_t status, bool timeout) {
+    for (int i = 0; i < kDex3MotorNumber; ++i) {
+      cmd_.motor_cmd()[i].mode(PackDex3Mode(i, status, timeout));
+    }
+  }
+
+  unitree_hg::msg::dds_::HandCmd_ &GetCommand() { return cmd_; }
+
+  // false before Init
+  bool Write() {
+    if (!publisher_) {
+      return false;
+    }
+    return publisher_->Write(cmd_);
+  }
+
+  /*
+   * State side. Update takes the newest state, false if none arrived since
+   * the previous call.
+   */
+  bool Update() { return state_.Update(); }
+
+  const Dex3HandState &GetState() const { return state_.GetReadBuffer(); }
+
+  const float *GetPressure() const { return state_.GetReadBuffer().pressure.data(); }
+
+  const float *GetPressure(int sensor) const {
+    return state_.GetReadBuffer().pressure.data() + sensor * kDex3TaxelNumber;
+  }
+
+  // joint position of the last Update mapped to [0, 1] between the limits
+  void GetNormalizedPosition(std::array<float, kDex3MotorNumber> &ratio) const {
+    const Dex3HandState &state = state_.GetReadBuffer();
+    for (int i = 0; i < kDex3MotorNumber; ++i) {
+      float r = (state.q[i] - q_min_[i]) / (q_max_[i] - q_min_[i]);
+      ratio[i] = std::min(std::max(r, 0.0f), 1.0f);
+    }
+  }
+
+  Dex3Side GetSide() const { return side_; }
+
+ private:
+  void StateHandler(const void *message) {
+    const auto &msg = *(const unitree_hg::msg::dds_::HandState_ *)message;
+    Dex3HandState &state = state_.GetWriteBuffer();
+    state.time = common::DeadlineTimer::GetClock();
+
+    const auto &motors = msg.motor_state();
+    const int motor_number = std::min((int)motors.size(), kDex3MotorNumber);
+    for (int i = 0; i < motor_number; ++i) {
+      state.q[i] = motors[i].q();
+      state.dq[i] = motors[i].dq();
+      state.tau[i] = motors[i].tau_est();
+      state.temperature[i] = motors[i].temperature()[0];
+      state.motor_state[i] = motors[i].motorstate();
+    }
+
+    const auto &sensors = msg.press_sensor_state();
+    const int sensor_number = std::min((int)sensors.size(), kDex3SensorNumber);
+    for (int i = 0; i < sensor_number; ++i) {
+      std::copy(sensors[i].pressure().begin(), sensors[i].pressure().end(),
+                state.pressure.begin() + i * kDex3TaxelNumber);
+      std::copy(sensors[i].temperature().begin(), sensors[i].temperature().end(),
+                state.tactile_temperature.begin() + i * kDex3TaxelNumber);
+      state.lost[i] = sensors[i].lost();
+    }
+
+    state.power_v = msg.power_v();
+    state.power_a = msg.power_a();
+    state.error = msg.error();
+    state_.Publish();
+  }
+
+  Dex3Side side_;
+  std::string cmd_topic_;
+  std::string state_topic_;
+  std::array<float, kDex3MotorNumber> q_min_;
+  std::array<float, kDex3MotorNumber> q_max_;
+
+  unitree_hg::msg::dds_::HandCmd_ cmd_;
+  common::TripleBuffer<Dex3HandState> state_;
+
+  ChannelPublisherPtr<unitree_hg::msg::dds_::HandCmd_> publisher_;
+  ChannelSubscriberPtr<unitree_hg::msg::dds_::HandState_> subscriber_;
+};
+
+}  // namespace g1
+}  // namespace robot
+}  // namespace unitree
+
+#endif  // __UT_ROBOT_G1_DEX3_HAND_HPP__
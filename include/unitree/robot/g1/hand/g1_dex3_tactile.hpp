@@ -0,0 +1,245 @@
+#ifndef __UT_ROBOT_G1_DEX3_TACTILE_HPP__
+#define __UT_ROBOT_G1_DEX3_TACTILE_HPP__
+
+#include <unitree/idl/ros2/PointCloud2_.hpp>
+#include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/robot/g1/hand/g1_dex3_hand.hpp>
+
+namespace unitree {
+namespace robot {
+namespace g1 {
+
+const std::string DEX3_LEFT_TACTILE_TOPIC = "rt/dex3/left/tactile";
+const std::string DEX3_RIGHT_TACTILE_TOPIC = "rt/dex3/right/tactile";
+
+struct Dex3TactileParam {
+  // first order low pass factor per message, 1 disables filtering
+  float alpha = 0.3f;
+
+  // calibrated taxel values below this read as 0
+  float threshold = 0.0f;
+
+  // a pad is in contact when its force exceeds this
+  float contact_force = 1.0f;
+
+  // default taxel layout: row major grid cols wide, pitch in meters
+  int cols = 4;
+  float pitch = 0.005f;
+
+  std::string frame_id;
+};
+
+/*
+ * Dex3Tactile
+ *
+ * Calibrates and low pass filters every taxel of every pad in one pass over
+ * the contiguous [sensor][taxel] layout of Dex3HandState, then reduces each
+ * pad to total force, centroid and active taxel count. The pass works on
+ * plain float arrays padded to whole vector registers so it auto-vectorizes.
+ *
+ * Calibration is value = max(gain * (raw - offset), 0) with values under
+ * threshold zeroed; Tare(n) averages the next n messages into the offsets.
+ *
+ * Not thread safe, call from the thread that owns the hand state.
+ */
+class Dex3Tactile {
+ public:
+  static constexpr int kTaxelTotal = kDex3SensorNumber * kDex3TaxelNumber;
+  static constexpr int kStride = (kTaxelTotal + 7) / 8 * 8;
+
+  explicit Dex3Tactile(const Dex3TactileParam &param = Dex3TactileParam())
+      : param_(param), tare_total_(0), tare_left_(0), initialized_(false) {
+    offset_.fill(0.0f);
+    gain_.fill(0.0f);
+    for (int i = 0; i < kTaxelTotal; ++i) {
+      gain_[i] = 1.0f;
+    }
+    px_.fill(0.0f);
+    py_.fill(0.0f);
+    for (int t = 0; t < kDex3TaxelNumber; ++t) {
+      const int cols = param.cols > 0 ? param.cols : 1;
+      SetTaxelPosition(t, (t % cols) * param.pitch, (t / cols) * param.pitch);
+    }
+    raw_.fill(0.0f);
+    value_.fill(0.0f);
+    tare_sum_.fill(0.0f);
+    force_.fill(0.0f);
+    cx_.fill(0.0f);
+    cy_.fill(0.0f);
+    area_.fill(0);
+  }
+
+  // position of taxel t on every pad, in the frame the centroid is wanted in
+  void SetTaxelPosition(int taxel, float x, float y) {
+    for (int s = 0; s < kDex3SensorNumber; ++s) {
+      px_[s * kDex3TaxelNumber + taxel] = x;
+      py_[s * kDex3TaxelNumber + taxel] = y;
+    }
+  }
+
+  void SetCalibration(int sensor, int taxel, float offset, float gain) {
+    offset_[sensor * kDex3TaxelNumber + taxel] = offset;
+    gain_[sensor * kDex3TaxelNumber + taxel] = gain;
+  }
+
+  // average the next samples messages into the offsets, hand unloaded
+  void Tare(int samples) {
+    tare_sum_.fill(0.0f);
+    tare_total_ = samples;
+    tare_left_ = samples;
+  }
+
+  bool IsTaring() const { return tare_left_ > 0; }
+
+  void Process(const Dex3HandState &state) { Process(state.pressure.data()); }
+
+  // pressure: kTaxelTotal raw values, [sensor][taxel]
+  void Process(const float *pressure) {
+    std::copy(pressure, pressure + kTaxelTotal, raw_.begin());
+
+    if (tare_left_ > 0) {
+      for (int i = 0; i < kStride; ++i) {
+        tare_sum_[i] += raw_[i];
+      }
+      if (--tare_left_ == 0) {
+        for (int i = 0; i < kStride; ++i) {
+          offset_[i] = tare_sum_[i] / tare_total_;
+        }
+        initialized_ = false;
+      }
+    }
+
+    // first message seeds the filter instead of ramping up from 0
+    const float alpha = initialized_ ? param_.alpha : 1.0f;
+    const float threshold = param_.threshold;
+    initialized_ = true;
+
+    for (int i = 0; i < kStride; ++i) {
+      float v = gain_[i] * (raw_[i] - offset_[i]);
+      v = v < threshold ? 0.0f : v;
+      value_[i] += alpha * (v - value_[i]);
+    }
+
+    // per pad reductions over fixed length rows, unrolled by the compiler
+    for (int s = 0; s < kDex3SensorNumber; ++s) {
+      const float *v = value_.data() + s * kDex3TaxelNumber;
+      const float *x = px_.data() + s * kDex3TaxelNumber;
+      const float *y = py_.data() + s * kDex3TaxelNumber;
+      float sum = 0.0f, sx = 0.0f, sy = 0.0f;
+      int area = 0;
+      for (int t = 0; t < kDex3TaxelNumber; ++t) {
+        sum += v[t];
+        sx += v[t] * x[t];
+        sy += v[t] * y[t];
+        area += v[t] > 0.0f;
+      }
+      force_[s] = sum;
+      cx_[s] = sum > 0.0f ? sx / sum : 0.0f;
+      cy_[s] = sum > 0.0f ? sy / sum : 0.0f;
+      area_[s] = area;
+    }
+  }
+
+  // filtered taxels, [sensor][taxel]
+  const float *GetValue() const { return value_.data(); }
+  const float *GetValue(int sensor) const { return value_.data() + sensor * kDex3TaxelNumber; }
+
+  float GetForce(int sensor) const { return force_[sensor]; }
+  float GetCentroidX(int sensor) const { return cx_[sensor]; }
+  float GetCentroidY(int sensor) const { return cy_[sensor]; }
+  int GetArea(int sensor) const { return area_[sensor]; }
+  bool IsContact(int sensor) const { return force_[sensor] > param_.contact_force; }
+
+  float GetTotalForce() const {
+    float sum = 0.0f;
+    for (int s = 0; s < kDex3SensorNumber; ++s) {
+      sum += force_[s];
+    }
+    return sum;
+  }
+
+  // bit s set for every pad in contact
+  uint32_t GetContactMask() const {
+    uint32_t mask = 0;
+    for (int s = 0; s < kDex3SensorNumber; ++s) {
+      mask |= IsContact(s) ? (1u << s) : 0;
+    }
+    return mask;
+  }
+
+  /*
+   * Summary topic: PointCloud2_ with one point per pad, fields x, y
+   * (centroid), force and area. The message is built once and reused.
+   */
+  void InitChannel(const std::string &topic) {
+    publisher_.reset(new ChannelPublisher<sensor_msgs::msg::dds_::PointCloud2_>(topic));
+    publisher_->InitChannel();
+
+    static const char *names[4] = {"x", "y", "force", "area"};
+    auto &fields = summary_.fields();
+    fields.resize(4);
+    for (uint32_t i = 0; i < 4; ++i) {
+      fields[i].name(names[i]);
+      fields[i].offset(i * sizeof(float));
+      fields[i].datatype(sensor_msgs::msg::dds_::PointField_Constants::FLOAT32_);
+      fields[i].count(1);
+    }
+    summary_.header().frame_id(param_.frame_id);
+    summary_.height(1);
+    summary_.width(kDex3SensorNumber);
+    summary_.is_bigendian(false);
+    summary_.point_step(4 * sizeof(float));
+    summary_.row_step(4 * sizeof(float) * kDex3SensorNumber);
+    summary_.is_dense(true);
+    summary_.data().resize(4 * sizeof(float) * kDex3SensorNumber);
+  }
+
+  // stamp_ns: time of the processed state, e.g. Dex3HandState::time.
+  // false before InitChannel
+  bool Write(int64_t stamp_ns) {
+    if (!publisher_) {
+      return false;
+    }
+
+    summary_.header().stamp().sec((int32_t)(stamp_ns / 1000000000));
+    summary_.header().stamp().nanosec((uint32_t)(stamp_ns % 1000000000));
+
+    float *dst = (float *)summary_.data().data();
+    for (int s = 0; s < kDex3SensorNumber; ++s, dst += 4) {
+      dst[0] = cx_[s];
+      dst[1] = cy_[s];
+      dst[2] = force_[s];
+      dst[3] = (float)area_[s];
+    }
+    return publisher_->Write(summary_);
+  }
+
+ private:
+  Dex3TactileParam param_;
+
+  alignas(32) std::array<float, kStride> offset_;
+  alignas(32) std::array<float, kStride> gain_;
+  alignas(32) std::array<float, kStride> px_;
+  alignas(32) std::array<float, kStride> py_;
+  alignas(32) std::array<float, kStride> raw_;
+  alignas(32) std::array<float, kStride> value_;
+  alignas(32) std::array<float, kStride> tare_sum_;
+
+  std::array<float, kDex3SensorNumber> force_;
+  std::array<float, kDex3SensorNumber> cx_;
+  std::array<float, kDex3SensorNumber> cy_;
+  std::array<int, kDex3SensorNumber> area_;
+
+  int tare_total_;
+  int tare_left_;
+  bool initialized_;
+
+  sensor_msgs::msg::dds_::PointCloud2_ summary_;
+  ChannelPublisherPtr<sensor_msgs::msg::dds_::PointCloud2_> publisher_;
+};
+
+}  // namespace g1
+}  // namespace robot
+}  // namespace unitree
+
+#endif  // __UT_ROBOT_G1_DEX3_TACTILE_HPP__
@@ -0,0 +1,181 @@
+#ifndef __UT_ROBOT_G1_LOCO_MOCK_SERVER_HPP__
+#define __UT_ROBOT_G1_LOCO_MOCK_SERVER_HPP__
+
+#include <unitree/robot/go2/public/jsonize_type.hpp>
+#include <unitree/robot/server/mock_server.hpp>
+
+#include "g1_loco_api.hpp"
+
+namespace unitree {
+namespace robot {
+namespace g1 {
+/*
+ * LocoMockServer
+ *
+ * Keeps what the setters of LocoClient write and returns it from the
+ * getters. The fsm mode stays 0, the deprecated phase is two zeros.
+ */
+class LocoMockServer : public MockServer {
+ public:
+  explicit LocoMockServer(const MockServerParam &param = MockServerParam())
+      : MockServer(LOCO_SERVICE_NAME, param) {}
+  ~LocoMockServer() {}
+
+  void Init() {
+    SetApiVersion(LOCO_API_VERSION);
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_GET_FSM_ID, &LocoMockServer::GetFsmId);
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_GET_FSM_MODE, &LocoMockServer::GetFsmMode);
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_GET_BALANCE_MODE, &LocoMockServer::GetBalanceMode);
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_GET_SWING_HEIGHT, &LocoMockServer::GetSwingHeight);
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_GET_STAND_HEIGHT, &LocoMockServer::GetStandHeight);
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_GET_PHASE, &LocoMockServer::GetPhase);
+
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_SET_FSM_ID, &LocoMockServer::SetFsmId);
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_SET_BALANCE_MODE, &LocoMockServer::SetBalanceMode);
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_SET_SWING_HEIGHT, &LocoMockServer::SetSwingHeight);
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_SET_STAND_HEIGHT, &LocoMockServer::SetStandHeight);
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_SET_VELOCITY, &LocoMockServer::SetVelocity);
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_SET_ARM_TASK, &LocoMockServer::SetArmTask);
+    UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_API_ID_LOCO_SET_SPEED_MODE, &LocoMockServer::SetSpeedMode);
+  }
+
+  // last velocity command: vx, vy, omega and duration
+  std::array<float, 4> GetVelocity() {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    return velocity_;
+  }
+
+  int GetArmTask() {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    return arm_task_;
+  }
+
+ private:
+  template <typename T>
+  static bool Parse(const std::string &parameter, T &json) {
+    try {
+      common::FromJsonString(parameter, json);
+    } catch (const common::Exception &) {
+      return false;
+    }
+    return true;
+  }
+
+  int32_t GetInt(int value, std::string &data) {
+    go2::JsonizeDataInt json;
+    json.data = value;
+    data = common::ToJsonString(json);
+    return UT_ROBOT_OK;
+  }
+
+  int32_t GetFloat(float value, std::string &data) {
+    go2::JsonizeDataFloat json;
+    json.data = value;
+    data = common::ToJsonString(json);
+    return UT_ROBOT_OK;
+  }
+
+  int32_t GetFsmId(const std::string &, std::string &data) {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    return GetInt(fsm_id_, data);
+  }
+
+  int32_t GetFsmMode(const std::string &, std::string &data) {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    return GetInt(fsm_mode_, data);
+  }
+
+  int32_t GetBalanceMode(const std::string &, std::string &data) {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    return GetInt(balance_mode_, data);
+  }
+
+  int32_t GetSwingHeight(const std::string &, std::string &data) {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    return GetFloat(swing_height_, data);
+  }
+
+  int32_t GetStandHeight(const std::string &, std::string &data) {
+    common::LockGuard<common::Mutex> guard(mutex_);
+    return GetFloat(stand_height_, data);
+  }
+
+  int32_t GetPhase(const std::string &, std::string &data) {
+    JsonizeDataVecFloat json;
+    json.data.assign(2, 0.0f);
+    data = common::ToJsonString(json);
+    return UT_ROBOT_OK;
+  }
+
+  int32_t SetFsmId(const std::string &parameter, std::string &) {
+    go2::JsonizeDataInt json;
+    if (!Parse(parameter, json)) return UT_ROBOT_ERR_SERVER_API_PARAMETER;
+    common::LockGuard<common::Mutex> guard(mutex_);
+    fsm_id_ = json.data;
+    return UT_ROBOT_OK;
+  }
+
+  int32_t SetBalanceMode(const std::string &parameter, std::string &) {
+    go2::JsonizeDataInt json;
+    if (!Parse(parameter, json)) return UT_ROBOT_ERR_SERVER_API_PARAMETER;
+    common::LockGuard<common::Mutex> guard(mutex_);
+    balance_mode_ = json.data;
+    return UT_ROBOT_OK;
+  }
+
+  int32_t SetSwingHeight(const std::string &parameter, std::string &) {
+    go2::JsonizeDataFloat json;
+    if (!Parse(parameter, json)) return UT_ROBOT_ERR_SERVER_API_PARAMETER;
+    common::LockGuard<common::Mutex> guard(mutex_);
+    swing_height_ = json.data;
+    return UT_ROBOT_OK;
+  }
+
+  int32_t SetStandHeight(const std::string &parameter, std::string &) {
+    go2::JsonizeDataFloat json;
+    if (!Parse(parameter, json)) return UT_ROBOT_ERR_SERVER_API_PARAMETER;
+    common::LockGuard<common::Mutex> guard(mutex_);
+    stand_height_ = json.data;
+    return UT_ROBOT_OK;
+  }
+
+  int32_t SetVelocity(const std::string &parameter, std::string &) {
+    JsonizeVelocityCommand json;
+    if (!Parse(parameter, json) || json.velocity.size() != 3) return UT_ROBOT_ERR_SERVER_API_PARAMETER;
+    common::LockGuard<common::Mutex> guard(mutex_);
+    velocity_ = {json.velocity[0], json.velocity[1], json.velocity[2], json.duration};
+    return UT_ROBOT_OK;
+  }
+
+  int32_t SetArmTask(const std::string &parameter, std::string &) {
+    go2::JsonizeDataInt json;
+    if (!Parse(parameter, json)) return UT_ROBOT_ERR_SERVER_API_PARAMETER;
+    common::LockGuard<common::Mutex> guard(mutex_);
+    arm_task_ = json.data;
+    return UT_ROBOT_OK;
+  }
+
+  int32_t SetSpeedMode(const std::string &parameter, std::string &) {
+    go2::JsonizeDataInt json;
+    if (!Parse(parameter, json)) return UT_ROBOT_ERR_SERVER_API_PARAMETER;
+    common::LockGuard<common::Mutex> guard(mutex_);
+    speed_mode_ = json.data;
+    return UT_ROBOT_OK;
+  }
+
+  common::Mutex mutex_;
+  int fsm_id_ = 0;
+  int fsm_mode_ = 0;
+  int balance_mode_ = 0;
+  int speed_mode_ = 0;
+  int arm_task_ = -1;
+  float swing_height_ = 0.0f;
+  float stand_height_ = 0.0f;
+  std::array<float, 4> velocity_ = {};
+};
+
+}  // namespace g1
+}  // namespace robot
+}  // namespace unitree
+
+#endif  // __UT_ROBOT_G1_LOCO_MOCK_SERVER_HPP__
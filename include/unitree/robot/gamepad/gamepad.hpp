@@ -0,0 +1,411 @@
+#ifndef __UT_ROBOT_GAMEPAD_HPP__
+#define __UT_ROBOT_GAMEPAD_HPP__
+
+#include <unitree/common/lock/triple_buffer.hpp>
+#include <unitree/common/time/deadline_timer.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+#include <unitree/idl/go2/WirelessController_.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace unitree
+{
+namespace robot
+{
+const std::string UT_GAMEPAD_TOPIC = "rt/wirelesscontroller";
+
+/*
+ * key bits, same order as the keys field of WirelessController_ and the
+ * key word of LowState_::wireless_remote.
+ */
+enum
+{
+    UT_GAMEPAD_KEY_R1       = 0,
+    UT_GAMEPAD_KEY_L1       = 1,
+    UT_GAMEPAD_KEY_START    = 2,
+    UT_GAMEPAD_KEY_SELECT   = 3,
+    UT_GAMEPAD_KEY_R2       = 4,
+    UT_GAMEPAD_KEY_L2       = 5,
+    UT_GAMEPAD_KEY_F1       = 6,
+    UT_GAMEPAD_KEY_F2       = 7,
+    UT_GAMEPAD_KEY_A        = 8,
+    UT_GAMEPAD_KEY_B        = 9,
+    UT_GAMEPAD_KEY_X        = 10,
+    UT_GAMEPAD_KEY_Y        = 11,
+    UT_GAMEPAD_KEY_UP       = 12,
+    UT_GAMEPAD_KEY_RIGHT    = 13,
+    UT_GAMEPAD_KEY_DOWN     = 14,
+    UT_GAMEPAD_KEY_LEFT     = 15,
+    UT_GAMEPAD_KEY_NUMBER   = 16
+};
+
+/*
+ * byte offsets inside the 40 byte wireless_remote array:
+ * head[2], keys(uint16), lx, rx, ry, l2, ly (float), reserved.
+ */
+const size_t UT_GAMEPAD_REMOTE_SIZE = 40;
+const size_t UT_GAMEPAD_REMOTE_KEYS_OFFSET = 2;
+const size_t UT_GAMEPAD_REMOTE_AXES_OFFSET = 4;
+
+/*
+ * GamepadParam
+ */
+struct GamepadParam
+{
+    /*
+     * stick values with smaller magnitude read as 0.
+     */
+    float deadZone = 0.01f;
+
+    /*
+     * low pass factor per Update, 1 disables smoothing.
+     */
+    float smooth = 0.03f;
+
+    /*
+     * seconds between two presses of one key to count as a double press.
+     */
+    double doublePressInterval = 0.3;
+
+    /*
+     * seconds a key has to stay down to count as held.
+     */
+    double holdTime = 0.5;
+};
+
+/*
+ * GamepadSnapshot
+ *
+ * What the receiving side hands to the reader. Edge counters only grow, the
+ * reader compares them with the values it saw last, so presses shorter than
+ * the reader period are not lost.
+ */
+struct GamepadSnapshot
+{
+    int64_t time = 0;
+    uint16_t keys = 0;
+    float lx = 0.0f;
+    float ly = 0.0f;
+    float rx = 0.0f;
+    float ry = 0.0f;
+    float l2 = 0.0f;
+
+    std::array<uint32_t, UT_GAMEPAD_KEY_NUMBER> pressNumber = {};
+    std::array<uint32_t, UT_GAMEPAD_KEY_NUMBER> releaseNumber = {};
+    std::array<uint32_t, UT_GAMEPAD_KEY_NUMBER> doublePressNumber = {};
+    std::array<int64_t, UT_GAMEPAD_KEY_NUMBER> pressTime = {};
+};
+
+/*
+ * Gamepad
+ *
+ * Decodes WirelessController_ or LowState_::wireless_remote on the subscriber
+ * thread and hands the newest snapshot to one reader thread through a triple
+ * buffer. Only keys and sticks are read from the message, the message itself
+ * is never copied and neither side locks.
+ *
+ * Feed it from exactly one source:
+ *
+ *     // own rt/wirelesscontroller subscriber
+ *     gamepad.InitChannel();
+ *
+ *     // or inside an existing LowState_ handler
+ *     gamepad.Decode(lowstate.wireless_remote());
+ *
+ * then once per control tick:
+ *
+ *     gamepad.Update();
+ *     if (gamepad.OnPress(UT_GAMEPAD_KEY_A)) ...
+ *     vx = gamepad.GetLy();
+ */
+class Gamepad
+{
+public:
+    explicit Gamepad(const GamepadParam& param = GamepadParam()) :
+        mParam(param), mPrevKeys(0), mLx(0.0f), mLy(0.0f), mRx(0.0f), mRy(0.0f), mL2(0.0f),
+        mPressEdge(0), mReleaseEdge(0), mDoublePressEdge(0), mHeld(0), mHoldEdge(0)
+    {}
+
+    ~Gamepad()
+    {
+        CloseChannel();
+    }
+
+    /*
+     * @brief subscribe WirelessController_ and decode it on arrival.
+     */
+    void InitChannel(const std::string& topic = UT_GAMEPAD_TOPIC)
+    {
+        mSubscriberPtr.reset(new ChannelSubscriber<unitree_go::msg::dds_::WirelessController_>(topic));
+        mSubscriberPtr->InitChannel(std::bind(&Gamepad::WirelessControllerHandler, this, std::placeholders::_1), 1);
+    }
+
+    void CloseChannel()
+    {
+        if (mSubscriberPtr)
+        {
+            mSubscriberPtr->CloseChannel();
+            mSubscriberPtr.reset();
+        }
+    }
+
+    /*
+     * @brief handlers for ChannelSubscriber::InitChannel.
+     */
+    void WirelessControllerHandler(const void* message)
+    {
+        Decode(*(const unitree_go::msg::dds_::WirelessController_*)message);
+    }
+
+    template<typename LowState>
+    void LowStateHandler(const void* message)
+    {
+        Decode(((const LowState*)message)->wireless_remote());
+    }
+
+    /*
+     * @brief writer side, publish one message.
+     */
+    void Decode(const unitree_go::msg::dds_::WirelessController_& message)
+    {
+        GamepadSnapshot& snapshot = mSnapshot.GetWriteBuffer();
+        snapshot.lx = message.lx();
+        snapshot.ly = message.ly();
+        snapshot.rx = message.rx();
+        snapshot.ry = message.ry();
+        snapshot.l2 = 0.0f;
+        Publish(snapshot, message.keys());
+    }
+
+    void Decode(const std::array<uint8_t, UT_GAMEPAD_REMOTE_SIZE>& remote)
+    {
+        Decode(remote.data());
+    }
+
+    void Decode(const uint8_t* remote)
+    {
+        uint16_t keys;
+        float axes[5];
+        std::memcpy(&keys, remote + UT_GAMEPAD_REMOTE_KEYS_OFFSET, sizeof(keys));
+        std::memcpy(axes, remote + UT_GAMEPAD_REMOTE_AXES_OFFSET, sizeof(axes));
+
+        GamepadSnapshot& snapshot = mSnapshot.GetWriteBuffer();
+        snapshot.lx = axes[0];
+        snapshot.rx = axes[1];
+        snapshot.ry = axes[2];
+        snapshot.l2 = axes[3];
+        snapshot.ly = axes[4];
+        Publish(snapshot, keys);
+    }
+
+    /*
+     * @brief reader side, take the newest snapshot, filter the sticks and
+     *        compute the key events since the previous Update.
+     * @return true if a new message arrived.
+     */
+    bool Update()
+    {
+        return Update(common::DeadlineTimer::GetClock());
+    }
+
+    bool Update(int64_t now)
+    {
+        const bool fresh = mSnapshot.Update();
+        const GamepadSnapshot& snapshot = mSnapshot.GetReadBuffer();
+
+        mLx = Filter(mLx, snapshot.lx);
+        mLy = Filter(mLy, snapshot.ly);
+        mRx = Filter(mRx, snapshot.rx);
+        mRy = Filter(mRy, snapshot.ry);
+        mL2 = Filter(mL2, snapshot.l2);
+
+        const int64_t holdTime = (int64_t)(mParam.holdTime * 1e9);
+        uint16_t press = 0, release = 0, doublePress = 0, held = 0;
+
+        for (int32_t key = 0; key < UT_GAMEPAD_KEY_NUMBER; key++)
+        {
+            const uint16_t bit = (uint16_t)(1u << key);
+            press |= snapshot.pressNumber[key] != mLast.pressNumber[key] ? bit : 0;
+            release |= snapshot.releaseNumber[key] != mLast.releaseNumber[key] ? bit : 0;
+            doublePress |= snapshot.doublePressNumber[key] != mLast.doublePressNumber[key] ? bit : 0;
+            held |= ((snapshot.keys & bit) && now - snapshot.pressTime[key] >= holdTime) ? bit : 0;
+        }
+
+        mPressEdge = press;
+        mReleaseEdge = release;
+        mDoublePressEdge = doublePress;
+        mHoldEdge = held & ~mHeld;
+        mHeld = held;
+
+        mLast.pressNumber = snapshot.pressNumber;
+        mLast.releaseNumber = snapshot.releaseNumber;
+        mLast.doublePressNumber = snapshot.doublePressNumber;
+        mLast.keys = snapshot.keys;
+        mLast.time = snapshot.time;
+
+        return fresh;
+    }
+
+    /*
+     * key state as of the last Update. OnXXX are true for one Update only.
+     */
+    bool IsPressed(int32_t key) const
+    {
+        return mLast.keys & (1u << key);
+    }
+
+    bool OnPress(int32_t key) const
+    {
+        return mPressEdge & (1u << key);
+    }
+
+    bool OnRelease(int32_t key) const
+    {
+        return mReleaseEdge & (1u << key);
+    }
+
+    bool OnDoublePress(int32_t key) const
+    {
+        return mDoublePressEdge & (1u << key);
+    }
+
+    bool IsHeld(int32_t key) const
+    {
+        return mHeld & (1u << key);
+    }
+
+    bool OnHold(int32_t key) const
+    {
+        return mHoldEdge & (1u << key);
+    }
+
+    uint16_t GetKeys() const
+    {
+        return mLast.keys;
+    }
+
+    /*
+     * filtered sticks. l2 is analog only in wireless_remote, 0 otherwise.
+     */
+    float GetLx() const
+    {
+        return mLx;
+    }
+
+    float GetLy() const
+    {
+        return mLy;
+    }
+
+    float GetRx() const
+    {
+        return mRx;
+    }
+
+    float GetRy() const
+    {
+        return mRy;
+    }
+
+    float GetL2() const
+    {
+        return mL2;
+    }
+
+    /*
+     * @brief receive time (CLOCK_MONOTONIC ns) of the snapshot taken by the
+     *        last Update, 0 before the first message.
+     */
+    int64_t GetTime() const
+    {
+        return mLast.time;
+    }
+
+    /*
+     * reader side filter settings, take effect on the next Update.
+     */
+    void SetDeadZone(float deadZone)
+    {
+        mParam.deadZone = deadZone;
+    }
+
+    void SetSmooth(float smooth)
+    {
+        mParam.smooth = smooth;
+    }
+
+private:
+    void Publish(GamepadSnapshot& snapshot, uint16_t keys)
+    {
+        const int64_t now = common::DeadlineTimer::GetClock();
+        const int64_t doublePressInterval = (int64_t)(mParam.doublePressInterval * 1e9);
+        const uint16_t press = keys & ~mPrevKeys;
+        const uint16_t release = ~keys & mPrevKeys;
+        mPrevKeys = keys;
+
+        for (int32_t key = 0; key < UT_GAMEPAD_KEY_NUMBER; key++)
+        {
+            const uint16_t bit = (uint16_t)(1u << key);
+            if (press & bit)
+            {
+                if (mWriter.pressNumber[key] > 0 && now - mWriter.pressTime[key] <= doublePressInterval)
+                {
+                    mWriter.doublePressNumber[key]++;
+                }
+                mWriter.pressNumber[key]++;
+                mWriter.pressTime[key] = now;
+            }
+            if (release & bit)
+            {
+                mWriter.releaseNumber[key]++;
+            }
+        }
+
+        snapshot.time = now;
+        snapshot.keys = keys;
+        snapshot.pressNumber = mWriter.pressNumber;
+        snapshot.releaseNumber = mWriter.releaseNumber;
+        snapshot.doublePressNumber = mWriter.doublePressNumber;
+        snapshot.pressTime = mWriter.pressTime;
+        mSnapshot.Publish();
+    }
+
+    float Filter(float value, float input) const
+    {
+        input = std::fabs(input) < mParam.deadZone ? 0.0f : input;
+        return value + (input - value) * mParam.smooth;
+    }
+
+private:
+    GamepadParam mParam;
+
+    /*
+     * writer side
+     */
+    uint16_t mPrevKeys;
+    GamepadSnapshot mWriter;
+    common::TripleBuffer<GamepadSnapshot> mSnapshot;
+    std::shared_ptr<ChannelSubscriber<unitree_go::msg::dds_::WirelessController_>> mSubscriberPtr;
+
+    /*
+     * reader side
+     */
+    GamepadSnapshot mLast;
+    float mLx;
+    float mLy;
+    float mRx;
+    float mRy;
+    float mL2;
+    uint16_t mPressEdge;
+    uint16_t mReleaseEdge;
+    uint16_t mDoublePressEdge;
+    uint16_t mHeld;
+    uint16_t mHoldEdge;
+};
+
+}
+}
+
+#endif//__UT_ROBOT_GAMEPAD_HPP__
@@ -0,0 +1,302 @@
+#ifndef __UT_ROBOT_GO2_STATE_ESTIMATOR_HPP__
+#define __UT_ROBOT_GO2_STATE_ESTIMATOR_HPP__
+
+#include <unitree/idl/go2/LowState_.hpp>
+#include <unitree/robot/estimator/imu_preintegrator.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+namespace go2
+{
+/*
+ * leg order of LowState_ motor_state and foot_force
+ */
+enum
+{
+    LEG_FR = 0,
+    LEG_FL = 1,
+    LEG_RR = 2,
+    LEG_RL = 3,
+    LEG_NUMBER = 4
+};
+
+/*
+ * Go2LegKinematics
+ *
+ * Foot position and jacobian of one leg in the body frame, joints are
+ * hip abduction, thigh and calf as ordered in motor_state (3 per leg).
+ */
+class Go2LegKinematics
+{
+public:
+    static constexpr double HIP_X = 0.1934;
+    static constexpr double HIP_Y = 0.0465;
+    static constexpr double HIP_LENGTH = 0.0955;
+    static constexpr double THIGH_LENGTH = 0.213;
+    static constexpr double CALF_LENGTH = 0.213;
+
+    static double SideSign(int32_t leg)
+    {
+        return (leg == LEG_FR || leg == LEG_RR) ? -1.0 : 1.0;
+    }
+
+    static Eigen::Vector3d HipPosition(int32_t leg)
+    {
+        const double x = (leg == LEG_FR || leg == LEG_FL) ? HIP_X : -HIP_X;
+        return Eigen::Vector3d(x, SideSign(leg) * HIP_Y, 0.0);
+    }
+
+    static Eigen::Vector3d FootPosition(int32_t leg, const Eigen::Vector3d& q)
+    {
+        const double l1 = SideSign(leg) * HIP_LENGTH;
+        const double s1 = std::sin(q[0]), c1 = std::cos(q[0]);
+        const double s2 = std::sin(q[1]), c2 = std::cos(q[1]);
+        const double s23 = std::sin(q[1] + q[2]), c23 = std::cos(q[1] + q[2]);
+        const double r = THIGH_LENGTH * c2 + CALF_LENGTH * c23;
+
+        return HipPosition(leg) + Eigen::Vector3d(
+            -THIGH_LENGTH * s2 - CALF_LENGTH * s23,
+            l1 * c1 + r * s1,
+            l1 * s1 - r * c1);
+    }
+
+    static Eigen::Matrix3d FootJacobian(int32_t leg, const Eigen::Vector3d& q)
+    {
+        const double l1 = SideSign(leg) * HIP_LENGTH;
+        const double s1 = std::sin(q[0]), c1 = std::cos(q[0]);
+        const double s2 = std::sin(q[1]), c2 = std::cos(q[1]);
+        const double s23 = std::sin(q[1] + q[2]), c23 = std::cos(q[1] + q[2]);
+        const double r = THIGH_LENGTH * c2 + CALF_LENGTH * c23;
+        const double dr2 = -THIGH_LENGTH * s2 - CALF_LENGTH * s23;
+        const double dr3 = -CALF_LENGTH * s23;
+
+        Eigen::Matrix3d J;
+        J << 0.0, -THIGH_LENGTH * c2 - CALF_LENGTH * c23, -CALF_LENGTH * c23,
+             -l1 * s1 + r * c1, dr2 * s1, dr3 * s1,
+             l1 * c1 + r * s1, -dr2 * c1, -dr3 * c1;
+        return J;
+    }
+};
+
+/*
+ * StateEstimatorParam
+ */
+struct StateEstimatorParam
+{
+    /*
+     * foot_force above which a foot counts as stance.
+     */
+    double footForceThreshold = 20.0;
+
+    /*
+     * per tick correction of the imu predicted velocity toward leg odometry,
+     * and of the height toward the stance feet. 0 disables the correction.
+     */
+    double velocityGain = 0.2;
+    double heightGain = 0.05;
+
+    /*
+     * take attitude from IMUState_ quaternion (onboard filter) instead of
+     * integrating the gyroscope; yaw drifts either way.
+     */
+    bool useImuOrientation = true;
+};
+
+/*
+ * StateEstimator
+ *
+ * Base pose and velocity from LowState_. IMU samples are preintegrated
+ * between control ticks (AddImu at imu rate, or once per Update), the
+ * prediction is corrected with leg odometry from stance feet. World frame
+ * is z up; x and y start at 0 at the first update, z is the height above
+ * the ground under the stance feet, starting at 0 and pulled toward it by
+ * heightGain. No allocation per tick.
+ */
+class StateEstimator
+{
+public:
+    explicit StateEstimator(const StateEstimatorParam& param = StateEstimatorParam()) :
+        mParam(param)
+    {
+        Reset();
+    }
+
+    void Reset()
+    {
+        mInitialized = false;
+        mImuQuaternion.setIdentity();
+        mRotation.setIdentity();
+        mVelocity.setZero();
+        mPosition.setZero();
+        mAngularVelocity.setZero();
+        mLegVelocity.setZero();
+        mContactNumber = 0;
+        for (int32_t i = 0; i < LEG_NUMBER; i++)
+        {
+            mFootPosition[i].setZero();
+            mContact[i] = false;
+        }
+        mIntegrator.Reset();
+    }
+
+    /*
+     * @brief add an imu sample received between control ticks.
+     */
+    void AddImu(const unitree_go::msg::dds_::IMUState_& imu, double dt)
+    {
+        mIntegrator.Integrate(imu, dt);
+        mImuQuaternion = estimator::GetImuQuaternion(imu);
+    }
+
+    /*
+     * @brief control tick. dt is the time since the previous tick, used to
+     *        integrate state.imu_state() when no sample was added by AddImu.
+     */
+    void Update(const unitree_go::msg::dds_::LowState_& state, double dt)
+    {
+        const auto& imu = state.imu_state();
+        if (mIntegrator.GetSampleNumber() == 0)
+        {
+            AddImu(imu, dt);
+        }
+
+        mAngularVelocity = estimator::GetImuGyroscope(imu) - mIntegrator.GetGyroBias();
+
+        if (!mInitialized)
+        {
+            mRotation = mImuQuaternion.toRotationMatrix();
+            mInitialized = true;
+        }
+        else
+        {
+            mIntegrator.Predict(mRotation, mVelocity, mPosition);
+            if (mParam.useImuOrientation)
+            {
+                mRotation = mImuQuaternion.toRotationMatrix();
+            }
+        }
+        mIntegrator.Reset();
+
+        /*
+         * leg odometry, a stance foot is fixed in world:
+         * 0 = v + R (w x p + J dq)
+         */
+        const auto& motor = state.motor_state();
+        Eigen::Vector3d velocitySum = Eigen::Vector3d::Zero();
+        double heightSum = 0.0;
+        mContactNumber = 0;
+
+        for (int32_t leg = 0; leg < LEG_NUMBER; leg++)
+        {
+            const Eigen::Vector3d q(motor[3 * leg].q(), motor[3 * leg + 1].q(), motor[3 * leg + 2].q());
+            const Eigen::Vector3d dq(motor[3 * leg].dq(), motor[3 * leg + 1].dq(), motor[3 * leg + 2].dq());
+
+            mFootPosition[leg] = Go2LegKinematics::FootPosition(leg, q);
+            mContact[leg] = state.foot_force()[leg] > mParam.footForceThreshold;
+
+            if (mContact[leg])
+            {
+                const Eigen::Vector3d footVelocity = mAngularVelocity.cross(mFootPosition[leg])
+                    + Go2LegKinematics::FootJacobian(leg, q) * dq;
+                velocitySum -= mRotation * footVelocity;
+                heightSum -= (mRotation * mFootPosition[leg]).z();
+                mContactNumber++;
+            }
+        }
+
+        if (mContactNumber > 0)
+        {
+            mLegVelocity = velocitySum / mContactNumber;
+            mVelocity += mParam.velocityGain * (mLegVelocity - mVelocity);
+            mPosition.z() += mParam.heightGain * (heightSum / mContactNumber - mPosition.z());
+        }
+    }
+
+    void SetBias(const Eigen::Vector3d& gyroBias, const Eigen::Vector3d& accBias)
+    {
+        mIntegrator.SetBias(gyroBias, accBias);
+    }
+
+    /*
+     * @brief body to world.
+     */
+    Eigen::Quaterniond GetOrientation() const
+    {
+        return Eigen::Quaterniond(mRotation);
+    }
+
+    const Eigen::Matrix3d& GetRotation() const
+    {
+        return mRotation;
+    }
+
+    const Eigen::Vector3d& GetPosition() const
+    {
+        return mPosition;
+    }
+
+    /*
+     * @brief world frame velocity.
+     */
+    const Eigen::Vector3d& GetVelocity() const
+    {
+        return mVelocity;
+    }
+
+    Eigen::Vector3d GetBodyVelocity() const
+    {
+        return mRotation.transpose() * mVelocity;
+    }
+
+    const Eigen::Vector3d& GetAngularVelocity() const
+    {
+        return mAngularVelocity;
+    }
+
+    /*
+     * @brief leg odometry velocity of the last tick, world frame.
+     */
+    const Eigen::Vector3d& GetLegVelocity() const
+    {
+        return mLegVelocity;
+    }
+
+    const Eigen::Vector3d& GetFootPosition(int32_t leg) const
+    {
+        return mFootPosition[leg];
+    }
+
+    bool GetContact(int32_t leg) const
+    {
+        return mContact[leg];
+    }
+
+    int32_t GetContactNumber() const
+    {
+        return mContactNumber;
+    }
+
+private:
+    StateEstimatorParam mParam;
+    estimator::ImuPreintegrator mIntegrator;
+
+    bool mInitialized;
+    Eigen::Quaterniond mImuQuaternion;
+    Eigen::Matrix3d mRotation;
+    Eigen::Vector3d mVelocity;
+    Eigen::Vector3d mPosition;
+    Eigen::Vector3d mAngularVelocity;
+    Eigen::Vector3d mLegVelocity;
+
+    Eigen::Vector3d mFootPosition[LEG_NUMBER];
+    bool mContact[LEG_NUMBER];
+    int32_t mContactNumber;
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_GO2_STATE_ESTIMATOR_HPP__
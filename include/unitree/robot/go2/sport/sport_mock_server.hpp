@@ -0,0 +1,108 @@
+#ifndef __UT_ROBOT_GO2_SPORT_MOCK_SERVER_HPP__
+#define __UT_ROBOT_GO2_SPORT_MOCK_SERVER_HPP__
+
+#include <unitree/robot/server/mock_server.hpp>
+#include <unitree/robot/go2/public/jsonize_type.hpp>
+#include <unitree/robot/go2/sport/sport_api.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+namespace go2
+{
+/*
+ * SportMockServer
+ *
+ * Answers every SportClient api. Motion apis are accepted without doing
+ * anything, the auto recovery flag is kept so AutoRecoverGet reads back
+ * what was set.
+ */
+class SportMockServer : public MockServer
+{
+public:
+    explicit SportMockServer(const MockServerParam& param = MockServerParam()) :
+        MockServer(ROBOT_SPORT_SERVICE_NAME, param), mAutoRecovery(false), mLastApiId(0)
+    {}
+
+    ~SportMockServer()
+    {}
+
+    void Init()
+    {
+        SetApiVersion(ROBOT_SPORT_API_VERSION);
+
+        static const int32_t apiId[] = {
+            ROBOT_SPORT_API_ID_DAMP, ROBOT_SPORT_API_ID_BALANCESTAND, ROBOT_SPORT_API_ID_STOPMOVE,
+            ROBOT_SPORT_API_ID_STANDUP, ROBOT_SPORT_API_ID_STANDDOWN, ROBOT_SPORT_API_ID_RECOVERYSTAND,
+            ROBOT_SPORT_API_ID_EULER, ROBOT_SPORT_API_ID_MOVE, ROBOT_SPORT_API_ID_SIT,
+            ROBOT_SPORT_API_ID_RISESIT, ROBOT_SPORT_API_ID_SPEEDLEVEL, ROBOT_SPORT_API_ID_HELLO,
+            ROBOT_SPORT_API_ID_STRETCH, ROBOT_SPORT_API_ID_CONTENT, ROBOT_SPORT_API_ID_DANCE1,
+            ROBOT_SPORT_API_ID_DANCE2, ROBOT_SPORT_API_ID_SWITCHJOYSTICK, ROBOT_SPORT_API_ID_POSE,
+            ROBOT_SPORT_API_ID_SCRAPE, ROBOT_SPORT_API_ID_FRONTFLIP, ROBOT_SPORT_API_ID_FRONTJUMP,
+            ROBOT_SPORT_API_ID_FRONTPOUNCE, ROBOT_SPORT_API_ID_HEART, ROBOT_SPORT_API_ID_STATICWALK,
+            ROBOT_SPORT_API_ID_TROTRUN, ROBOT_SPORT_API_ID_ECONOMICGAIT, ROBOT_SPORT_API_ID_LEFTFLIP,
+            ROBOT_SPORT_API_ID_BACKFLIP, ROBOT_SPORT_API_ID_HANDSTAND, ROBOT_SPORT_API_ID_FREEWALK,
+            ROBOT_SPORT_API_ID_FREEBOUND, ROBOT_SPORT_API_ID_FREEJUMP, ROBOT_SPORT_API_ID_FREEAVOID,
+            ROBOT_SPORT_API_ID_CLASSICWALK, ROBOT_SPORT_API_ID_WALKUPRIGHT, ROBOT_SPORT_API_ID_CROSSSTEP,
+            ROBOT_SPORT_API_ID_SWITCHAVOIDMODE
+        };
+
+        for (int32_t id : apiId)
+        {
+            UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(id, &SportMockServer::Motion);
+        }
+
+        UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_SPORT_API_ID_AUTORECOVERY_SET, &SportMockServer::AutoRecoverySet);
+        UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(ROBOT_SPORT_API_ID_AUTORECOVERY_GET, &SportMockServer::AutoRecoveryGet);
+    }
+
+    /*
+     * @brief api id of the last motion request handled.
+     */
+    int32_t GetLastApiId() const
+    {
+        return mLastApiId;
+    }
+
+private:
+    int32_t Motion(const std::string&, std::string&)
+    {
+        mLastApiId = GetCurrentApiId();
+        return UT_ROBOT_OK;
+    }
+
+    int32_t AutoRecoverySet(const std::string& parameter, std::string&)
+    {
+        JsonizeDataBool json;
+        try
+        {
+            common::FromJsonString(parameter, json);
+        }
+        catch (const common::Exception&)
+        {
+            return UT_ROBOT_ERR_SERVER_API_PARAMETER;
+        }
+
+        mAutoRecovery = json.data;
+        return UT_ROBOT_OK;
+    }
+
+    int32_t AutoRecoveryGet(const std::string&, std::string& data)
+    {
+        JsonizeDataBool json;
+        json.data = mAutoRecovery;
+        data = common::ToJsonString(json);
+        return UT_ROBOT_OK;
+    }
+
+private:
+    std::atomic<bool> mAutoRecovery;
+    std::atomic<int32_t> mLastApiId;
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_GO2_SPORT_MOCK_SERVER_HPP__
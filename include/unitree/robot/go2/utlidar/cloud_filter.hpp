@@ -0,0 +1,557 @@
+#ifndef __UT_ROBOT_GO2_UTLIDAR_CLOUD_FILTER_HPP__
+#define __UT_ROBOT_GO2_UTLIDAR_CLOUD_FILTER_HPP__
+
+#include <cmath>
+#include <limits>
+#include <atomic>
+#include <cstring>
+#include <algorithm>
+
+#include <unitree/idl/ros2/PointCloud2_.hpp>
+#include <unitree/common/thread/parallel_task.hpp>
+#include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+namespace go2
+{
+/*topic name*/
+const std::string ROBOT_UTLIDAR_CLOUD_TOPIC = "rt/utlidar/cloud";
+const std::string ROBOT_UTLIDAR_CLOUD_FILTERED_TOPIC = "rt/utlidar/cloud_filtered";
+
+/*sensor_msgs/PointField datatype*/
+const uint8_t UT_POINT_FIELD_FLOAT32 = 7;
+
+/*
+ * CloudFilterParam
+ */
+struct CloudFilterParam
+{
+    /*
+     * voxel edge length in meter. voxel filter is disabled when <= 0.
+     */
+    float voxelSize = 0.05f;
+
+    /*
+     * axis aligned region of interest in the cloud frame.
+     */
+    float minX = -std::numeric_limits<float>::infinity();
+    float maxX = std::numeric_limits<float>::infinity();
+    float minY = -std::numeric_limits<float>::infinity();
+    float maxY = std::numeric_limits<float>::infinity();
+    float minZ = -std::numeric_limits<float>::infinity();
+    float maxZ = std::numeric_limits<float>::infinity();
+
+    /*
+     * radial range crop around the cloud frame origin.
+     */
+    float minRange = 0.0f;
+    float maxRange = std::numeric_limits<float>::infinity();
+
+    /*
+     * points with z below ground height are removed as ground.
+     */
+    float groundHeight = -std::numeric_limits<float>::infinity();
+
+    /*
+     * worker threads used by crop and voxel stages (including caller).
+     */
+    uint32_t threadNumber = 1;
+};
+
+/*
+ * CloudFilter
+ *
+ * ROI/range/ground crop followed by a hash based voxel grid filter.
+ * Points are decoded into SoA buffers so the crop and voxel key passes are
+ * straight float loops the compiler vectorizes; voxels are accumulated in
+ * per-thread hash shards, so no merge step or locking is needed.
+ * All buffers are kept between calls and only grow.
+ */
+class CloudFilter
+{
+public:
+    explicit CloudFilter(const CloudFilterParam& param = CloudFilterParam()) :
+        mParam(param), mParallel(param.threadNumber)
+    {
+        mShards.resize(mParallel.GetThreadNumber());
+    }
+
+    ~CloudFilter()
+    {}
+
+    const CloudFilterParam& GetParam() const
+    {
+        return mParam;
+    }
+
+    /*
+     * @brief filter one cloud. out is overwritten and its buffers reused.
+     * @return false if the cloud layout is not supported (no float32 x/y/z or big endian)
+     */
+    bool Filter(const sensor_msgs::msg::dds_::PointCloud2_& in, sensor_msgs::msg::dds_::PointCloud2_& out)
+    {
+        if (!ParseLayout(in))
+        {
+            return false;
+        }
+
+        size_t count = (size_t)in.width() * in.height();
+        if (in.point_step() == 0 || in.data().size() < count * in.point_step())
+        {
+            return false;
+        }
+
+        Crop(in, count);
+
+        if (mParam.voxelSize > 0.0f)
+        {
+            Voxelize();
+        }
+
+        Output(in, out);
+
+        return true;
+    }
+
+private:
+    struct Shard
+    {
+        std::vector<uint64_t> table;
+        std::vector<uint32_t> index;
+        std::vector<uint32_t> slot;
+        std::vector<float> sum;
+        std::vector<uint32_t> number;
+        size_t size = 0;
+    };
+
+    static constexpr uint64_t EMPTY_KEY = ~0ULL;
+    static constexpr int32_t KEY_BITS = 21;
+    static constexpr int32_t KEY_BIAS = 1 << (KEY_BITS - 1);
+
+    /*
+     * @brief voxel coordinate to its key field. Clamped before the cast, an
+     *        unbounded roi lets through coordinates no integer can hold;
+     *        those share the voxels at the edge of the key range.
+     */
+    static uint64_t KeyIndex(float v)
+    {
+        const float index = std::floor(v) + KEY_BIAS;
+        return (uint64_t)std::fmin(std::fmax(index, 0.0f), (float)((1 << KEY_BITS) - 1));
+    }
+
+    bool ParseLayout(const sensor_msgs::msg::dds_::PointCloud2_& in)
+    {
+        if (in.is_bigendian())
+        {
+            return false;
+        }
+
+        int32_t offset[4] = { -1, -1, -1, -1 };
+        static const char* names[4] = { "x", "y", "z", "intensity" };
+
+        for (const auto& field : in.fields())
+        {
+            if (field.datatype() != UT_POINT_FIELD_FLOAT32 || field.offset() + sizeof(float) > in.point_step())
+            {
+                continue;
+            }
+
+            for (int32_t i = 0; i < 4; i++)
+            {
+                if (field.name() == names[i])
+                {
+                    offset[i] = field.offset();
+                }
+            }
+        }
+
+        if (offset[0] < 0 || offset[1] < 0 || offset[2] < 0)
+        {
+            return false;
+        }
+
+        for (int32_t i = 0; i < 4; i++)
+        {
+            mOffset[i] = offset[i];
+        }
+
+        mHasIntensity = offset[3] >= 0;
+
+        return true;
+    }
+
+    static float ReadFloat(const uint8_t* p)
+    {
+        float v;
+        memcpy(&v, p, sizeof(float));
+        return v;
+    }
+
+    void Crop(const sensor_msgs::msg::dds_::PointCloud2_& in, size_t count)
+    {
+        mX.resize(count);
+        mY.resize(count);
+        mZ.resize(count);
+        mI.resize(mHasIntensity ? count : 0);
+
+        mPartEnd.resize(mParallel.GetThreadNumber());
+
+        const uint8_t* data = in.data().data();
+        const size_t step = in.point_step();
+
+        const float minRange2 = mParam.minRange * mParam.minRange;
+        const float maxRange2 = mParam.maxRange * mParam.maxRange;
+        const float minZ = std::max(mParam.minZ, mParam.groundHeight);
+
+        uint32_t partNumber = mParallel.Range(count, [&](uint32_t part, size_t begin, size_t end) {
+            size_t k = begin;
+            for (size_t i = begin; i < end; i++)
+            {
+                const uint8_t* p = data + i * step;
+                float x = ReadFloat(p + mOffset[0]);
+                float y = ReadFloat(p + mOffset[1]);
+                float z = ReadFloat(p + mOffset[2]);
+                float r2 = x * x + y * y + z * z;
+
+                /*
+                 * the default bounds are infinite, so non-finite points are
+                 * rejected explicitly to keep the output dense.
+                 */
+                bool keep = std::isfinite(x) & std::isfinite(y) & std::isfinite(z) &
+                    (x >= mParam.minX) & (x <= mParam.maxX) &
+                    (y >= mParam.minY) & (y <= mParam.maxY) &
+                    (z >= minZ) & (z <= mParam.maxZ) &
+                    (r2 >= minRange2) & (r2 <= maxRange2);
+
+                mX[k] = x;
+                mY[k] = y;
+                mZ[k] = z;
+                if (mHasIntensity)
+                {
+                    mI[k] = ReadFloat(p + mOffset[3]);
+                }
+
+                k += keep;
+            }
+            mPartEnd[part] = k;
+        });
+
+        /*
+         * compact per-part survivors into one contiguous range.
+         */
+        size_t size = mPartEnd[0];
+        const size_t partStep = partNumber > 0 ? (count + partNumber - 1) / partNumber : 0;
+
+        for (uint32_t part = 1; part < partNumber; part++)
+        {
+            size_t begin = std::min(count, partStep * part);
+            size_t n = mPartEnd[part] - begin;
+            if (n > 0 && begin != size)
+            {
+                memmove(&mX[size], &mX[begin], n * sizeof(float));
+                memmove(&mY[size], &mY[begin], n * sizeof(float));
+                memmove(&mZ[size], &mZ[begin], n * sizeof(float));
+                if (mHasIntensity)
+                {
+                    memmove(&mI[size], &mI[begin], n * sizeof(float));
+                }
+            }
+            size += n;
+        }
+
+        mSize = size;
+    }
+
+    void Voxelize()
+    {
+        const size_t count = mSize;
+        const float inv = 1.0f / mParam.voxelSize;
+        const uint32_t shardNumber = (uint32_t)mShards.size();
+
+        mKey.resize(count);
+        mHash.resize(count);
+        mShardId.resize(count);
+        mOrder.resize(count);
+        mShardBegin.assign(shardNumber + 1, 0);
+
+        /*
+         * the shard takes the high bits of the hash, table probing the low
+         * bits, so keys of one shard still spread over its whole table.
+         */
+        mParallel.Range(count, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                uint64_t ix = KeyIndex(mX[i] * inv);
+                uint64_t iy = KeyIndex(mY[i] * inv);
+                uint64_t iz = KeyIndex(mZ[i] * inv);
+                uint64_t key = (ix << (2 * KEY_BITS)) | (iy << KEY_BITS) | iz;
+                uint32_t h = (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32);
+                mKey[i] = key;
+                mHash[i] = h;
+                mShardId[i] = (uint32_t)(((uint64_t)h * shardNumber) >> 32);
+            }
+        });
+
+        /*
+         * partition point indices by shard once, in input order.
+         */
+        for (size_t i = 0; i < count; i++)
+        {
+            mShardBegin[mShardId[i] + 1]++;
+        }
+        for (uint32_t s = 0; s < shardNumber; s++)
+        {
+            mShardBegin[s + 1] += mShardBegin[s];
+        }
+        mShardCursor.assign(mShardBegin.begin(), mShardBegin.end() - 1);
+        for (size_t i = 0; i < count; i++)
+        {
+            mOrder[mShardCursor[mShardId[i]]++] = (uint32_t)i;
+        }
+
+        mParallel.Run(shardNumber, [&](uint32_t s) {
+            Accumulate(mShards[s], mShardBegin[s], mShardBegin[s + 1]);
+        });
+
+        /*
+         * write voxel centroids back into the SoA buffers, shard by shard.
+         */
+        size_t k = 0;
+        const size_t dim = mHasIntensity ? 4 : 3;
+        for (Shard& shard : mShards)
+        {
+            for (size_t v = 0; v < shard.size; v++)
+            {
+                const float* sum = &shard.sum[v * dim];
+                float scale = 1.0f / shard.number[v];
+                mX[k] = sum[0] * scale;
+                mY[k] = sum[1] * scale;
+                mZ[k] = sum[2] * scale;
+                if (mHasIntensity)
+                {
+                    mI[k] = sum[3] * scale;
+                }
+                k++;
+
+                shard.table[shard.slot[v]] = EMPTY_KEY;
+            }
+            shard.size = 0;
+        }
+
+        mSize = k;
+    }
+
+    void Accumulate(Shard& shard, size_t begin, size_t end)
+    {
+        const size_t count = end - begin;
+
+        size_t capacity = 64;
+        while (capacity < 2 * count)
+        {
+            capacity <<= 1;
+        }
+
+        if (shard.table.size() < capacity)
+        {
+            shard.table.assign(capacity, EMPTY_KEY);
+            shard.index.resize(capacity);
+        }
+
+        const size_t mask = shard.table.size() - 1;
+        const size_t dim = mHasIntensity ? 4 : 3;
+
+        /*
+         * index[pos] maps a table position to its voxel, slot[v] maps a voxel
+         * back to its table position so only used entries are reset later.
+         */
+        if (shard.number.size() < count)
+        {
+            shard.number.resize(count);
+            shard.slot.resize(count);
+        }
+        if (shard.sum.size() < count * dim)
+        {
+            shard.sum.resize(count * dim);
+        }
+
+        size_t size = 0;
+        for (size_t n = begin; n < end; n++)
+        {
+            const size_t i = mOrder[n];
+            const uint64_t key = mKey[i];
+            size_t pos = mHash[i] & mask;
+            while (shard.table[pos] != EMPTY_KEY && shard.table[pos] != key)
+            {
+                pos = (pos + 1) & mask;
+            }
+
+            uint32_t v;
+            if (shard.table[pos] == EMPTY_KEY)
+            {
+                shard.table[pos] = key;
+                v = (uint32_t)size++;
+                shard.index[pos] = v;
+                shard.slot[v] = (uint32_t)pos;
+                shard.number[v] = 0;
+                std::fill_n(&shard.sum[v * dim], dim, 0.0f);
+            }
+            else
+            {
+                v = shard.index[pos];
+            }
+
+            float* sum = &shard.sum[v * dim];
+            sum[0] += mX[i];
+            sum[1] += mY[i];
+            sum[2] += mZ[i];
+            if (mHasIntensity)
+            {
+                sum[3] += mI[i];
+            }
+            shard.number[v]++;
+        }
+
+        shard.size = size;
+    }
+
+    void Output(const sensor_msgs::msg::dds_::PointCloud2_& in, sensor_msgs::msg::dds_::PointCloud2_& out)
+    {
+        const uint32_t dim = mHasIntensity ? 4 : 3;
+        const uint32_t step = dim * sizeof(float);
+
+        auto& fields = out.fields();
+        if (fields.size() != dim)
+        {
+            static const char* names[4] = { "x", "y", "z", "intensity" };
+            fields.resize(dim);
+            for (uint32_t i = 0; i < dim; i++)
+            {
+                fields[i].name(names[i]);
+                fields[i].offset(i * sizeof(float));
+                fields[i].datatype(UT_POINT_FIELD_FLOAT32);
+                fields[i].count(1);
+            }
+        }
+
+        out.header(in.header());
+        out.height(1);
+        out.width((uint32_t)mSize);
+        out.is_bigendian(false);
+        out.point_step(step);
+        out.row_step(step * (uint32_t)mSize);
+        out.is_dense(true);
+
+        auto& data = out.data();
+        data.resize(mSize * step);
+
+        float* dst = (float*)data.data();
+        for (size_t i = 0; i < mSize; i++)
+        {
+            dst[0] = mX[i];
+            dst[1] = mY[i];
+            dst[2] = mZ[i];
+            if (mHasIntensity)
+            {
+                dst[3] = mI[i];
+            }
+            dst += dim;
+        }
+    }
+
+private:
+    CloudFilterParam mParam;
+    common::ParallelTask mParallel;
+
+    int32_t mOffset[4] = { 0, 0, 0, 0 };
+    bool mHasIntensity = false;
+
+    size_t mSize = 0;
+    std::vector<float> mX, mY, mZ, mI;
+    std::vector<size_t> mPartEnd;
+
+    std::vector<uint64_t> mKey;
+    std::vector<uint32_t> mHash;
+    std::vector<uint32_t> mShardId;
+    std::vector<uint32_t> mOrder;
+    std::vector<size_t> mShardBegin;
+    std::vector<size_t> mShardCursor;
+    std::vector<Shard> mShards;
+};
+
+/*
+ * CloudFilterStage
+ *
+ * Subscribe the raw utlidar cloud, filter it once and republish the reduced
+ * cloud, so downstream processes share one filtered stream. The reader queue
+ * length is 1, so a slow filter drops stale clouds instead of lagging behind.
+ */
+class CloudFilterStage
+{
+public:
+    explicit CloudFilterStage(const CloudFilterParam& param = CloudFilterParam(),
+        const std::string& inputTopic = ROBOT_UTLIDAR_CLOUD_TOPIC,
+        const std::string& outputTopic = ROBOT_UTLIDAR_CLOUD_FILTERED_TOPIC) :
+        mFilter(param), mSubscriber(inputTopic), mPublisher(outputTopic),
+        mInputCount(0), mOutputCount(0)
+    {}
+
+    ~CloudFilterStage()
+    {
+        Stop();
+    }
+
+    void Start()
+    {
+        mPublisher.InitChannel();
+        mSubscriber.InitChannel(std::bind(&CloudFilterStage::CloudHandler, this, std::placeholders::_1), 1);
+    }
+
+    void Stop()
+    {
+        mSubscriber.CloseChannel();
+        mPublisher.CloseChannel();
+    }
+
+    uint64_t GetInputCount() const
+    {
+        return mInputCount;
+    }
+
+    uint64_t GetOutputCount() const
+    {
+        return mOutputCount;
+    }
+
+private:
+    void CloudHandler(const void* message)
+    {
+        mInputCount++;
+
+        const auto& cloud = *(const sensor_msgs::msg::dds_::PointCloud2_*)message;
+        if (mFilter.Filter(cloud, mOutput) && mPublisher.Write(mOutput))
+        {
+            mOutputCount++;
+        }
+    }
+
+private:
+    CloudFilter mFilter;
+    ChannelSubscriber<sensor_msgs::msg::dds_::PointCloud2_> mSubscriber;
+    ChannelPublisher<sensor_msgs::msg::dds_::PointCloud2_> mPublisher;
+    sensor_msgs::msg::dds_::PointCloud2_ mOutput;
+
+    std::atomic<uint64_t> mInputCount;
+    std::atomic<uint64_t> mOutputCount;
+};
+
+using CloudFilterStagePtr = std::shared_ptr<CloudFilterStage>;
+
+}
+}
+}
+
+#endif//__UT_ROBOT_GO2_UTLIDAR_CLOUD_FILTER_HPP__
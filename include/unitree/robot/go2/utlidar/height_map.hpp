@@ -0,0 +1,497 @@
+#ifndef __UT_ROBOT_GO2_UTLIDAR_HEIGHT_MAP_HPP__
+#define __UT_ROBOT_GO2_UTLIDAR_HEIGHT_MAP_HPP__
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include <unitree/idl/go2/HeightMap_.hpp>
+#include <unitree/common/thread/parallel_task.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+namespace go2
+{
+/*topic name*/
+const std::string ROBOT_UTLIDAR_HEIGHT_MAP_TOPIC = "rt/utlidar/height_map_array";
+
+/*
+ * HeightMapParam
+ */
+struct HeightMapParam
+{
+    /*
+     * cells at or above this height (or NaN) are unknown.
+     */
+    float unknownHeight = 1.0e9f;
+
+    /*
+     * half window in cells for roughness and max step, window is 2r+1.
+     */
+    uint32_t windowRadius = 1;
+
+    /*
+     * traversability cost saturates at these limits.
+     * slope in rad, step and roughness in meter.
+     */
+    float maxSlope = 0.5f;
+    float maxStep = 0.15f;
+    float maxRoughness = 0.05f;
+
+    /*
+     * pyramid levels after the full resolution level, 2x2 max pooled.
+     */
+    uint32_t pyramidLevels = 3;
+
+    /*
+     * worker threads (including caller), rows are split between them.
+     */
+    uint32_t threadNumber = 1;
+};
+
+/*
+ * HeightMapLayer
+ * row major float grid, data[y * width + x]. NaN marks unknown cells.
+ */
+struct HeightMapLayer
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    float resolution = 0.0f;
+    std::vector<float> data;
+
+    float At(uint32_t x, uint32_t y) const
+    {
+        return data[(size_t)y * width + x];
+    }
+
+    void Resize(uint32_t w, uint32_t h, float res)
+    {
+        width = w;
+        height = h;
+        resolution = res;
+        data.resize((size_t)w * h);
+    }
+};
+
+/*
+ * HeightMapProcessor
+ *
+ * Derives per-cell slope (Sobel gradient), roughness (local standard
+ * deviation around the window mean), max step (local max - min) and a
+ * [0, 1] traversability cost from HeightMap_, plus a max pooled pyramid.
+ * Every kernel is written so its inner loop walks contiguous columns and is
+ * auto-vectorized, separable where the kernel allows; rows are split
+ * across threads. Layers keep their storage
+ * between frames and only grow.
+ */
+class HeightMapProcessor
+{
+public:
+    explicit HeightMapProcessor(const HeightMapParam& param = HeightMapParam()) :
+        mParam(param), mParallel(param.threadNumber)
+    {
+        mPyramid.resize(mParam.pyramidLevels + 1);
+    }
+
+    ~HeightMapProcessor()
+    {}
+
+    const HeightMapParam& GetParam() const
+    {
+        return mParam;
+    }
+
+    /*
+     * @brief process one height map.
+     * @return false if data size does not match width * height or the
+     *         resolution is not a positive finite number.
+     */
+    bool Update(const unitree_go::msg::dds_::HeightMap_& msg)
+    {
+        const uint32_t w = msg.width(), h = msg.height();
+        const float res = msg.resolution();
+        if (w == 0 || h == 0 || msg.data().size() != (size_t)w * h || !(res > 0.0f) || !std::isfinite(res))
+        {
+            return false;
+        }
+
+        mStamp = msg.stamp();
+        mOrigin = msg.origin();
+
+        for (HeightMapLayer* layer : { &mPyramid[0], &mSlope, &mRoughness, &mStep, &mCost })
+        {
+            layer->Resize(w, h, res);
+        }
+
+        const size_t n = (size_t)w * h;
+        mValid.resize(n);
+        mValue.resize(n);
+        mTemp.resize(n);
+        mTemp2.resize(n);
+        mTemp3.resize(n);
+        mMean.resize(n);
+        mVariance.resize(n);
+        mCount.resize(n);
+
+        LoadHeight(msg.data().data(), w, h);
+        ComputeSlope(w, h, res);
+        ComputeWindow(w, h);
+        ComputeCost(n);
+        BuildPyramid();
+
+        return true;
+    }
+
+    double GetStamp() const
+    {
+        return mStamp;
+    }
+
+    const std::array<float, 2>& GetOrigin() const
+    {
+        return mOrigin;
+    }
+
+    /*
+     * @brief height with unknown cells as NaN, same as GetLevel(0).
+     */
+    const HeightMapLayer& GetHeight() const
+    {
+        return mPyramid[0];
+    }
+
+    const HeightMapLayer& GetSlope() const
+    {
+        return mSlope;
+    }
+
+    const HeightMapLayer& GetRoughness() const
+    {
+        return mRoughness;
+    }
+
+    const HeightMapLayer& GetMaxStep() const
+    {
+        return mStep;
+    }
+
+    /*
+     * @brief 0 is flat ground, 1 is not traversable or unknown.
+     */
+    const HeightMapLayer& GetCost() const
+    {
+        return mCost;
+    }
+
+    size_t GetLevelNumber() const
+    {
+        return mPyramid.size();
+    }
+
+    const HeightMapLayer& GetLevel(size_t level) const
+    {
+        return mPyramid.at(level);
+    }
+
+private:
+    void LoadHeight(const float* src, uint32_t w, uint32_t h)
+    {
+        float* height = mPyramid[0].data.data();
+        const float unknown = mParam.unknownHeight;
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+
+        mParallel.Range(h, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t i = begin * w; i < end * w; i++)
+            {
+                const float v = src[i];
+                const bool valid = v < unknown;
+                height[i] = valid ? v : nan;
+                mValid[i] = valid ? 1.0f : 0.0f;
+                mValue[i] = valid ? v : 0.0f;
+            }
+        });
+    }
+
+    void ComputeSlope(uint32_t w, uint32_t h, float res)
+    {
+        const float* height = mPyramid[0].data.data();
+        float* slope = mSlope.data.data();
+        const float scale = 1.0f / (8.0f * res);
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+
+        mParallel.Range(h, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t y = begin; y < end; y++)
+            {
+                float* out = slope + y * w;
+                if (y == 0 || y + 1 >= h || w < 3)
+                {
+                    std::fill_n(out, w, nan);
+                    continue;
+                }
+
+                const float* r0 = height + (y - 1) * w;
+                const float* r1 = height + y * w;
+                const float* r2 = height + (y + 1) * w;
+
+                out[0] = nan;
+                out[w - 1] = nan;
+                for (size_t x = 1; x + 1 < w; x++)
+                {
+                    float gx = (r0[x + 1] + 2.0f * r1[x + 1] + r2[x + 1]) - (r0[x - 1] + 2.0f * r1[x - 1] + r2[x - 1]);
+                    float gy = (r2[x - 1] + 2.0f * r2[x] + r2[x + 1]) - (r0[x - 1] + 2.0f * r0[x] + r0[x + 1]);
+                    gx *= scale;
+                    gy *= scale;
+                    out[x] = std::atan(std::sqrt(gx * gx + gy * gy));
+                }
+            }
+        });
+    }
+
+    /*
+     * @brief separable window pass along x, clipped at the borders.
+     */
+    template<typename Op>
+    void PassX(const float* src, float* dst, uint32_t w, uint32_t h, const Op& op)
+    {
+        const int32_t r = (int32_t)mParam.windowRadius;
+
+        mParallel.Range(h, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t y = begin; y < end; y++)
+            {
+                const float* in = src + y * w;
+                float* out = dst + y * w;
+                std::copy_n(in, w, out);
+                for (int32_t d = 1; d <= r; d++)
+                {
+                    for (int32_t x = 0; x + d < (int32_t)w; x++)
+                    {
+                        out[x] = op(out[x], in[x + d]);
+                    }
+                    for (int32_t x = d; x < (int32_t)w; x++)
+                    {
+                        out[x] = op(out[x], in[x - d]);
+                    }
+                }
+            }
+        });
+    }
+
+    /*
+     * @brief separable window pass along y, inner loop runs along x.
+     */
+    template<typename Op>
+    void PassY(const float* src, float* dst, uint32_t w, uint32_t h, const Op& op)
+    {
+        const int32_t r = (int32_t)mParam.windowRadius;
+
+        mParallel.Range(h, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t y = begin; y < end; y++)
+            {
+                float* out = dst + y * w;
+                std::copy_n(src + y * w, w, out);
+
+                const size_t y0 = y >= (size_t)r ? y - r : 0;
+                const size_t y1 = std::min((size_t)h - 1, y + r);
+                for (size_t yy = y0; yy <= y1; yy++)
+                {
+                    if (yy == y)
+                    {
+                        continue;
+                    }
+                    const float* in = src + yy * w;
+                    for (size_t x = 0; x < w; x++)
+                    {
+                        out[x] = op(out[x], in[x]);
+                    }
+                }
+            }
+        });
+    }
+
+    void ComputeWindow(uint32_t w, uint32_t h)
+    {
+        auto add = [](float a, float b) { return a + b; };
+        auto min = [](float a, float b) { return b < a ? b : a; };
+        auto max = [](float a, float b) { return b > a ? b : a; };
+
+        /*
+         * roughness: window std deviation of valid h around the window mean
+         */
+        PassX(mValid.data(), mTemp.data(), w, h, add);
+        PassY(mTemp.data(), mCount.data(), w, h, add);
+        PassX(mValue.data(), mTemp.data(), w, h, add);
+        PassY(mTemp.data(), mMean.data(), w, h, add);
+        ComputeVariance(w, h);
+
+        /*
+         * max step: window max - min, unknown cells do not take part
+         */
+        const size_t n = (size_t)w * h;
+        const float inf = std::numeric_limits<float>::infinity();
+        const float* height = mPyramid[0].data.data();
+        for (size_t i = 0; i < n; i++)
+        {
+            const bool valid = mValid[i] > 0.0f;
+            mTemp2[i] = valid ? height[i] : inf;
+            mTemp3[i] = valid ? height[i] : -inf;
+        }
+
+        PassX(mTemp2.data(), mTemp.data(), w, h, min);
+        PassY(mTemp.data(), mTemp2.data(), w, h, min);
+        PassX(mTemp3.data(), mTemp.data(), w, h, max);
+        PassY(mTemp.data(), mTemp3.data(), w, h, max);
+
+        float* rough = mRoughness.data.data();
+        float* step = mStep.data.data();
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+
+        mParallel.Range(h, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t i = begin * w; i < end * w; i++)
+            {
+                const bool valid = mValid[i] > 0.0f;
+                rough[i] = valid ? std::sqrt(mVariance[i]) : nan;
+                step[i] = valid ? mTemp3[i] - mTemp2[i] : nan;
+            }
+        });
+    }
+
+    /*
+     * @brief window variance summed from deviations to the window mean. the
+     *        sum of h^2 minus the squared sum cancels in float at map frame
+     *        heights, the deviations are small whatever the height.
+     */
+    void ComputeVariance(uint32_t w, uint32_t h)
+    {
+        const int32_t r = (int32_t)mParam.windowRadius;
+
+        mParallel.Range(h, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t y = begin; y < end; y++)
+            {
+                const float* count = mCount.data() + y * w;
+                float* mean = mMean.data() + y * w;
+                float* var = mVariance.data() + y * w;
+
+                for (size_t x = 0; x < w; x++)
+                {
+                    mean[x] = count[x] > 0.0f ? mean[x] / count[x] : 0.0f;
+                    var[x] = 0.0f;
+                }
+
+                const size_t y0 = y >= (size_t)r ? y - r : 0;
+                const size_t y1 = std::min((size_t)h - 1, y + r);
+                for (size_t yy = y0; yy <= y1; yy++)
+                {
+                    const float* value = mValue.data() + yy * w;
+                    const float* valid = mValid.data() + yy * w;
+                    for (int32_t d = -r; d <= r; d++)
+                    {
+                        const int32_t x0 = std::max(0, -d);
+                        const int32_t x1 = std::min((int32_t)w, (int32_t)w - d);
+                        for (int32_t x = x0; x < x1; x++)
+                        {
+                            const float dev = value[x + d] - mean[x];
+                            var[x] += valid[x + d] * dev * dev;
+                        }
+                    }
+                }
+
+                for (size_t x = 0; x < w; x++)
+                {
+                    var[x] = count[x] > 0.0f ? var[x] / count[x] : 0.0f;
+                }
+            }
+        });
+    }
+
+    void ComputeCost(size_t n)
+    {
+        const float* slope = mSlope.data.data();
+        const float* rough = mRoughness.data.data();
+        const float* step = mStep.data.data();
+        float* cost = mCost.data.data();
+
+        const float invSlope = 1.0f / mParam.maxSlope;
+        const float invStep = 1.0f / mParam.maxStep;
+        const float invRough = 1.0f / mParam.maxRoughness;
+
+        for (size_t i = 0; i < n; i++)
+        {
+            /*
+             * unknown cells and cells with an unknown term cost 1. std::max
+             * drops a NaN in its second argument, so test every term; the
+             * slope stencil skips the center cell and is finite around a hole.
+             */
+            if (mValid[i] <= 0.0f || std::isnan(slope[i]) || std::isnan(step[i]) || std::isnan(rough[i]))
+            {
+                cost[i] = 1.0f;
+                continue;
+            }
+
+            float c = std::max(std::max(slope[i] * invSlope, step[i] * invStep), rough[i] * invRough);
+            cost[i] = std::min(c, 1.0f);
+        }
+    }
+
+    void BuildPyramid()
+    {
+        for (size_t level = 1; level < mPyramid.size(); level++)
+        {
+            const HeightMapLayer& src = mPyramid[level - 1];
+            HeightMapLayer& dst = mPyramid[level];
+
+            const uint32_t w = std::max(1u, (src.width + 1) / 2);
+            const uint32_t h = std::max(1u, (src.height + 1) / 2);
+            dst.Resize(w, h, src.resolution * 2.0f);
+
+            mParallel.Range(h, [&](uint32_t, size_t begin, size_t end) {
+                for (size_t y = begin; y < end; y++)
+                {
+                    const size_t y0 = 2 * y;
+                    const size_t y1 = std::min((size_t)src.height - 1, y0 + 1);
+                    const float* r0 = src.data.data() + y0 * src.width;
+                    const float* r1 = src.data.data() + y1 * src.width;
+                    float* out = dst.data.data() + y * w;
+
+                    for (size_t x = 0; x < w; x++)
+                    {
+                        const size_t x0 = 2 * x;
+                        const size_t x1 = std::min((size_t)src.width - 1, x0 + 1);
+
+                        /*
+                         * fmax drops NaN, so a block is unknown only if all four cells are
+                         */
+                        out[x] = std::fmax(std::fmax(r0[x0], r0[x1]), std::fmax(r1[x0], r1[x1]));
+                    }
+                }
+            });
+        }
+    }
+
+private:
+    HeightMapParam mParam;
+    common::ParallelTask mParallel;
+
+    double mStamp = 0.0;
+    std::array<float, 2> mOrigin = { { 0.0f, 0.0f } };
+
+    std::vector<HeightMapLayer> mPyramid;
+    HeightMapLayer mSlope;
+    HeightMapLayer mRoughness;
+    HeightMapLayer mStep;
+    HeightMapLayer mCost;
+
+    std::vector<float> mValid, mValue;
+    std::vector<float> mTemp, mTemp2, mTemp3;
+    std::vector<float> mMean, mVariance, mCount;
+};
+
+using HeightMapProcessorPtr = std::shared_ptr<HeightMapProcessor>;
+
+}
+}
+}
+
+#endif//__UT_ROBOT_GO2_UTLIDAR_HEIGHT_MAP_HPP__
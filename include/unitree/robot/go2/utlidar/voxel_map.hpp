@@ -0,0 +1,503 @@
+#ifndef __UT_ROBOT_GO2_UTLIDAR_VOXEL_MAP_HPP__
+#define __UT_ROBOT_GO2_UTLIDAR_VOXEL_MAP_HPP__
+
+#include <cmath>
+#include <array>
+#include <cstdint>
+#include <algorithm>
+
+#include <unitree/idl/go2/VoxelMapCompressed_.hpp>
+#include <unitree/common/decl.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+namespace go2
+{
+/*topic name*/
+const std::string ROBOT_UTLIDAR_VOXEL_MAP_TOPIC = "rt/utlidar/voxel_map_compressed";
+
+/*
+ * one byte of an LZ4 block decodes to at most 255 bytes.
+ */
+const uint64_t UT_LZ4_MAX_RATIO = 255;
+
+/*
+ * @brief decode one LZ4 block (no frame header) into dst.
+ * @return decoded size, or -1 if the block is corrupt or does not fit dst.
+ */
+inline int64_t Lz4DecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+{
+    const uint8_t* ip = src;
+    const uint8_t* const ipEnd = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* const opEnd = dst + dstCapacity;
+
+    while (ip < ipEnd)
+    {
+        const uint32_t token = *ip++;
+
+        size_t literal = token >> 4;
+        if (literal == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= ipEnd)
+                {
+                    return -1;
+                }
+                b = *ip++;
+                literal += b;
+            } while (b == 255);
+        }
+
+        if ((size_t)(ipEnd - ip) < literal || (size_t)(opEnd - op) < literal)
+        {
+            return -1;
+        }
+
+        memcpy(op, ip, literal);
+        ip += literal;
+        op += literal;
+
+        /*
+         * last sequence carries literals only
+         */
+        if (ip >= ipEnd)
+        {
+            break;
+        }
+
+        if (ipEnd - ip < 2)
+        {
+            return -1;
+        }
+
+        const size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+
+        if (offset == 0 || offset > (size_t)(op - dst))
+        {
+            return -1;
+        }
+
+        size_t match = token & 15;
+        if (match == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= ipEnd)
+                {
+                    return -1;
+                }
+                b = *ip++;
+                match += b;
+            } while (b == 255);
+        }
+        match += 4;
+
+        if ((size_t)(opEnd - op) < match)
+        {
+            return -1;
+        }
+
+        const uint8_t* ref = op - offset;
+        if (offset >= match)
+        {
+            memcpy(op, ref, match);
+            op += match;
+        }
+        else
+        {
+            /*
+             * overlapped copy repeats the last offset bytes
+             */
+            for (size_t i = 0; i < match; i++)
+            {
+                *op++ = *ref++;
+            }
+        }
+    }
+
+    return op - dst;
+}
+
+/*
+ * VoxelMap
+ *
+ * Bit packed occupancy grid decoded from VoxelMapCompressed_.
+ * The decompressed payload is one bit per voxel, LSB first, x fastest then
+ * y then z, which is kept as is: the LZ4 block is decoded straight into the
+ * grid words, so an update is a single pass with no per-voxel work.
+ *
+ * The previous grid is kept in a second buffer. When consecutive maps share
+ * geometry, Update() diffs them word by word so consumers can apply only the
+ * changed voxels instead of rebuilding from the whole map. Buffers are
+ * swapped, not reallocated, once they reach the map size.
+ */
+class VoxelMap
+{
+public:
+    explicit VoxelMap() :
+        mStamp(0.0), mResolution(0.0), mOrigin{ { 0.0, 0.0, 0.0 } }, mWidth{ { 0, 0, 0 } },
+        mVoxelNumber(0), mGeometryChanged(true), mChangedNumber(0)
+    {}
+
+    ~VoxelMap()
+    {}
+
+    /*
+     * @brief decode msg into the grid.
+     * @return false for an empty grid, a src_size that does not fit the grid
+     *         or the payload, or a payload that can not be decoded; the grid
+     *         is left untouched.
+     */
+    bool Update(const unitree_go::msg::dds_::VoxelMapCompressed_& msg)
+    {
+        const auto& width = msg.width();
+        const uint64_t voxelNumber = (uint64_t)width[0] * width[1] * width[2];
+        const uint64_t byteNumber = (voxelNumber + 7) / 8;
+        const uint64_t srcSize = msg.src_size();
+
+        if (voxelNumber == 0 || msg.resolution() <= 0.0)
+        {
+            return false;
+        }
+
+        /*
+         * src_size is checked before it sizes anything: it has to hold the
+         * grid, end in the grid's last word and be reachable from the payload.
+         */
+        if (srcSize < byteNumber || srcSize > (voxelNumber + 63) / 64 * 8 ||
+            srcSize > (uint64_t)msg.data().size() * UT_LZ4_MAX_RATIO)
+        {
+            return false;
+        }
+
+        const size_t wordNumber = (srcSize + 7) / 8;
+        mNextWords.resize(wordNumber);
+        mNextWords.back() = 0;
+
+        uint8_t* dst = (uint8_t*)mNextWords.data();
+
+        /*
+         * the message has no flag for an uncompressed payload, and an LZ4
+         * block may be exactly src_size long, so a payload of src_size bytes
+         * is only taken as raw bits when it does not decode to src_size.
+         */
+        if (Lz4DecompressBlock(msg.data().data(), msg.data().size(), dst, srcSize) != (int64_t)srcSize)
+        {
+            if (msg.data().size() != srcSize)
+            {
+                return false;
+            }
+
+            memcpy(dst, msg.data().data(), srcSize);
+        }
+
+        /*
+         * clear padding bits past the last voxel so popcount stays exact
+         */
+        const size_t usedWords = (size_t)((voxelNumber + 63) / 64);
+        mNextWords.resize(usedWords);
+        if (voxelNumber % 64)
+        {
+            mNextWords.back() &= (1ULL << (voxelNumber % 64)) - 1;
+        }
+
+        mGeometryChanged = mWidth != width || mResolution != msg.resolution() || mOrigin != msg.origin();
+
+        mWords.swap(mNextWords);
+
+        mStamp = msg.stamp();
+        mFrameId = msg.frame_id();
+        mResolution = msg.resolution();
+        mOrigin = msg.origin();
+        mWidth = width;
+        mVoxelNumber = voxelNumber;
+
+        ComputeDiff();
+
+        return true;
+    }
+
+    double GetStamp() const
+    {
+        return mStamp;
+    }
+
+    const std::string& GetFrameId() const
+    {
+        return mFrameId;
+    }
+
+    double GetResolution() const
+    {
+        return mResolution;
+    }
+
+    const std::array<double, 3>& GetOrigin() const
+    {
+        return mOrigin;
+    }
+
+    const std::array<uint16_t, 3>& GetWidth() const
+    {
+        return mWidth;
+    }
+
+    uint64_t GetVoxelNumber() const
+    {
+        return mVoxelNumber;
+    }
+
+    const std::vector<uint64_t>& GetWords() const
+    {
+        return mWords;
+    }
+
+    /*
+     * @brief true if the last update changed size, resolution or origin,
+     *        the diff then covers the whole grid.
+     */
+    bool IsGeometryChanged() const
+    {
+        return mGeometryChanged;
+    }
+
+    /*
+     * @brief number of voxels whose occupancy changed in the last update.
+     */
+    uint64_t GetChangedNumber() const
+    {
+        return mChangedNumber;
+    }
+
+    bool IsInside(int32_t x, int32_t y, int32_t z) const
+    {
+        return x >= 0 && y >= 0 && z >= 0 && x < mWidth[0] && y < mWidth[1] && z < mWidth[2];
+    }
+
+    bool IsOccupied(int32_t x, int32_t y, int32_t z) const
+    {
+        if (!IsInside(x, y, z))
+        {
+            return false;
+        }
+
+        const uint64_t i = Index(x, y, z);
+        return (mWords[i >> 6] >> (i & 63)) & 1;
+    }
+
+    /*
+     * @brief world position to voxel index, false if outside the grid.
+     */
+    bool ToVoxel(double px, double py, double pz, int32_t& x, int32_t& y, int32_t& z) const
+    {
+        if (mResolution <= 0.0)
+        {
+            return false;
+        }
+
+        const double vx = (px - mOrigin[0]) / mResolution;
+        const double vy = (py - mOrigin[1]) / mResolution;
+        const double vz = (pz - mOrigin[2]) / mResolution;
+        if (!std::isfinite(vx) || !std::isfinite(vy) || !std::isfinite(vz))
+        {
+            return false;
+        }
+
+        x = ToIndex(vx);
+        y = ToIndex(vy);
+        z = ToIndex(vz);
+
+        return IsInside(x, y, z);
+    }
+
+    bool IsOccupied(double px, double py, double pz) const
+    {
+        int32_t x, y, z;
+        return ToVoxel(px, py, pz, x, y, z) && IsOccupied(x, y, z);
+    }
+
+    void ToPosition(int32_t x, int32_t y, int32_t z, double& px, double& py, double& pz) const
+    {
+        px = mOrigin[0] + (x + 0.5) * mResolution;
+        py = mOrigin[1] + (y + 0.5) * mResolution;
+        pz = mOrigin[2] + (z + 0.5) * mResolution;
+    }
+
+    /*
+     * @brief occupied voxels in the whole grid.
+     */
+    uint64_t CountOccupied() const
+    {
+        uint64_t count = 0;
+        for (uint64_t word : mWords)
+        {
+            count += __builtin_popcountll(word);
+        }
+        return count;
+    }
+
+    /*
+     * @brief occupied voxels in [min, max) box, clamped to the grid.
+     *        each x row is counted with masked word popcounts.
+     */
+    uint64_t CountOccupied(int32_t minX, int32_t minY, int32_t minZ, int32_t maxX, int32_t maxY, int32_t maxZ) const
+    {
+        minX = std::max(minX, 0);
+        minY = std::max(minY, 0);
+        minZ = std::max(minZ, 0);
+        maxX = std::min(maxX, (int32_t)mWidth[0]);
+        maxY = std::min(maxY, (int32_t)mWidth[1]);
+        maxZ = std::min(maxZ, (int32_t)mWidth[2]);
+
+        if (minX >= maxX || minY >= maxY || minZ >= maxZ)
+        {
+            return 0;
+        }
+
+        uint64_t count = 0;
+        for (int32_t z = minZ; z < maxZ; z++)
+        {
+            for (int32_t y = minY; y < maxY; y++)
+            {
+                count += CountBits(Index(minX, y, z), Index(maxX - 1, y, z) + 1);
+            }
+        }
+
+        return count;
+    }
+
+    /*
+     * @brief call func(x, y, z) for every occupied voxel.
+     */
+    template<typename Func>
+    void ForEachOccupied(const Func& func) const
+    {
+        ForEachBit(mWords, func);
+    }
+
+    /*
+     * @brief call func(x, y, z, occupied) for every voxel changed by the last update.
+     */
+    template<typename Func>
+    void ForEachChanged(const Func& func) const
+    {
+        ForEachBit(mDiffWords, [this, &func](int32_t x, int32_t y, int32_t z) {
+            func(x, y, z, IsOccupied(x, y, z));
+        });
+    }
+
+private:
+    /*
+     * @brief clamped before the cast, far points land outside the grid.
+     */
+    static int32_t ToIndex(double v)
+    {
+        const double index = std::floor(v);
+        return (int32_t)std::fmin(std::fmax(index, (double)INT32_MIN), (double)INT32_MAX);
+    }
+
+    uint64_t Index(int32_t x, int32_t y, int32_t z) const
+    {
+        return (uint64_t)x + (uint64_t)mWidth[0] * ((uint64_t)y + (uint64_t)mWidth[1] * z);
+    }
+
+    uint64_t CountBits(uint64_t begin, uint64_t end) const
+    {
+        const uint64_t first = begin >> 6, last = (end - 1) >> 6;
+        const uint64_t headMask = ~0ULL << (begin & 63);
+        const uint64_t tailMask = ~0ULL >> (63 - ((end - 1) & 63));
+
+        if (first == last)
+        {
+            return __builtin_popcountll(mWords[first] & headMask & tailMask);
+        }
+
+        uint64_t count = __builtin_popcountll(mWords[first] & headMask);
+        for (uint64_t w = first + 1; w < last; w++)
+        {
+            count += __builtin_popcountll(mWords[w]);
+        }
+        count += __builtin_popcountll(mWords[last] & tailMask);
+
+        return count;
+    }
+
+    template<typename Func>
+    void ForEachBit(const std::vector<uint64_t>& words, const Func& func) const
+    {
+        const uint64_t planeSize = (uint64_t)mWidth[0] * mWidth[1];
+        for (size_t w = 0; w < words.size(); w++)
+        {
+            uint64_t word = words[w];
+            while (word)
+            {
+                const uint64_t i = ((uint64_t)w << 6) + __builtin_ctzll(word);
+                word &= word - 1;
+
+                const uint64_t z = i / planeSize;
+                const uint64_t r = i - z * planeSize;
+                func((int32_t)(r % mWidth[0]), (int32_t)(r / mWidth[0]), (int32_t)z);
+            }
+        }
+    }
+
+    void ComputeDiff()
+    {
+        mDiffWords.resize(mWords.size());
+
+        uint64_t changed = 0;
+        if (mGeometryChanged || mNextWords.size() != mWords.size())
+        {
+            /*
+             * nothing comparable: every occupied voxel is reported as changed
+             */
+            for (size_t w = 0; w < mWords.size(); w++)
+            {
+                mDiffWords[w] = mWords[w];
+                changed += __builtin_popcountll(mWords[w]);
+            }
+        }
+        else
+        {
+            for (size_t w = 0; w < mWords.size(); w++)
+            {
+                uint64_t diff = mWords[w] ^ mNextWords[w];
+                mDiffWords[w] = diff;
+                changed += __builtin_popcountll(diff);
+            }
+        }
+
+        mGeometryChanged = mGeometryChanged || mNextWords.size() != mWords.size();
+        mChangedNumber = changed;
+    }
+
+private:
+    double mStamp;
+    std::string mFrameId;
+    double mResolution;
+    std::array<double, 3> mOrigin;
+    std::array<uint16_t, 3> mWidth;
+    uint64_t mVoxelNumber;
+
+    bool mGeometryChanged;
+    uint64_t mChangedNumber;
+
+    std::vector<uint64_t> mWords;
+    std::vector<uint64_t> mNextWords;
+    std::vector<uint64_t> mDiffWords;
+};
+
+using VoxelMapPtr = std::shared_ptr<VoxelMap>;
+
+}
+}
+}
+
+#endif//__UT_ROBOT_GO2_UTLIDAR_VOXEL_MAP_HPP__
@@ -0,0 +1,61 @@
+#ifndef __UT_ROBOT_GO2_VIDEO_MOCK_SERVER_HPP__
+#define __UT_ROBOT_GO2_VIDEO_MOCK_SERVER_HPP__
+
+#include <unitree/robot/server/mock_server.hpp>
+#include <unitree/robot/go2/video/video_api.hpp>
+
+#include <algorithm>
+
+namespace unitree
+{
+namespace robot
+{
+namespace go2
+{
+/*
+ * default sample size, about one 1280x720 jpeg of the front camera.
+ */
+const size_t ROBOT_VIDEO_MOCK_SAMPLE_SIZE = 64 * 1024;
+
+/*
+ * VideoMockServer
+ *
+ * GetImageSample returns MockServerParam::payloadSize bytes framed by the
+ * jpeg start and end markers. The body is filler, not a decodable image.
+ */
+class VideoMockServer : public MockServer
+{
+public:
+    explicit VideoMockServer(const MockServerParam& param = MockServerParam()) :
+        MockServer(ROBOT_VIDEO_SERVICE_NAME, param)
+    {}
+
+    ~VideoMockServer()
+    {}
+
+    void Init()
+    {
+        SetApiVersion(ROBOT_VIDEO_API_VERSION);
+        UT_ROBOT_SERVER_REG_API_BINARY_HANDLER_NO_LEASE(ROBOT_VIDEO_API_ID_GETIMAGESAMPLE, &VideoMockServer::GetImageSample);
+    }
+
+private:
+    int32_t GetImageSample(const std::vector<uint8_t>&, std::vector<uint8_t>& data)
+    {
+        const size_t size = std::max(GetPayloadSize(ROBOT_VIDEO_MOCK_SAMPLE_SIZE), (size_t)4);
+
+        data.assign(size, 0);
+        data[0] = 0xFF;
+        data[1] = 0xD8;
+        data[size - 2] = 0xFF;
+        data[size - 1] = 0xD9;
+
+        return UT_ROBOT_OK;
+    }
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_GO2_VIDEO_MOCK_SERVER_HPP__
@@ -0,0 +1,995 @@
+#ifndef __UT_ROBOT_GO2_VIDEO_STREAM_HPP__
+#define __UT_ROBOT_GO2_VIDEO_STREAM_HPP__
+
+#include <unitree/idl/go2/Go2FrontVideoData_.hpp>
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/time/time_tool.hpp>
+#include <unitree/robot/channel/channel_subscriber.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#ifdef UT_VIDEO_ENABLE_JPEG
+#include <csetjmp>
+#include <jpeglib.h>
+#endif//UT_VIDEO_ENABLE_JPEG
+
+#ifdef UT_VIDEO_ENABLE_H264
+extern "C"
+{
+#include <libavcodec/avcodec.h>
+#include <libswscale/swscale.h>
+}
+#endif//UT_VIDEO_ENABLE_H264
+
+namespace unitree
+{
+namespace robot
+{
+namespace go2
+{
+/*topic name*/
+const std::string ROBOT_FRONT_VIDEO_STREAM_TOPIC = "rt/frontvideostream";
+
+/*
+ * streams carried by Go2FrontVideoData_
+ */
+enum VideoResolution
+{
+    VIDEO_RESOLUTION_720P = 0,
+    VIDEO_RESOLUTION_360P = 1,
+    VIDEO_RESOLUTION_180P = 2,
+    VIDEO_RESOLUTION_NUMBER = 3
+};
+
+inline const std::vector<uint8_t>& GetVideoStreamData(const unitree_go::msg::dds_::Go2FrontVideoData_& msg, int32_t resolution)
+{
+    switch (resolution)
+    {
+    case VIDEO_RESOLUTION_720P:
+        return msg.video720p();
+    case VIDEO_RESOLUTION_180P:
+        return msg.video180p();
+    default:
+        return msg.video360p();
+    }
+}
+
+/*
+ * @brief true if an Annex B H.264 access unit holds an IDR slice, where a
+ *        decoder can start or resume without earlier access units.
+ */
+inline bool IsH264Keyframe(const uint8_t* data, size_t size)
+{
+    for (size_t i = 0; i + 3 < size; i++)
+    {
+        if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1)
+        {
+            if ((data[i + 3] & 0x1f) == 5)
+            {
+                return true;
+            }
+            i += 2;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * VideoFrame
+ */
+struct VideoFrame
+{
+    enum
+    {
+        FORMAT_ENCODED = 0,
+        FORMAT_RGB24 = 1,
+        FORMAT_GRAY8 = 2
+    };
+
+    int32_t format = FORMAT_ENCODED;
+    int32_t resolution = VIDEO_RESOLUTION_360P;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t stride = 0;
+
+    /*
+     * time_frame of the source sample and sequence number assigned on receive.
+     */
+    uint64_t stamp = 0;
+    uint64_t sequence = 0;
+
+    /*
+     * monotonic nanosecond when the sample arrived and how long decode took.
+     */
+    uint64_t receiveTime = 0;
+    uint64_t decodeTime = 0;
+
+    std::vector<uint8_t> data;
+};
+
+using VideoFramePtr = std::shared_ptr<const VideoFrame>;
+
+/*
+ * VideoFramePool
+ *
+ * Fixed set of frames allocated up front. A frame is free again once no
+ * consumer holds it, so handing frames out costs a reference count only.
+ */
+class VideoFramePool
+{
+public:
+    explicit VideoFramePool(size_t number)
+    {
+        mFrames.reserve(number);
+        for (size_t i = 0; i < number; i++)
+        {
+            mFrames.emplace_back(new VideoFrame());
+        }
+    }
+
+    /*
+     * @brief a frame nobody else references, or nullptr if all are in use.
+     *        must be called from one thread only.
+     */
+    std::shared_ptr<VideoFrame> Acquire()
+    {
+        for (const std::shared_ptr<VideoFrame>& frame : mFrames)
+        {
+            if (frame.use_count() == 1)
+            {
+                /*
+                 * order the caller's writes after the last consumer's reads,
+                 * the count itself is only loaded relaxed.
+                 */
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return frame;
+            }
+        }
+
+        return std::shared_ptr<VideoFrame>();
+    }
+
+    size_t Size() const
+    {
+        return mFrames.size();
+    }
+
+private:
+    std::vector<std::shared_ptr<VideoFrame>> mFrames;
+};
+
+/*
+ * VideoDecoder
+ *
+ * Decode one encoded sample into frame. Implementations must reuse
+ * frame.data (resize, not reallocate) so steady state decode does not allocate.
+ *
+ * A stateful decoder (inter-frame codecs such as H.264) is given every
+ * sample of the stream in order. When samples had to be dropped or a decode
+ * failed, VideoStream skips to the next sample IsKeyframe accepts and calls
+ * Reset before decoding it; only decoded pictures are dropped otherwise. A switch to
+ * another Go2FrontVideoData_ stream is handled the same way, at a keyframe
+ * of the new stream after Reset, so one decoder serves all resolutions. A
+ * stateless decoder may be handed any sample, VideoStream then keeps the
+ * newest only.
+ */
+class VideoDecoder
+{
+public:
+    virtual ~VideoDecoder()
+    {}
+
+    virtual bool Decode(const uint8_t* data, size_t size, VideoFrame& frame) = 0;
+
+    virtual bool IsStateful() const
+    {
+        return false;
+    }
+
+    /*
+     * @brief true if decoding can start at this sample. called from the
+     *        receiving thread while Decode may run, must not touch decoder state.
+     */
+    virtual bool IsKeyframe(const uint8_t*, size_t) const
+    {
+        return true;
+    }
+
+    /*
+     * @brief drop reference pictures, the next sample is a keyframe.
+     */
+    virtual void Reset()
+    {}
+};
+
+using VideoDecoderPtr = std::shared_ptr<VideoDecoder>;
+
+/*
+ * VideoPassthroughDecoder
+ * keep the encoded bitstream, for consumers that decode on their own hardware.
+ * with h264 set the stream forwards every access unit in order to
+ * OnFrameDecoded and resumes at an IDR after a drop, as a hardware decoder needs.
+ */
+class VideoPassthroughDecoder : public VideoDecoder
+{
+public:
+    explicit VideoPassthroughDecoder(bool h264 = false) :
+        mH264(h264)
+    {}
+
+    bool IsStateful() const
+    {
+        return mH264;
+    }
+
+    bool IsKeyframe(const uint8_t* data, size_t size) const
+    {
+        return !mH264 || IsH264Keyframe(data, size);
+    }
+
+    bool Decode(const uint8_t* data, size_t size, VideoFrame& frame)
+    {
+        frame.format = VideoFrame::FORMAT_ENCODED;
+        frame.width = 0;
+        frame.height = 0;
+        frame.stride = 0;
+        frame.data.assign(data, data + size);
+        return true;
+    }
+
+private:
+    bool mH264;
+};
+
+#ifdef UT_VIDEO_ENABLE_JPEG
+/*
+ * VideoJpegDecoder
+ * software JPEG decode to RGB24 with libjpeg(-turbo), as returned by VideoClient::GetImageSample.
+ */
+class VideoJpegDecoder : public VideoDecoder
+{
+public:
+    explicit VideoJpegDecoder()
+    {
+        mInfo.err = jpeg_std_error(&mError.pub);
+        mError.pub.error_exit = &VideoJpegDecoder::ErrorExit;
+        jpeg_create_decompress(&mInfo);
+    }
+
+    ~VideoJpegDecoder()
+    {
+        jpeg_destroy_decompress(&mInfo);
+    }
+
+    bool Decode(const uint8_t* data, size_t size, VideoFrame& frame)
+    {
+        if (setjmp(mError.jump))
+        {
+            jpeg_abort_decompress(&mInfo);
+            return false;
+        }
+
+        jpeg_mem_src(&mInfo, const_cast<uint8_t*>(data), (unsigned long)size);
+        jpeg_read_header(&mInfo, TRUE);
+        mInfo.out_color_space = JCS_RGB;
+        jpeg_start_decompress(&mInfo);
+
+        frame.format = VideoFrame::FORMAT_RGB24;
+        frame.width = mInfo.output_width;
+        frame.height = mInfo.output_height;
+        frame.stride = mInfo.output_width * mInfo.output_components;
+        frame.data.resize((size_t)frame.stride * frame.height);
+
+        while (mInfo.output_scanline < mInfo.output_height)
+        {
+            JSAMPROW row = frame.data.data() + (size_t)mInfo.output_scanline * frame.stride;
+            jpeg_read_scanlines(&mInfo, &row, 1);
+        }
+
+        jpeg_finish_decompress(&mInfo);
+
+        return true;
+    }
+
+private:
+    struct ErrorManager
+    {
+        struct jpeg_error_mgr pub;
+        jmp_buf jump;
+    };
+
+    static void ErrorExit(j_common_ptr info)
+    {
+        longjmp(((ErrorManager*)info->err)->jump, 1);
+    }
+
+private:
+    struct jpeg_decompress_struct mInfo;
+    ErrorManager mError;
+};
+#endif//UT_VIDEO_ENABLE_JPEG
+
+#ifdef UT_VIDEO_ENABLE_H264
+/*
+ * VideoH264Decoder
+ * software H.264 decode to RGB24 with libavcodec, for the Annex B streams of
+ * Go2FrontVideoData_. Expects one access unit per sample and no B-frames, so
+ * every sample yields its picture; a sample without one counts as failed.
+ */
+class VideoH264Decoder : public VideoDecoder
+{
+public:
+    explicit VideoH264Decoder(int32_t threadNumber = 1) :
+        mContext(nullptr), mPacket(nullptr), mPicture(nullptr), mScale(nullptr)
+    {
+        const AVCodec* codec = avcodec_find_decoder(AV_CODEC_ID_H264);
+        if (codec == nullptr)
+        {
+            UT_THROW(common::CommonException, "h264 decoder is not available");
+        }
+
+        mContext = avcodec_alloc_context3(codec);
+        mContext->thread_count = threadNumber;
+        mContext->flags |= AV_CODEC_FLAG_LOW_DELAY;
+        if (avcodec_open2(mContext, codec, nullptr) < 0)
+        {
+            avcodec_free_context(&mContext);
+            UT_THROW(common::CommonException, "open h264 decoder failed");
+        }
+
+        mPacket = av_packet_alloc();
+        mPicture = av_frame_alloc();
+    }
+
+    ~VideoH264Decoder()
+    {
+        sws_freeContext(mScale);
+        av_frame_free(&mPicture);
+        av_packet_free(&mPacket);
+        avcodec_free_context(&mContext);
+    }
+
+    bool IsStateful() const
+    {
+        return true;
+    }
+
+    bool IsKeyframe(const uint8_t* data, size_t size) const
+    {
+        return IsH264Keyframe(data, size);
+    }
+
+    void Reset()
+    {
+        avcodec_flush_buffers(mContext);
+    }
+
+    bool Decode(const uint8_t* data, size_t size, VideoFrame& frame)
+    {
+        /*
+         * libavcodec reads past the end of the packet, pad it
+         */
+        mBuffer.resize(size + AV_INPUT_BUFFER_PADDING_SIZE);
+        memcpy(mBuffer.data(), data, size);
+        memset(mBuffer.data() + size, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+
+        mPacket->data = mBuffer.data();
+        mPacket->size = (int)size;
+
+        if (avcodec_send_packet(mContext, mPacket) < 0 || avcodec_receive_frame(mContext, mPicture) < 0)
+        {
+            return false;
+        }
+
+        const int width = mPicture->width;
+        const int height = mPicture->height;
+        mScale = sws_getCachedContext(mScale, width, height, (AVPixelFormat)mPicture->format,
+            width, height, AV_PIX_FMT_RGB24, SWS_BILINEAR, nullptr, nullptr, nullptr);
+        if (mScale == nullptr)
+        {
+            av_frame_unref(mPicture);
+            return false;
+        }
+
+        frame.format = VideoFrame::FORMAT_RGB24;
+        frame.width = width;
+        frame.height = height;
+        frame.stride = width * 3;
+        frame.data.resize((size_t)frame.stride * frame.height);
+
+        uint8_t* dst[1] = { frame.data.data() };
+        int dstStride[1] = { (int)frame.stride };
+        sws_scale(mScale, (const uint8_t* const*)mPicture->data, mPicture->linesize, 0, height, dst, dstStride);
+
+        av_frame_unref(mPicture);
+
+        return true;
+    }
+
+private:
+    AVCodecContext* mContext;
+    AVPacket* mPacket;
+    AVFrame* mPicture;
+    SwsContext* mScale;
+    std::vector<uint8_t> mBuffer;
+};
+#endif//UT_VIDEO_ENABLE_H264
+
+/*
+ * VideoResolutionSelector
+ *
+ * Picks the Go2FrontVideoData_ stream from a consumer budget and measured
+ * cost. Decode time and receive-to-decoded latency are tracked per stream
+ * with an exponential average; the selector steps down one stream when the
+ * current one exceeds its budget and steps up when the next larger stream is
+ * projected (measured, or 4x pixels if never seen) to fit within margin.
+ * Switches are at least switchInterval frames apart to avoid oscillation.
+ * Costs of the streams not being decoded are stale, so every evaluation
+ * halves their distance to the estimate from the current stream (4x pixels
+ * per step); a stream left after a temporary overload is tried again.
+ *
+ * GetCurrent is the requested stream. VideoStream keeps decoding the old one
+ * until the requested stream reaches a keyframe, so only frames decoded from
+ * a clean start feed the averages.
+ */
+class VideoResolutionSelector
+{
+public:
+    explicit VideoResolutionSelector(int32_t initial = VIDEO_RESOLUTION_360P, uint64_t decodeBudgetMicrosec = 0,
+        uint64_t latencyBudgetMicrosec = 0, float upgradeMargin = 0.6f, uint32_t switchInterval = 30) :
+        mCurrent(initial), mDecodeBudget(decodeBudgetMicrosec * 1000.0), mLatencyBudget(latencyBudgetMicrosec * 1000.0),
+        mUpgradeMargin(upgradeMargin), mSwitchInterval(switchInterval), mFrames(0)
+    {
+        for (int32_t i = 0; i < VIDEO_RESOLUTION_NUMBER; i++)
+        {
+            mDecodeCost[i] = 0.0;
+            mLatencyCost[i] = 0.0;
+        }
+    }
+
+    /*
+     * @brief requested stream.
+     */
+    int32_t GetCurrent() const
+    {
+        return mCurrent;
+    }
+
+    /*
+     * @brief average decode time in nanosecond, 0 if the stream was never decoded.
+     */
+    double GetDecodeCost(int32_t resolution) const
+    {
+        return mDecodeCost[resolution];
+    }
+
+    /*
+     * @brief feed one decoded frame. call from a single thread.
+     */
+    void Update(int32_t resolution, uint64_t decodeNanosec, uint64_t latencyNanosec)
+    {
+        if (resolution < 0 || resolution >= VIDEO_RESOLUTION_NUMBER)
+        {
+            return;
+        }
+
+        Average(mDecodeCost[resolution], decodeNanosec);
+        Average(mLatencyCost[resolution], latencyNanosec);
+
+        const int32_t current = mCurrent;
+        if (resolution != current || ++mFrames < mSwitchInterval)
+        {
+            return;
+        }
+
+        for (int32_t i = 0; i < VIDEO_RESOLUTION_NUMBER; i++)
+        {
+            if (i != current)
+            {
+                const double scale = std::pow(4.0, current - i);
+                Decay(mDecodeCost[i], mDecodeCost[current] * scale);
+                Decay(mLatencyCost[i], mLatencyCost[current] * scale);
+            }
+        }
+
+        if (Load(mDecodeCost[current], mLatencyCost[current]) > 1.0 && current + 1 < VIDEO_RESOLUTION_NUMBER)
+        {
+            Switch(current + 1);
+        }
+        else if (current > 0)
+        {
+            const int32_t larger = current - 1;
+            double decode = mDecodeCost[larger] > 0.0 ? mDecodeCost[larger] : mDecodeCost[current] * 4.0;
+            double latency = mLatencyCost[larger] > 0.0 ? mLatencyCost[larger] : mLatencyCost[current] * 4.0;
+            if (Load(decode, latency) < mUpgradeMargin)
+            {
+                Switch(larger);
+            }
+        }
+    }
+
+private:
+    static void Average(double& average, uint64_t sample)
+    {
+        average = average > 0.0 ? average * 0.9 + sample * 0.1 : (double)sample;
+    }
+
+    static void Decay(double& average, double estimate)
+    {
+        if (average > 0.0)
+        {
+            average = (average + estimate) * 0.5;
+        }
+    }
+
+    double Load(double decode, double latency) const
+    {
+        double load = 0.0;
+        if (mDecodeBudget > 0.0)
+        {
+            load = std::max(load, decode / mDecodeBudget);
+        }
+        if (mLatencyBudget > 0.0)
+        {
+            load = std::max(load, latency / mLatencyBudget);
+        }
+        return load;
+    }
+
+    void Switch(int32_t resolution)
+    {
+        mCurrent = resolution;
+        mFrames = 0;
+    }
+
+private:
+    std::atomic<int32_t> mCurrent;
+    double mDecodeBudget;
+    double mLatencyBudget;
+    float mUpgradeMargin;
+    uint32_t mSwitchInterval;
+    uint32_t mFrames;
+    double mDecodeCost[VIDEO_RESOLUTION_NUMBER];
+    double mLatencyCost[VIDEO_RESOLUTION_NUMBER];
+};
+
+/*
+ * VideoStreamParam
+ */
+struct VideoStreamParam
+{
+    /*
+     * Go2FrontVideoData_ stream to decode, the starting stream when adaptive.
+     */
+    int32_t resolution = VIDEO_RESOLUTION_360P;
+
+    /*
+     * switch streams to stay within the budgets below, 0 disables a budget.
+     * decode budget bounds decode cpu time per frame, latency budget bounds
+     * the time from receive to decoded frame.
+     */
+    bool adaptive = false;
+    uint64_t decodeBudgetMicrosec = 0;
+    uint64_t latencyBudgetMicrosec = 0;
+    float upgradeMargin = 0.6f;
+    uint32_t switchInterval = 30;
+
+    /*
+     * frames in the pool. consumers holding more than poolSize - 1 frames
+     * make the stream drop decoded pictures.
+     */
+    uint32_t poolSize = 4;
+
+    /*
+     * samples waiting for a stateful decoder. when it falls this far behind
+     * the waiting samples are dropped and decode resumes at the next keyframe.
+     */
+    uint32_t queueSize = 8;
+
+    /*
+     * cpu the decode thread is pinned to.
+     */
+    int32_t cpuId = UT_CPU_ID_NONE;
+};
+
+/*
+ * VideoStream
+ *
+ * Push based video pipeline: samples arrive from the Go2FrontVideoData_
+ * topic (Subscribe) or from any other source (Push, e.g. a VideoClient
+ * poller), wait in a queue of reused buffers, and are decoded on a dedicated
+ * thread into pooled frames.
+ *
+ * For a stateless decoder a newer sample replaces undecoded ones, so latency
+ * stays bounded to one frame plus decode time. A stateful decoder gets every
+ * sample in order, up to queueSize behind; past that the queue is dropped and
+ * decode resumes at the next keyframe. Without a free frame in the pool a
+ * stateful decoder still decodes the sample and only the picture is dropped.
+ *
+ * Derived classes overriding the hooks must call Stop() in their destructor.
+ */
+class VideoStream
+{
+public:
+    explicit VideoStream(const VideoDecoderPtr& decoder, const VideoStreamParam& param = VideoStreamParam()) :
+        mParam(param), mDecoder(decoder), mPool(param.poolSize < 2 ? 2 : param.poolSize),
+        mSelector(param.resolution, param.decodeBudgetMicrosec, param.latencyBudgetMicrosec,
+            param.upgradeMargin, param.switchInterval),
+        mQuit(false), mQueue(param.queueSize < 2 ? 2 : param.queueSize), mHead(0), mCount(0), mSync(false),
+        mStreamResolution(param.resolution),
+        mReceived(0), mDecoded(0), mDropped(0), mFailed(0)
+    {
+        if (!mDecoder)
+        {
+            UT_THROW(common::CommonException, "video decoder is invalid");
+        }
+    }
+
+    virtual ~VideoStream()
+    {
+        Stop();
+    }
+
+    /*
+     * @brief start the decode thread.
+     */
+    void Start()
+    {
+        if (mThreadPtr)
+        {
+            return;
+        }
+
+        mQuit = false;
+        mThreadPtr = common::CreateThreadEx("videodec", mParam.cpuId, &VideoStream::DecodeThreadFunc, this);
+    }
+
+    /*
+     * @brief subscribe Go2FrontVideoData_ and feed the configured stream.
+     */
+    void Subscribe(const std::string& topic = ROBOT_FRONT_VIDEO_STREAM_TOPIC)
+    {
+        mSubscriberPtr.reset(new ChannelSubscriber<unitree_go::msg::dds_::Go2FrontVideoData_>(topic));
+        mSubscriberPtr->InitChannel(std::bind(&VideoStream::VideoDataHandler, this, std::placeholders::_1));
+    }
+
+    void Stop()
+    {
+        if (mSubscriberPtr)
+        {
+            mSubscriberPtr->CloseChannel();
+            mSubscriberPtr.reset();
+        }
+
+        if (mThreadPtr)
+        {
+            {
+                common::LockGuard<common::MutexCond> guard(mMutexCond);
+                mQuit = true;
+                mMutexCond.NotifyAll();
+            }
+            mThreadPtr->Wait();
+            mThreadPtr.reset();
+        }
+    }
+
+    /*
+     * @brief hand one encoded sample to the decoder, copied into a reused buffer.
+     *        samples of one stream must be pushed in order from one thread.
+     * @return false if this or an undecoded sample was dropped.
+     */
+    bool Push(const uint8_t* data, size_t size, uint64_t stamp, int32_t resolution)
+    {
+        const uint64_t now = common::GetCurrentMonotonicTimeNanosecond();
+        const bool stateful = mDecoder->IsStateful();
+
+        common::LockGuard<common::MutexCond> guard(mMutexCond);
+
+        mReceived++;
+
+        bool dropped = false;
+        if (mCount > 0 && (!stateful || mCount == mQueue.size()))
+        {
+            mDropped += mCount;
+            mCount = 0;
+            mSync = false;
+            dropped = true;
+        }
+
+        bool reset = false;
+        if (stateful && (!mSync || resolution != mStreamResolution))
+        {
+            if (!mDecoder->IsKeyframe(data, size))
+            {
+                mDropped++;
+                return false;
+            }
+
+            mSync = true;
+            reset = true;
+        }
+        mStreamResolution = resolution;
+
+        Sample& sample = mQueue[(mHead + mCount) % mQueue.size()];
+        sample.data.assign(data, data + size);
+        sample.stamp = stamp;
+        sample.time = now;
+        sample.resolution = resolution;
+        sample.reset = reset;
+        mCount++;
+
+        mMutexCond.Notify();
+
+        return !dropped;
+    }
+
+    bool Push(const std::vector<uint8_t>& data, uint64_t stamp, int32_t resolution = VIDEO_RESOLUTION_360P)
+    {
+        return Push(data.data(), data.size(), stamp, resolution);
+    }
+
+    /*
+     * @brief most recently decoded frame, nullptr before the first one.
+     *        the frame stays valid and unchanged while the pointer is held.
+     */
+    VideoFramePtr GetLatestFrame() const
+    {
+        common::LockGuard<common::Mutex> guard(mLatestMutex);
+        return mLatest;
+    }
+
+    const VideoStreamParam& GetParam() const
+    {
+        return mParam;
+    }
+
+    uint64_t GetReceivedCount() const
+    {
+        return mReceived;
+    }
+
+    uint64_t GetDecodedCount() const
+    {
+        return mDecoded;
+    }
+
+    /*
+     * @brief samples dropped before decode, while waiting for a keyframe, or
+     *        pictures dropped for lack of a free frame.
+     */
+    uint64_t GetDroppedCount() const
+    {
+        return mDropped;
+    }
+
+    uint64_t GetFailedCount() const
+    {
+        return mFailed;
+    }
+
+    /*
+     * @brief stream currently forwarded to the decoder.
+     */
+    int32_t GetResolution() const
+    {
+        return mStreamResolution;
+    }
+
+    const VideoResolutionSelector& GetSelector() const
+    {
+        return mSelector;
+    }
+
+protected:
+    /*
+     * @brief choose the stream to forward from one Go2FrontVideoData_ sample.
+     *        only the chosen stream is copied and decoded. a stateful decoder
+     *        moves to a newly chosen stream at its next keyframe.
+     */
+    virtual int32_t SelectResolution(const unitree_go::msg::dds_::Go2FrontVideoData_& msg)
+    {
+        int32_t resolution = mParam.adaptive ? mSelector.GetCurrent() : mParam.resolution;
+
+        /*
+         * fall back to the nearest smaller, then larger, non-empty stream
+         */
+        for (int32_t i = resolution; i < VIDEO_RESOLUTION_NUMBER; i++)
+        {
+            if (!GetVideoStreamData(msg, i).empty())
+            {
+                return i;
+            }
+        }
+        for (int32_t i = resolution - 1; i >= 0; i--)
+        {
+            if (!GetVideoStreamData(msg, i).empty())
+            {
+                return i;
+            }
+        }
+
+        return resolution;
+    }
+
+    /*
+     * @brief called on the decode thread after each successful decode, also
+     *        for pictures of a stateful decoder dropped for lack of a free frame.
+     */
+    virtual void OnFrameDecoded(const VideoFrame&)
+    {}
+
+private:
+    void VideoDataHandler(const void* message)
+    {
+        const auto& msg = *(const unitree_go::msg::dds_::Go2FrontVideoData_*)message;
+
+        int32_t resolution = SelectResolution(msg);
+        const std::vector<uint8_t>* data = &GetVideoStreamData(msg, resolution);
+
+        /*
+         * keep feeding the current stream until the new one can start
+         */
+        const int32_t current = mStreamResolution;
+        if (resolution != current && mDecoder->IsStateful() && !mDecoder->IsKeyframe(data->data(), data->size()))
+        {
+            const std::vector<uint8_t>& currentData = GetVideoStreamData(msg, current);
+            if (!currentData.empty())
+            {
+                resolution = current;
+                data = &currentData;
+            }
+        }
+
+        if (!data->empty())
+        {
+            Push(data->data(), data->size(), msg.time_frame(), resolution);
+        }
+    }
+
+    int32_t DecodeThreadFunc()
+    {
+        uint64_t sequence = 0;
+
+        while (true)
+        {
+            uint64_t stamp, receiveTime;
+            int32_t resolution;
+            bool reset;
+            {
+                common::LockGuard<common::MutexCond> guard(mMutexCond);
+                while (mCount == 0 && !mQuit)
+                {
+                    mMutexCond.Wait(100000);
+                }
+
+                if (mQuit)
+                {
+                    break;
+                }
+
+                Sample& sample = mQueue[mHead];
+                mWorking.swap(sample.data);
+                stamp = sample.stamp;
+                receiveTime = sample.time;
+                resolution = sample.resolution;
+                reset = sample.reset;
+                mHead = (mHead + 1) % mQueue.size();
+                mCount--;
+            }
+
+            sequence++;
+
+            if (reset)
+            {
+                mDecoder->Reset();
+            }
+
+            std::shared_ptr<VideoFrame> frame = mPool.Acquire();
+            VideoFrame* target = frame.get();
+            if (!frame)
+            {
+                mDropped++;
+                if (!mDecoder->IsStateful())
+                {
+                    continue;
+                }
+
+                /*
+                 * later samples depend on this one, decode it anyway
+                 */
+                target = &mScratch;
+            }
+
+            const uint64_t begin = common::GetCurrentMonotonicTimeNanosecond();
+            if (!mDecoder->Decode(mWorking.data(), mWorking.size(), *target))
+            {
+                mFailed++;
+
+                if (mDecoder->IsStateful())
+                {
+                    /*
+                     * decoder state is broken, resync at the next keyframe
+                     */
+                    common::LockGuard<common::MutexCond> guard(mMutexCond);
+                    mDropped += mCount;
+                    mCount = 0;
+                    mSync = false;
+                }
+
+                continue;
+            }
+
+            target->resolution = resolution;
+            target->stamp = stamp;
+            target->sequence = sequence;
+            target->receiveTime = receiveTime;
+            target->decodeTime = common::GetCurrentMonotonicTimeNanosecond() - begin;
+
+            if (frame)
+            {
+                common::LockGuard<common::Mutex> guard(mLatestMutex);
+                mLatest = frame;
+            }
+
+            mDecoded++;
+
+            if (mParam.adaptive)
+            {
+                mSelector.Update(resolution, target->decodeTime,
+                    common::GetCurrentMonotonicTimeNanosecond() - receiveTime);
+            }
+
+            OnFrameDecoded(*target);
+        }
+
+        return 0;
+    }
+
+private:
+    VideoStreamParam mParam;
+    VideoDecoderPtr mDecoder;
+    VideoFramePool mPool;
+    VideoResolutionSelector mSelector;
+
+    ChannelSubscriberPtr<unitree_go::msg::dds_::Go2FrontVideoData_> mSubscriberPtr;
+    common::ThreadPtr mThreadPtr;
+
+    struct Sample
+    {
+        std::vector<uint8_t> data;
+        uint64_t stamp = 0;
+        uint64_t time = 0;
+        int32_t resolution = VIDEO_RESOLUTION_360P;
+        bool reset = false;
+    };
+
+    common::MutexCond mMutexCond;
+    bool mQuit;
+    std::vector<Sample> mQueue;
+    size_t mHead;
+    size_t mCount;
+    bool mSync;
+    std::atomic<int32_t> mStreamResolution;
+    std::vector<uint8_t> mWorking;
+    VideoFrame mScratch;
+
+    mutable common::Mutex mLatestMutex;
+    VideoFramePtr mLatest;
+
+    std::atomic<uint64_t> mReceived;
+    std::atomic<uint64_t> mDecoded;
+    std::atomic<uint64_t> mDropped;
+    std::atomic<uint64_t> mFailed;
+};
+
+using VideoStreamPtr = std::shared_ptr<VideoStream>;
+
+}
+}
+}
+
+#endif//__UT_ROBOT_GO2_VIDEO_STREAM_HPP__
@@ -46,6 +46,26 @@ const int32_t ROBOT_API_ID_LEASE_RENEWAL            = 102;
 
 ///////////////////////////////////////////////////////////////
 
+/*
+ * @brief  chunk sequence used to query upload progress.
+ * @value: -1
+ */
+const int64_t ROBOT_UPLOAD_SEQUENCE_QUERY           = -1;
+
+/*
+ * @brief  upload chunk size default.
+ * @value: 64 KiB, well below dds fragment reassembly limits
+ */
+const uint32_t ROBOT_UPLOAD_CHUNK_SIZE              = 65536;
+
+/*
+ * @brief  upload chunks in flight default.
+ * @value: 4
+ */
+const uint32_t ROBOT_UPLOAD_WINDOW                  = 4;
+
+///////////////////////////////////////////////////////////////
+
 /*
  * @biref  robot lease term default.
  * @value: default 1000000 us
@@ -115,6 +135,78 @@ public:
     int64_t id;
     int64_t term;
 };
+
+/*
+ * @brief  Input parameter type for chunked upload, chunk bytes are in Request binary.
+ * @class: UploadChunkParameter
+ */
+class UploadChunkParameter : public common::Jsonize
+{
+public:
+    UploadChunkParameter() : sequence(0), offset(0), total(0)
+    {}
+
+    ~UploadChunkParameter()
+    {}
+
+    void fromJson(common::JsonMap& json)
+    {
+        common::FromJson(json["stream_id"], streamId);
+        common::FromJson(json["sequence"], sequence);
+        common::FromJson(json["offset"], offset);
+        common::FromJson(json["total"], total);
+        common::FromJson(json["parameter"], parameter);
+    }
+
+    void toJson(common::JsonMap& json) const
+    {
+        common::ToJson(streamId, json["stream_id"]);
+        common::ToJson(sequence, json["sequence"]);
+        common::ToJson(offset, json["offset"]);
+        common::ToJson(total, json["total"]);
+        common::ToJson(parameter, json["parameter"]);
+    }
+
+public:
+    std::string streamId;
+    int64_t sequence;
+    uint64_t offset;
+    uint64_t total;
+    std::string parameter;
+};
+
+/*
+ * @brief  Output data type for chunked upload.
+ * @class: UploadChunkData
+ */
+class UploadChunkData : public common::Jsonize
+{
+public:
+    UploadChunkData() : committed(0), complete(false)
+    {}
+
+    ~UploadChunkData()
+    {}
+
+    void fromJson(common::JsonMap& json)
+    {
+        common::FromJson(json["committed"], committed);
+        common::FromJson(json["complete"], complete);
+        common::FromJson(json["data"], data);
+    }
+
+    void toJson(common::JsonMap& json) const
+    {
+        common::ToJson(committed, json["committed"]);
+        common::ToJson(complete, json["complete"]);
+        common::ToJson(data, json["data"]);
+    }
+
+public:
+    uint64_t committed;
+    bool complete;
+    std::string data;
+};
 }
 }
 #endif//__UT_ROBOT_SDK_INERNAL_API_HPP__
@@ -0,0 +1,109 @@
+#ifndef __UT_ROBOT_DEX3_MODEL_HPP__
+#define __UT_ROBOT_DEX3_MODEL_HPP__
+
+#include <unitree/robot/model/robot_model.hpp>
+#include <unitree/idl/hg/HandCmd_.hpp>
+#include <unitree/idl/hg/HandState_.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+namespace model
+{
+/*
+ * Dex3-1 hand, 7 motors per hand. Position limits are the URDF limits of
+ * the dex3 example, the description gives no velocity or torque limits.
+ */
+struct Dex3Left
+{
+    using LowCmd = unitree_hg::msg::dds_::HandCmd_;
+    using LowState = unitree_hg::msg::dds_::HandState_;
+
+    static constexpr const char* NAME = "dex3_left";
+    static constexpr size_t JOINT_NUMBER = 7;
+    static constexpr size_t MOTOR_NUMBER = 7;
+
+    enum
+    {
+        THUMB_0 = 0, THUMB_1, THUMB_2, MIDDLE_0, MIDDLE_1, INDEX_0, INDEX_1
+    };
+
+    static constexpr std::array<const char*, JOINT_NUMBER> JOINT_NAME = {
+        "left_hand_thumb_0_joint", "left_hand_thumb_1_joint", "left_hand_thumb_2_joint",
+        "left_hand_middle_0_joint", "left_hand_middle_1_joint",
+        "left_hand_index_0_joint", "left_hand_index_1_joint"
+    };
+
+    static constexpr std::array<uint8_t, JOINT_NUMBER> MOTOR_INDEX = {
+        0, 1, 2, 3, 4, 5, 6
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MIN = {
+        -1.05f, -0.724f, 0.0f, -1.57f, -1.75f, -1.57f, -1.75f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MAX = {
+        1.05f, 1.05f, 1.75f, 0.0f, 0.0f, 0.0f, 0.0f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DQ_MAX = {
+        UT_MODEL_UNLIMITED, UT_MODEL_UNLIMITED, UT_MODEL_UNLIMITED, UT_MODEL_UNLIMITED,
+        UT_MODEL_UNLIMITED, UT_MODEL_UNLIMITED, UT_MODEL_UNLIMITED
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> TAU_MAX = DQ_MAX;
+
+    static constexpr std::array<float, JOINT_NUMBER> KP = {
+        1.5f, 1.5f, 1.5f, 1.5f, 1.5f, 1.5f, 1.5f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> KD = {
+        0.1f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DEFAULT_Q = {};
+};
+
+struct Dex3Right
+{
+    using LowCmd = unitree_hg::msg::dds_::HandCmd_;
+    using LowState = unitree_hg::msg::dds_::HandState_;
+
+    static constexpr const char* NAME = "dex3_right";
+    static constexpr size_t JOINT_NUMBER = 7;
+    static constexpr size_t MOTOR_NUMBER = 7;
+
+    enum
+    {
+        THUMB_0 = 0, THUMB_1, THUMB_2, MIDDLE_0, MIDDLE_1, INDEX_0, INDEX_1
+    };
+
+    static constexpr std::array<const char*, JOINT_NUMBER> JOINT_NAME = {
+        "right_hand_thumb_0_joint", "right_hand_thumb_1_joint", "right_hand_thumb_2_joint",
+        "right_hand_middle_0_joint", "right_hand_middle_1_joint",
+        "right_hand_index_0_joint", "right_hand_index_1_joint"
+    };
+
+    static constexpr std::array<uint8_t, JOINT_NUMBER> MOTOR_INDEX = Dex3Left::MOTOR_INDEX;
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MIN = {
+        -1.05f, -1.05f, -1.75f, 0.0f, 0.0f, 0.0f, 0.0f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MAX = {
+        1.05f, 0.742f, 0.0f, 1.57f, 1.75f, 1.57f, 1.75f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DQ_MAX = Dex3Left::DQ_MAX;
+    static constexpr std::array<float, JOINT_NUMBER> TAU_MAX = Dex3Left::TAU_MAX;
+    static constexpr std::array<float, JOINT_NUMBER> KP = Dex3Left::KP;
+    static constexpr std::array<float, JOINT_NUMBER> KD = Dex3Left::KD;
+    static constexpr std::array<float, JOINT_NUMBER> DEFAULT_Q = {};
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_DEX3_MODEL_HPP__
@@ -0,0 +1,153 @@
+#ifndef __UT_ROBOT_G1_MODEL_HPP__
+#define __UT_ROBOT_G1_MODEL_HPP__
+
+#include <unitree/robot/model/robot_model.hpp>
+#include <unitree/idl/hg/LowCmd_.hpp>
+#include <unitree/idl/hg/LowState_.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+namespace model
+{
+/*
+ * G1 29 dof. Joint order is the motor order, limits follow the g1_29dof
+ * URDF, gains are those of the low level examples.
+ */
+struct G1Dof29
+{
+    using LowCmd = unitree_hg::msg::dds_::LowCmd_;
+    using LowState = unitree_hg::msg::dds_::LowState_;
+
+    static constexpr const char* NAME = "g1_29dof";
+    static constexpr size_t JOINT_NUMBER = 29;
+    static constexpr size_t MOTOR_NUMBER = 35;
+
+    enum
+    {
+        LEFT_HIP_PITCH = 0, LEFT_HIP_ROLL, LEFT_HIP_YAW, LEFT_KNEE, LEFT_ANKLE_PITCH, LEFT_ANKLE_ROLL,
+        RIGHT_HIP_PITCH, RIGHT_HIP_ROLL, RIGHT_HIP_YAW, RIGHT_KNEE, RIGHT_ANKLE_PITCH, RIGHT_ANKLE_ROLL,
+        WAIST_YAW, WAIST_ROLL, WAIST_PITCH,
+        LEFT_SHOULDER_PITCH, LEFT_SHOULDER_ROLL, LEFT_SHOULDER_YAW, LEFT_ELBOW,
+        LEFT_WRIST_ROLL, LEFT_WRIST_PITCH, LEFT_WRIST_YAW,
+        RIGHT_SHOULDER_PITCH, RIGHT_SHOULDER_ROLL, RIGHT_SHOULDER_YAW, RIGHT_ELBOW,
+        RIGHT_WRIST_ROLL, RIGHT_WRIST_PITCH, RIGHT_WRIST_YAW
+    };
+
+    static constexpr std::array<const char*, JOINT_NUMBER> JOINT_NAME = {
+        "left_hip_pitch_joint", "left_hip_roll_joint", "left_hip_yaw_joint",
+        "left_knee_joint", "left_ankle_pitch_joint", "left_ankle_roll_joint",
+        "right_hip_pitch_joint", "right_hip_roll_joint", "right_hip_yaw_joint",
+        "right_knee_joint", "right_ankle_pitch_joint", "right_ankle_roll_joint",
+        "waist_yaw_joint", "waist_roll_joint", "waist_pitch_joint",
+        "left_shoulder_pitch_joint", "left_shoulder_roll_joint", "left_shoulder_yaw_joint", "left_elbow_joint",
+        "left_wrist_roll_joint", "left_wrist_pitch_joint", "left_wrist_yaw_joint",
+        "right_shoulder_pitch_joint", "right_shoulder_roll_joint", "right_shoulder_yaw_joint", "right_elbow_joint",
+        "right_wrist_roll_joint", "right_wrist_pitch_joint", "right_wrist_yaw_joint"
+    };
+
+    static constexpr std::array<uint8_t, JOINT_NUMBER> MOTOR_INDEX = {
+        0, 1, 2, 3, 4, 5,
+        6, 7, 8, 9, 10, 11,
+        12, 13, 14,
+        15, 16, 17, 18, 19, 20, 21,
+        22, 23, 24, 25, 26, 27, 28
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MIN = {
+        -2.5307f, -0.5236f, -2.7576f, -0.087267f, -0.87267f, -0.2618f,
+        -2.5307f, -2.9671f, -2.7576f, -0.087267f, -0.87267f, -0.2618f,
+        -2.618f, -0.52f, -0.52f,
+        -3.0892f, -1.5882f, -2.618f, -1.0472f, -1.97222f, -1.61443f, -1.61443f,
+        -3.0892f, -2.2515f, -2.618f, -1.0472f, -1.97222f, -1.61443f, -1.61443f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MAX = {
+        2.8798f, 2.9671f, 2.7576f, 2.8798f, 0.5236f, 0.2618f,
+        2.8798f, 0.5236f, 2.7576f, 2.8798f, 0.5236f, 0.2618f,
+        2.618f, 0.52f, 0.52f,
+        2.6704f, 2.2515f, 2.618f, 2.0944f, 1.97222f, 1.61443f, 1.61443f,
+        2.6704f, 1.5882f, 2.618f, 2.0944f, 1.97222f, 1.61443f, 1.61443f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DQ_MAX = {
+        32, 20, 32, 20, 37, 37,
+        32, 20, 32, 20, 37, 37,
+        32, 37, 37,
+        37, 37, 37, 37, 37, 22, 22,
+        37, 37, 37, 37, 37, 22, 22
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> TAU_MAX = {
+        88, 139, 88, 139, 50, 50,
+        88, 139, 88, 139, 50, 50,
+        88, 50, 50,
+        25, 25, 25, 25, 25, 5, 5,
+        25, 25, 25, 25, 25, 5, 5
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> KP = {
+        60, 60, 60, 100, 40, 40,
+        60, 60, 60, 100, 40, 40,
+        60, 40, 40,
+        40, 40, 40, 40, 40, 40, 40,
+        40, 40, 40, 40, 40, 40, 40
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> KD = {
+        1, 1, 1, 2, 1, 1,
+        1, 1, 1, 2, 1, 1,
+        1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DEFAULT_Q = {};
+};
+
+/*
+ * G1 23 dof: no waist roll/pitch and no wrist pitch/yaw, the other joints
+ * keep their 29 dof motor slots.
+ */
+struct G1Dof23
+{
+    using LowCmd = unitree_hg::msg::dds_::LowCmd_;
+    using LowState = unitree_hg::msg::dds_::LowState_;
+
+    static constexpr const char* NAME = "g1_23dof";
+    static constexpr size_t JOINT_NUMBER = 23;
+    static constexpr size_t MOTOR_NUMBER = 35;
+
+    enum
+    {
+        LEFT_HIP_PITCH = 0, LEFT_HIP_ROLL, LEFT_HIP_YAW, LEFT_KNEE, LEFT_ANKLE_PITCH, LEFT_ANKLE_ROLL,
+        RIGHT_HIP_PITCH, RIGHT_HIP_ROLL, RIGHT_HIP_YAW, RIGHT_KNEE, RIGHT_ANKLE_PITCH, RIGHT_ANKLE_ROLL,
+        WAIST_YAW,
+        LEFT_SHOULDER_PITCH, LEFT_SHOULDER_ROLL, LEFT_SHOULDER_YAW, LEFT_ELBOW, LEFT_WRIST_ROLL,
+        RIGHT_SHOULDER_PITCH, RIGHT_SHOULDER_ROLL, RIGHT_SHOULDER_YAW, RIGHT_ELBOW, RIGHT_WRIST_ROLL
+    };
+
+    static constexpr std::array<uint8_t, JOINT_NUMBER> MOTOR_INDEX = {
+        0, 1, 2, 3, 4, 5,
+        6, 7, 8, 9, 10, 11,
+        12,
+        15, 16, 17, 18, 19,
+        22, 23, 24, 25, 26
+    };
+
+    static constexpr std::array<const char*, JOINT_NUMBER> JOINT_NAME = detail::Gather(G1Dof29::JOINT_NAME, MOTOR_INDEX);
+    static constexpr std::array<float, JOINT_NUMBER> Q_MIN = detail::Gather(G1Dof29::Q_MIN, MOTOR_INDEX);
+    static constexpr std::array<float, JOINT_NUMBER> Q_MAX = detail::Gather(G1Dof29::Q_MAX, MOTOR_INDEX);
+    static constexpr std::array<float, JOINT_NUMBER> DQ_MAX = detail::Gather(G1Dof29::DQ_MAX, MOTOR_INDEX);
+    static constexpr std::array<float, JOINT_NUMBER> TAU_MAX = detail::Gather(G1Dof29::TAU_MAX, MOTOR_INDEX);
+    static constexpr std::array<float, JOINT_NUMBER> KP = detail::Gather(G1Dof29::KP, MOTOR_INDEX);
+    static constexpr std::array<float, JOINT_NUMBER> KD = detail::Gather(G1Dof29::KD, MOTOR_INDEX);
+    static constexpr std::array<float, JOINT_NUMBER> DEFAULT_Q = {};
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_G1_MODEL_HPP__
@@ -0,0 +1,205 @@
+#ifndef __UT_ROBOT_H1_MODEL_HPP__
+#define __UT_ROBOT_H1_MODEL_HPP__
+
+#include <unitree/robot/model/robot_model.hpp>
+#include <unitree/idl/go2/LowCmd_.hpp>
+#include <unitree/idl/go2/LowState_.hpp>
+#include <unitree/idl/hg/LowCmd_.hpp>
+#include <unitree/idl/hg/LowState_.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+namespace model
+{
+/*
+ * H1. Joints are listed left leg, right leg, torso, left arm, right arm;
+ * the motor slots are not in that order and slot 9 is unused. Gains are
+ * those of the low level example (ankles and arms are the weak motors).
+ */
+struct H1
+{
+    using LowCmd = unitree_go::msg::dds_::LowCmd_;
+    using LowState = unitree_go::msg::dds_::LowState_;
+
+    static constexpr const char* NAME = "h1";
+    static constexpr size_t JOINT_NUMBER = 19;
+    static constexpr size_t MOTOR_NUMBER = 20;
+
+    enum
+    {
+        LEFT_HIP_YAW = 0, LEFT_HIP_ROLL, LEFT_HIP_PITCH, LEFT_KNEE, LEFT_ANKLE,
+        RIGHT_HIP_YAW, RIGHT_HIP_ROLL, RIGHT_HIP_PITCH, RIGHT_KNEE, RIGHT_ANKLE,
+        TORSO,
+        LEFT_SHOULDER_PITCH, LEFT_SHOULDER_ROLL, LEFT_SHOULDER_YAW, LEFT_ELBOW,
+        RIGHT_SHOULDER_PITCH, RIGHT_SHOULDER_ROLL, RIGHT_SHOULDER_YAW, RIGHT_ELBOW
+    };
+
+    static constexpr std::array<const char*, JOINT_NUMBER> JOINT_NAME = {
+        "left_hip_yaw_joint", "left_hip_roll_joint", "left_hip_pitch_joint", "left_knee_joint", "left_ankle_joint",
+        "right_hip_yaw_joint", "right_hip_roll_joint", "right_hip_pitch_joint", "right_knee_joint", "right_ankle_joint",
+        "torso_joint",
+        "left_shoulder_pitch_joint", "left_shoulder_roll_joint", "left_shoulder_yaw_joint", "left_elbow_joint",
+        "right_shoulder_pitch_joint", "right_shoulder_roll_joint", "right_shoulder_yaw_joint", "right_elbow_joint"
+    };
+
+    static constexpr std::array<uint8_t, JOINT_NUMBER> MOTOR_INDEX = {
+        7, 3, 4, 5, 10,
+        8, 0, 1, 2, 11,
+        6,
+        16, 17, 18, 19,
+        12, 13, 14, 15
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MIN = {
+        -0.43f, -0.43f, -3.14f, -0.26f, -0.87f,
+        -0.43f, -0.43f, -3.14f, -0.26f, -0.87f,
+        -2.35f,
+        -2.87f, -0.34f, -1.3f, -1.25f,
+        -2.87f, -3.11f, -4.45f, -1.25f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MAX = {
+        0.43f, 0.43f, 2.53f, 2.05f, 0.52f,
+        0.43f, 0.43f, 2.53f, 2.05f, 0.52f,
+        2.35f,
+        2.87f, 3.11f, 4.45f, 2.61f,
+        2.87f, 0.34f, 1.3f, 2.61f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DQ_MAX = {
+        23, 23, 23, 14, 9,
+        23, 23, 23, 14, 9,
+        23,
+        9, 9, 20, 20,
+        9, 9, 20, 20
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> TAU_MAX = {
+        200, 200, 200, 300, 40,
+        200, 200, 200, 300, 40,
+        200,
+        40, 40, 18, 18,
+        40, 40, 18, 18
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> KP = {
+        200, 200, 200, 200, 60,
+        200, 200, 200, 200, 60,
+        200,
+        60, 60, 60, 60,
+        60, 60, 60, 60
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> KD = {
+        5, 5, 5, 5, 1.5f,
+        5, 5, 5, 5, 1.5f,
+        5,
+        1.5f, 1.5f, 1.5f, 1.5f,
+        1.5f, 1.5f, 1.5f, 1.5f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DEFAULT_Q = {};
+};
+
+/*
+ * H1-2, 27 joints in motor order. Gains follow the gearbox size used by the
+ * 27 dof example (S 80/2, M 100/3, L 200/5).
+ */
+struct H1_2
+{
+    using LowCmd = unitree_hg::msg::dds_::LowCmd_;
+    using LowState = unitree_hg::msg::dds_::LowState_;
+
+    static constexpr const char* NAME = "h1_2";
+    static constexpr size_t JOINT_NUMBER = 27;
+    static constexpr size_t MOTOR_NUMBER = 35;
+
+    enum
+    {
+        LEFT_HIP_YAW = 0, LEFT_HIP_PITCH, LEFT_HIP_ROLL, LEFT_KNEE, LEFT_ANKLE_PITCH, LEFT_ANKLE_ROLL,
+        RIGHT_HIP_YAW, RIGHT_HIP_PITCH, RIGHT_HIP_ROLL, RIGHT_KNEE, RIGHT_ANKLE_PITCH, RIGHT_ANKLE_ROLL,
+        TORSO,
+        LEFT_SHOULDER_PITCH, LEFT_SHOULDER_ROLL, LEFT_SHOULDER_YAW, LEFT_ELBOW,
+        LEFT_WRIST_ROLL, LEFT_WRIST_PITCH, LEFT_WRIST_YAW,
+        RIGHT_SHOULDER_PITCH, RIGHT_SHOULDER_ROLL, RIGHT_SHOULDER_YAW, RIGHT_ELBOW,
+        RIGHT_WRIST_ROLL, RIGHT_WRIST_PITCH, RIGHT_WRIST_YAW
+    };
+
+    static constexpr std::array<const char*, JOINT_NUMBER> JOINT_NAME = {
+        "left_hip_yaw_joint", "left_hip_pitch_joint", "left_hip_roll_joint",
+        "left_knee_joint", "left_ankle_pitch_joint", "left_ankle_roll_joint",
+        "right_hip_yaw_joint", "right_hip_pitch_joint", "right_hip_roll_joint",
+        "right_knee_joint", "right_ankle_pitch_joint", "right_ankle_roll_joint",
+        "torso_joint",
+        "left_shoulder_pitch_joint", "left_shoulder_roll_joint", "left_shoulder_yaw_joint", "left_elbow_joint",
+        "left_wrist_roll_joint", "left_wrist_pitch_joint", "left_wrist_yaw_joint",
+        "right_shoulder_pitch_joint", "right_shoulder_roll_joint", "right_shoulder_yaw_joint", "right_elbow_joint",
+        "right_wrist_roll_joint", "right_wrist_pitch_joint", "right_wrist_yaw_joint"
+    };
+
+    static constexpr std::array<uint8_t, JOINT_NUMBER> MOTOR_INDEX = {
+        0, 1, 2, 3, 4, 5,
+        6, 7, 8, 9, 10, 11,
+        12,
+        13, 14, 15, 16, 17, 18, 19,
+        20, 21, 22, 23, 24, 25, 26
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MIN = {
+        -0.43f, -3.14f, -0.43f, -0.12f, -0.897334f, -0.261799f,
+        -0.43f, -3.14f, -3.14f, -0.12f, -0.897334f, -0.261799f,
+        -2.35f,
+        -3.14f, -0.38f, -2.66f, -0.95f, -3.01f, -0.4712f, -1.27f,
+        -3.14f, -3.4f, -3.01f, -0.95f, -2.75f, -0.4712f, -1.27f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MAX = {
+        0.43f, 2.5f, 3.14f, 2.19f, 0.523598f, 0.261799f,
+        0.43f, 2.5f, 0.43f, 2.19f, 0.523598f, 0.261799f,
+        2.35f,
+        1.57f, 3.4f, 3.01f, 3.18f, 2.75f, 0.4712f, 1.27f,
+        1.57f, 0.38f, 2.66f, 3.18f, 3.01f, 0.4712f, 1.27f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DQ_MAX = {
+        23, 23, 23, 14, 9, 9,
+        23, 23, 23, 14, 9, 9,
+        23,
+        9, 9, 20, 20, 22, 22, 22,
+        9, 9, 20, 20, 22, 22, 22
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> TAU_MAX = {
+        200, 200, 200, 300, 60, 40,
+        200, 200, 200, 300, 60, 40,
+        200,
+        40, 40, 18, 18, 19, 19, 19,
+        40, 40, 18, 18, 19, 19, 19
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> KP = {
+        100, 100, 100, 200, 80, 80,
+        100, 100, 100, 200, 80, 80,
+        100,
+        80, 80, 80, 80, 80, 80, 80,
+        80, 80, 80, 80, 80, 80, 80
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> KD = {
+        3, 3, 3, 5, 2, 2,
+        3, 3, 3, 5, 2, 2,
+        3,
+        2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DEFAULT_Q = {};
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_H1_MODEL_HPP__
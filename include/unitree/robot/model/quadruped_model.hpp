@@ -0,0 +1,140 @@
+#ifndef __UT_ROBOT_QUADRUPED_MODEL_HPP__
+#define __UT_ROBOT_QUADRUPED_MODEL_HPP__
+
+#include <unitree/robot/model/robot_model.hpp>
+#include <unitree/idl/go2/LowCmd_.hpp>
+#include <unitree/idl/go2/LowState_.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+namespace model
+{
+/*
+ * Go2 and B2 share the leg layout FR, FL, RR, RL with hip, thigh, calf per
+ * leg in motor slots 0..11. DEFAULT_Q is the stand pose of the stand
+ * examples, gains are the ones they use.
+ */
+struct Go2
+{
+    using LowCmd = unitree_go::msg::dds_::LowCmd_;
+    using LowState = unitree_go::msg::dds_::LowState_;
+
+    static constexpr const char* NAME = "go2";
+    static constexpr size_t JOINT_NUMBER = 12;
+    static constexpr size_t MOTOR_NUMBER = 20;
+
+    enum
+    {
+        FR_HIP = 0, FR_THIGH, FR_CALF,
+        FL_HIP, FL_THIGH, FL_CALF,
+        RR_HIP, RR_THIGH, RR_CALF,
+        RL_HIP, RL_THIGH, RL_CALF
+    };
+
+    static constexpr std::array<const char*, JOINT_NUMBER> JOINT_NAME = {
+        "FR_hip_joint", "FR_thigh_joint", "FR_calf_joint",
+        "FL_hip_joint", "FL_thigh_joint", "FL_calf_joint",
+        "RR_hip_joint", "RR_thigh_joint", "RR_calf_joint",
+        "RL_hip_joint", "RL_thigh_joint", "RL_calf_joint"
+    };
+
+    static constexpr std::array<uint8_t, JOINT_NUMBER> MOTOR_INDEX = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MIN = {
+        -1.0472f, -1.5708f, -2.7227f,
+        -1.0472f, -1.5708f, -2.7227f,
+        -1.0472f, -0.5236f, -2.7227f,
+        -1.0472f, -0.5236f, -2.7227f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MAX = {
+        1.0472f, 3.4907f, -0.83776f,
+        1.0472f, 3.4907f, -0.83776f,
+        1.0472f, 4.5379f, -0.83776f,
+        1.0472f, 4.5379f, -0.83776f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DQ_MAX = {
+        30.1f, 30.1f, 15.7f, 30.1f, 30.1f, 15.7f,
+        30.1f, 30.1f, 15.7f, 30.1f, 30.1f, 15.7f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> TAU_MAX = {
+        23.7f, 23.7f, 45.43f, 23.7f, 23.7f, 45.43f,
+        23.7f, 23.7f, 45.43f, 23.7f, 23.7f, 45.43f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> KP = {
+        60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> KD = {
+        5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DEFAULT_Q = {
+        0.0f, 0.67f, -1.3f, 0.0f, 0.67f, -1.3f,
+        0.0f, 0.67f, -1.3f, 0.0f, 0.67f, -1.3f
+    };
+};
+
+struct B2
+{
+    using LowCmd = unitree_go::msg::dds_::LowCmd_;
+    using LowState = unitree_go::msg::dds_::LowState_;
+
+    static constexpr const char* NAME = "b2";
+    static constexpr size_t JOINT_NUMBER = 12;
+    static constexpr size_t MOTOR_NUMBER = 20;
+
+    enum
+    {
+        FR_HIP = 0, FR_THIGH, FR_CALF,
+        FL_HIP, FL_THIGH, FL_CALF,
+        RR_HIP, RR_THIGH, RR_CALF,
+        RL_HIP, RL_THIGH, RL_CALF
+    };
+
+    static constexpr std::array<const char*, JOINT_NUMBER> JOINT_NAME = Go2::JOINT_NAME;
+    static constexpr std::array<uint8_t, JOINT_NUMBER> MOTOR_INDEX = Go2::MOTOR_INDEX;
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MIN = {
+        -0.87f, -0.94f, -2.82f, -0.87f, -0.94f, -2.82f,
+        -0.87f, -0.94f, -2.82f, -0.87f, -0.94f, -2.82f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> Q_MAX = {
+        0.87f, 4.69f, -0.43f, 0.87f, 4.69f, -0.43f,
+        0.87f, 4.69f, -0.43f, 0.87f, 4.69f, -0.43f
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DQ_MAX = {
+        23, 23, 14, 23, 23, 14,
+        23, 23, 14, 23, 23, 14
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> TAU_MAX = {
+        200, 200, 320, 200, 200, 320,
+        200, 200, 320, 200, 200, 320
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> KP = {
+        1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> KD = {
+        10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10
+    };
+
+    static constexpr std::array<float, JOINT_NUMBER> DEFAULT_Q = Go2::DEFAULT_Q;
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_QUADRUPED_MODEL_HPP__
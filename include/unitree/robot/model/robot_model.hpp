@@ -0,0 +1,163 @@
+#ifndef __UT_ROBOT_MODEL_HPP__
+#define __UT_ROBOT_MODEL_HPP__
+
+#include <unitree/common/decl.hpp>
+
+#include <array>
+#include <limits>
+#include <utility>
+
+namespace unitree
+{
+namespace robot
+{
+namespace model
+{
+/*
+ * Robot descriptors
+ *
+ * Each robot is a struct of constexpr tables, one entry per controllable
+ * joint in a fixed logical order:
+ *
+ *     struct Robot
+ *     {
+ *         using LowCmd = ...;                 // message family
+ *         using LowState = ...;
+ *
+ *         static constexpr const char* NAME;
+ *         static constexpr size_t JOINT_NUMBER;   // controllable joints
+ *         static constexpr size_t MOTOR_NUMBER;   // motor slots in LowCmd
+ *
+ *         static constexpr std::array<const char*, JOINT_NUMBER> JOINT_NAME;
+ *         static constexpr std::array<uint8_t, JOINT_NUMBER> MOTOR_INDEX;  // joint -> motor slot
+ *         static constexpr std::array<float, JOINT_NUMBER> Q_MIN, Q_MAX;    // rad
+ *         static constexpr std::array<float, JOINT_NUMBER> DQ_MAX;          // rad/s
+ *         static constexpr std::array<float, JOINT_NUMBER> TAU_MAX;         // N.m
+ *         static constexpr std::array<float, JOINT_NUMBER> KP, KD;          // default gains
+ *         static constexpr std::array<float, JOINT_NUMBER> DEFAULT_Q;       // rad
+ *     };
+ *
+ * Controllers take the descriptor as a template parameter, every size is a
+ * compile time constant and ForEachJoint unrolls completely.
+ */
+
+/*
+ * limit entry for values the robot description does not give.
+ */
+constexpr float UT_MODEL_UNLIMITED = std::numeric_limits<float>::infinity();
+
+namespace detail
+{
+template<typename Func, size_t... I>
+inline void ForEachIndex(Func&& func, std::index_sequence<I...>)
+{
+    (func(std::integral_constant<size_t, I>()), ...);
+}
+
+constexpr bool NameEqual(const char* a, const char* b)
+{
+    while (*a != 0 && *a == *b)
+    {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+/*
+ * table of a reduced variant picked from the full variant's table.
+ */
+template<typename T, size_t FULL, size_t N>
+constexpr std::array<T, N> Gather(const std::array<T, FULL>& table, const std::array<uint8_t, N>& index)
+{
+    std::array<T, N> value = {};
+    for (size_t i = 0; i < N; i++)
+    {
+        value[i] = table[index[i]];
+    }
+    return value;
+}
+}
+
+/*
+ * @brief call func(std::integral_constant<size_t, joint>) for every joint,
+ *        unrolled at compile time.
+ */
+template<typename Model, typename Func>
+inline void ForEachJoint(Func&& func)
+{
+    detail::ForEachIndex(std::forward<Func>(func), std::make_index_sequence<Model::JOINT_NUMBER>());
+}
+
+/*
+ * @return joint index of name, -1 if not found.
+ */
+template<typename Model>
+constexpr int32_t FindJoint(const char* name)
+{
+    for (size_t i = 0; i < Model::JOINT_NUMBER; i++)
+    {
+        if (detail::NameEqual(Model::JOINT_NAME[i], name))
+        {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * @return motor slot -> joint index, -1 for slots no joint uses.
+ */
+template<typename Model>
+constexpr std::array<int32_t, Model::MOTOR_NUMBER> MotorToJoint()
+{
+    std::array<int32_t, Model::MOTOR_NUMBER> joint = {};
+    for (size_t i = 0; i < Model::MOTOR_NUMBER; i++)
+    {
+        joint[i] = -1;
+    }
+    for (size_t i = 0; i < Model::JOINT_NUMBER; i++)
+    {
+        joint[Model::MOTOR_INDEX[i]] = (int32_t)i;
+    }
+    return joint;
+}
+
+template<typename Model>
+constexpr float ClampJoint(size_t joint, float q)
+{
+    return q < Model::Q_MIN[joint] ? Model::Q_MIN[joint] : (q > Model::Q_MAX[joint] ? Model::Q_MAX[joint] : q);
+}
+
+/*
+ * @brief write the default kp/kd of every joint into its motor slot.
+ */
+template<typename Model, typename Cmd>
+inline void SetDefaultGain(Cmd& cmd)
+{
+    auto& motor = cmd.motor_cmd();
+    ForEachJoint<Model>([&](auto joint)
+    {
+        motor[Model::MOTOR_INDEX[joint]].kp(Model::KP[joint]);
+        motor[Model::MOTOR_INDEX[joint]].kd(Model::KD[joint]);
+    });
+}
+
+/*
+ * @brief gather joint positions from motor slots into logical order.
+ */
+template<typename Model, typename State>
+inline void GetJointPosition(const State& state, std::array<float, Model::JOINT_NUMBER>& q)
+{
+    const auto& motor = state.motor_state();
+    ForEachJoint<Model>([&](auto joint)
+    {
+        q[joint] = motor[Model::MOTOR_INDEX[joint]].q();
+    });
+}
+
+}
+}
+}
+
+#endif//__UT_ROBOT_MODEL_HPP__
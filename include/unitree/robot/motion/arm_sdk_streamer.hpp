@@ -0,0 +1,247 @@
+#ifndef __UT_ROBOT_MOTION_ARM_SDK_STREAMER_HPP__
+#define __UT_ROBOT_MOTION_ARM_SDK_STREAMER_HPP__
+
+#include <unitree/common/thread/thread.hpp>
+#include <unitree/common/time/deadline_timer.hpp>
+#include <unitree/robot/channel/channel_publisher.hpp>
+#include <unitree/robot/motion/trajectory.hpp>
+
+#include <atomic>
+
+namespace unitree
+{
+namespace robot
+{
+namespace motion
+{
+const std::string UT_ARM_SDK_TOPIC = "rt/arm_sdk";
+
+/*
+ * motor_cmd slot whose q carries the arm_sdk weight
+ */
+const int32_t UT_ARM_SDK_G1_WEIGHT_INDEX = 29;
+const int32_t UT_ARM_SDK_H1_WEIGHT_INDEX = 9;
+
+/*
+ * ArmSdkStreamerParam
+ */
+struct ArmSdkStreamerParam
+{
+    std::string topic = UT_ARM_SDK_TOPIC;
+
+    /*
+     * motor index of each trajectory column.
+     */
+    std::vector<int32_t> jointMap;
+    int32_t weightIndex = UT_ARM_SDK_G1_WEIGHT_INDEX;
+
+    double frequency = 500.0;
+    float kp = 60.0f;
+    float kd = 1.5f;
+
+    /*
+     * weight change per second when ramping toward SetWeight.
+     */
+    float weightRate = 0.5f;
+
+    int32_t cpuId = UT_CPU_ID_NONE;
+};
+
+/*
+ * ArmSdkStreamer
+ *
+ * Publishes a TrajectoryPlayer to rt/arm_sdk at a fixed rate. The loop sleeps
+ * to absolute CLOCK_MONOTONIC deadlines, so the period does not drift with
+ * evaluation or publish time; a tick later than one period re-anchors the
+ * schedule instead of bursting the missed ticks. LowCmd is
+ * unitree_hg::msg::dds_::LowCmd_ (G1) or unitree_go::msg::dds_::LowCmd_ (H1).
+ */
+template<typename LowCmd>
+class ArmSdkStreamer
+{
+public:
+    explicit ArmSdkStreamer(const ArmSdkStreamerParam& param) :
+        mParam(param), mPlayer((uint32_t)param.jointMap.size()),
+        mPeriod((int64_t)(1e9 / param.frequency)), mQuit(false),
+        mWeight(0.0f), mWeightTarget(0.0f), mWeightRate(param.weightRate),
+        mTickNumber(0), mOverrunNumber(0), mMaxLateness(0)
+    {
+        const int32_t motorNumber = (int32_t)mCmd.motor_cmd().size();
+        UT_THROW_IF(mParam.weightIndex < 0 || mParam.weightIndex >= motorNumber, common::CommonException,
+            "arm_sdk weight index out of range");
+        for (int32_t index : mParam.jointMap)
+        {
+            UT_THROW_IF(index < 0 || index >= motorNumber, common::CommonException, "arm_sdk joint index out of range");
+        }
+    }
+
+    ~ArmSdkStreamer()
+    {
+        Stop();
+    }
+
+    void Start()
+    {
+        if (mThreadPtr)
+        {
+            return;
+        }
+
+        if (!mPublisherPtr)
+        {
+            mPublisherPtr.reset(new ChannelPublisher<LowCmd>(mParam.topic));
+            mPublisherPtr->InitChannel();
+        }
+
+        mQuit = false;
+        mThreadPtr = common::CreateThreadEx("armsdk", mParam.cpuId, &ArmSdkStreamer::StreamThreadFunc, this);
+    }
+
+    void Stop()
+    {
+        if (mThreadPtr)
+        {
+            mQuit = true;
+            mThreadPtr->Wait();
+            mThreadPtr.reset();
+        }
+    }
+
+    /*
+     * @brief streamer clock in seconds, CLOCK_MONOTONIC.
+     */
+    static double GetTime()
+    {
+        return common::DeadlineTimer::GetClock() * 1e-9;
+    }
+
+    /*
+     * @brief initial pose, call before Start.
+     */
+    void SetPose(const float* q)
+    {
+        mPlayer.SetPose(q);
+    }
+
+    /*
+     * @brief play trajectory from now, blending from the current output.
+     */
+    void Play(const TrajectoryPtr& trajectory, double blendTime = 0.5)
+    {
+        mPlayer.Play(trajectory, GetTime(), blendTime);
+    }
+
+    bool IsFinished()
+    {
+        return mPlayer.IsFinished(GetTime());
+    }
+
+    /*
+     * @brief ramp the arm_sdk weight toward target at rate per second.
+     *        rate <= 0 uses ArmSdkStreamerParam::weightRate.
+     */
+    void SetWeight(float target, float rate = 0.0f)
+    {
+        mWeightRate = rate > 0.0f ? rate : mParam.weightRate;
+        mWeightTarget = std::min(1.0f, std::max(0.0f, target));
+    }
+
+    float GetWeight() const
+    {
+        return mWeight;
+    }
+
+    uint64_t GetTickNumber() const
+    {
+        return mTickNumber;
+    }
+
+    /*
+     * @brief ticks that started more than one period late.
+     */
+    uint64_t GetOverrunNumber() const
+    {
+        return mOverrunNumber;
+    }
+
+    /*
+     * @brief worst wakeup lateness in nanoseconds.
+     */
+    int64_t GetMaxLateness() const
+    {
+        return mMaxLateness;
+    }
+
+private:
+    int32_t StreamThreadFunc()
+    {
+        common::DeadlineTimer timer(mPeriod);
+        timer.Start();
+
+        while (!mQuit)
+        {
+            const int64_t lateness = timer.Wait();
+            if (lateness > mMaxLateness)
+            {
+                mMaxLateness = lateness;
+            }
+            mOverrunNumber = timer.GetOverrunNumber();
+
+            Tick(timer.GetWakeTime() * 1e-9);
+            mTickNumber++;
+        }
+
+        return 0;
+    }
+
+    void Tick(double now)
+    {
+        const float* q = nullptr;
+        const float* dq = nullptr;
+        mPlayer.Evaluate(now, q, dq);
+
+        const float step = mWeightRate * (float)(mPeriod * 1e-9);
+        const float target = mWeightTarget;
+        float weight = mWeight;
+        weight = weight < target ? std::min(target, weight + step) : std::max(target, weight - step);
+        mWeight = weight;
+
+        auto& motor = mCmd.motor_cmd();
+        for (size_t j = 0; j < mParam.jointMap.size(); j++)
+        {
+            auto& cmd = motor[mParam.jointMap[j]];
+            cmd.q(q[j]);
+            cmd.dq(dq[j]);
+            cmd.kp(mParam.kp);
+            cmd.kd(mParam.kd);
+            cmd.tau(0.0f);
+        }
+        motor[mParam.weightIndex].q(weight);
+
+        mPublisherPtr->Write(mCmd);
+    }
+
+private:
+    ArmSdkStreamerParam mParam;
+    TrajectoryPlayer mPlayer;
+    int64_t mPeriod;
+
+    LowCmd mCmd;
+    std::shared_ptr<ChannelPublisher<LowCmd>> mPublisherPtr;
+    common::ThreadPtr mThreadPtr;
+    std::atomic<bool> mQuit;
+
+    std::atomic<float> mWeight;
+    std::atomic<float> mWeightTarget;
+    std::atomic<float> mWeightRate;
+
+    std::atomic<uint64_t> mTickNumber;
+    std::atomic<uint64_t> mOverrunNumber;
+    std::atomic<int64_t> mMaxLateness;
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_MOTION_ARM_SDK_STREAMER_HPP__
@@ -0,0 +1,293 @@
+#ifndef __UT_ROBOT_MOTION_CLIP_HPP__
+#define __UT_ROBOT_MOTION_CLIP_HPP__
+
+#include <unitree/common/exception.hpp>
+#include <unitree/common/filesystem/file.hpp>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cmath>
+#include <cstring>
+
+namespace unitree
+{
+namespace robot
+{
+namespace motion
+{
+/*
+ * Motion clip file layout, little endian:
+ *
+ *   MotionClipHeader                       64 bytes
+ *   int32_t joint[dof]                     motor index of each column, -1 unmapped
+ *   padding to dataOffset                  64 byte aligned
+ *   float frame[frameNumber][frameStride]  frameStride = dof rounded up to 8
+ *
+ * Frames are contiguous and padded so every frame starts 32 byte aligned and
+ * interpolation runs over whole vector registers without a scalar tail.
+ */
+const char UT_MOTION_CLIP_MAGIC[8] = {'U', 'T', 'C', 'L', 'I', 'P', 0, 0};
+const uint32_t UT_MOTION_CLIP_VERSION = 1;
+const uint32_t UT_MOTION_CLIP_ALIGN = 64;
+const uint32_t UT_MOTION_CLIP_STRIDE_ALIGN = 8;
+
+struct MotionClipHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t dof;
+    uint32_t frameNumber;
+    uint32_t frameStride;
+    float frameRate;
+    uint32_t reserved0;
+    uint64_t dataOffset;
+    uint64_t dataSize;
+    uint8_t reserved[16];
+};
+
+static_assert(sizeof(MotionClipHeader) == 64, "MotionClipHeader must be 64 bytes");
+
+inline uint32_t GetMotionClipStride(uint32_t dof)
+{
+    return (dof + UT_MOTION_CLIP_STRIDE_ALIGN - 1) / UT_MOTION_CLIP_STRIDE_ALIGN * UT_MOTION_CLIP_STRIDE_ALIGN;
+}
+
+/*
+ * @brief serialize a clip. frames holds frameNumber rows of dof values.
+ */
+inline void SaveMotionClip(const std::string& fileName, float frameRate, const std::vector<int32_t>& jointMap,
+    const std::vector<std::vector<double>>& frames)
+{
+    const uint32_t dof = (uint32_t)jointMap.size();
+    const uint32_t stride = GetMotionClipStride(dof);
+
+    MotionClipHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, UT_MOTION_CLIP_MAGIC, sizeof(header.magic));
+    header.version = UT_MOTION_CLIP_VERSION;
+    header.dof = dof;
+    header.frameNumber = (uint32_t)frames.size();
+    header.frameStride = stride;
+    header.frameRate = frameRate;
+    header.dataOffset = (sizeof(header) + dof * sizeof(int32_t) + UT_MOTION_CLIP_ALIGN - 1)
+        / UT_MOTION_CLIP_ALIGN * UT_MOTION_CLIP_ALIGN;
+    header.dataSize = (uint64_t)header.frameNumber * stride * sizeof(float);
+
+    std::string s(header.dataOffset + header.dataSize, '\0');
+    std::memcpy(&s[0], &header, sizeof(header));
+    std::memcpy(&s[sizeof(header)], jointMap.data(), dof * sizeof(int32_t));
+
+    float* data = (float*)&s[header.dataOffset];
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        UT_THROW_IF(frames[i].size() != dof, common::FileException, "motion clip frame dof mismatch");
+        for (uint32_t j = 0; j < dof; j++)
+        {
+            data[i * stride + j] = (float)frames[i][j];
+        }
+    }
+
+    common::SaveFile(fileName, s.data(), (int64_t)s.size());
+}
+
+/*
+ * MotionClip
+ *
+ * Read-only, memory mapped motion clip. Open maps the file and validates the
+ * header, frames are paged in on first touch (or prefetched with Prefetch),
+ * so a clip is usable in well under a millisecond regardless of length.
+ */
+class MotionClip
+{
+public:
+    MotionClip() :
+        mAddress(MAP_FAILED), mSize(0), mHeader(nullptr), mJointMap(nullptr), mData(nullptr)
+    {}
+
+    explicit MotionClip(const std::string& fileName) : MotionClip()
+    {
+        Open(fileName);
+    }
+
+    ~MotionClip()
+    {
+        Close();
+    }
+
+    MotionClip(const MotionClip&) = delete;
+    MotionClip& operator=(const MotionClip&) = delete;
+
+    void Open(const std::string& fileName)
+    {
+        Close();
+
+        int fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+        UT_THROW_IF(fd < 0, common::FileException, "open motion clip failed: " + fileName);
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(MotionClipHeader))
+        {
+            ::close(fd);
+            UT_THROW(common::FileException, "invalid motion clip: " + fileName);
+        }
+
+        mSize = (size_t)st.st_size;
+        mAddress = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        UT_THROW_IF(mAddress == MAP_FAILED, common::FileException, "mmap motion clip failed: " + fileName);
+
+        const MotionClipHeader* header = (const MotionClipHeader*)mAddress;
+        if (std::memcmp(header->magic, UT_MOTION_CLIP_MAGIC, sizeof(header->magic)) != 0 ||
+            header->version != UT_MOTION_CLIP_VERSION ||
+            header->dof > (mSize - sizeof(MotionClipHeader)) / sizeof(int32_t) ||
+            header->frameStride != GetMotionClipStride(header->dof) ||
+            header->dataOffset % UT_MOTION_CLIP_ALIGN != 0 ||
+            header->dataOffset < sizeof(MotionClipHeader) + header->dof * sizeof(int32_t) ||
+            header->dataSize != (uint64_t)header->frameNumber * header->frameStride * sizeof(float) ||
+            header->dataOffset > mSize || header->dataSize > mSize - header->dataOffset ||
+            header->frameNumber == 0 || !(header->frameRate > 0.0f))
+        {
+            Close();
+            UT_THROW(common::FileException, "invalid motion clip: " + fileName);
+        }
+
+        mHeader = header;
+        mJointMap = (const int32_t*)((const uint8_t*)mAddress + sizeof(MotionClipHeader));
+        mData = (const float*)((const uint8_t*)mAddress + header->dataOffset);
+    }
+
+    void Close()
+    {
+        if (mAddress != MAP_FAILED)
+        {
+            ::munmap(mAddress, mSize);
+        }
+
+        mAddress = MAP_FAILED;
+        mSize = 0;
+        mHeader = nullptr;
+        mJointMap = nullptr;
+        mData = nullptr;
+    }
+
+    bool IsOpen() const
+    {
+        return mHeader != nullptr;
+    }
+
+    /*
+     * @brief ask the kernel to read all frames ahead, e.g. before playback.
+     */
+    void Prefetch() const
+    {
+        if (mHeader)
+        {
+            ::madvise(mAddress, mSize, MADV_WILLNEED);
+        }
+    }
+
+    uint32_t GetDof() const
+    {
+        return mHeader->dof;
+    }
+
+    uint32_t GetFrameNumber() const
+    {
+        return mHeader->frameNumber;
+    }
+
+    uint32_t GetFrameStride() const
+    {
+        return mHeader->frameStride;
+    }
+
+    float GetFrameRate() const
+    {
+        return mHeader->frameRate;
+    }
+
+    double GetDuration() const
+    {
+        return (mHeader->frameNumber - 1) / (double)mHeader->frameRate;
+    }
+
+    const int32_t* GetJointMap() const
+    {
+        return mJointMap;
+    }
+
+    const float* GetFrame(uint32_t index) const
+    {
+        return mData + (size_t)index * mHeader->frameStride;
+    }
+
+    /*
+     * @brief linear interpolation at time seconds, clamped to the clip.
+     *        out holds GetFrameStride() floats.
+     */
+    void Sample(double time, float* out) const
+    {
+        double position = time * mHeader->frameRate;
+        const uint32_t last = mHeader->frameNumber - 1;
+
+        if (!(position > 0.0))
+        {
+            position = 0.0;
+        }
+        if (position >= last)
+        {
+            std::memcpy(out, GetFrame(last), mHeader->frameStride * sizeof(float));
+            return;
+        }
+
+        const uint32_t index = (uint32_t)position;
+        Lerp(GetFrame(index), GetFrame(index + 1), (float)(position - index), out, mHeader->frameStride);
+    }
+
+    /*
+     * @brief sample and scatter into a joint array by the joint map.
+     *        joints outside the map, or beyond jointNumber, are left untouched.
+     */
+    template<typename T>
+    void SampleJoints(double time, T* joint, size_t jointNumber, float* scratch) const
+    {
+        Sample(time, scratch);
+        for (uint32_t j = 0; j < mHeader->dof; j++)
+        {
+            const int32_t index = mJointMap[j];
+            if (index >= 0 && (size_t)index < jointNumber)
+            {
+                joint[index] = (T)scratch[j];
+            }
+        }
+    }
+
+    /*
+     * @brief out = a + (b - a) * t over n floats. n is a multiple of 8 and the
+     *        frames are 32 byte aligned, so this compiles to packed fma.
+     */
+    static void Lerp(const float* __restrict a, const float* __restrict b, float t, float* __restrict out, uint32_t n)
+    {
+        a = (const float*)__builtin_assume_aligned(a, 32);
+        b = (const float*)__builtin_assume_aligned(b, 32);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            out[i] = a[i] + (b[i] - a[i]) * t;
+        }
+    }
+
+private:
+    void* mAddress;
+    size_t mSize;
+    const MotionClipHeader* mHeader;
+    const int32_t* mJointMap;
+    const float* mData;
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_MOTION_CLIP_HPP__
@@ -0,0 +1,458 @@
+#ifndef __UT_ROBOT_MOTION_TRAJECTORY_HPP__
+#define __UT_ROBOT_MOTION_TRAJECTORY_HPP__
+
+#include <unitree/common/lock/lock.hpp>
+#include <unitree/robot/motion/motion_clip.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace unitree
+{
+namespace robot
+{
+namespace motion
+{
+enum TrajectoryInterpolation
+{
+    TRAJECTORY_LINEAR = 0,
+    TRAJECTORY_CUBIC = 1,
+    TRAJECTORY_QUINTIC = 2
+};
+
+/*
+ * Trajectory
+ *
+ * Timestamped joint knots with per-knot velocity and acceleration. Missing
+ * derivatives are estimated by central differences and are zero at both
+ * ends, so a trajectory starts and stops at rest. Knot data is stored as
+ * contiguous rows padded to GetMotionClipStride(dof) floats, so evaluation
+ * is a straight loop over all joints that the compiler vectorizes.
+ */
+class Trajectory
+{
+public:
+    explicit Trajectory(uint32_t dof, TrajectoryInterpolation interpolation = TRAJECTORY_CUBIC) :
+        mDof(dof), mStride(GetMotionClipStride(dof)), mInterpolation(interpolation)
+    {}
+
+    /*
+     * @brief append a knot, time must increase. q holds dof values.
+     */
+    void AddKnot(double time, const float* q)
+    {
+        if (!mTime.empty() && !(time > mTime.back()))
+        {
+            UT_THROW(common::CommonException, "trajectory knot time must increase");
+        }
+
+        mTime.push_back(time);
+        mPosition.resize(mTime.size() * mStride, 0.0f);
+        std::copy(q, q + mDof, &mPosition[(mTime.size() - 1) * mStride]);
+    }
+
+    /*
+     * @brief derive knot velocities and accelerations. call after the last
+     *        AddKnot; velocity/acceleration may be supplied instead through
+     *        GetVelocity/GetAcceleration after Finalize.
+     */
+    void Finalize()
+    {
+        const size_t n = mTime.size();
+        UT_THROW_IF(n < 2, common::CommonException, "trajectory needs at least 2 knots");
+
+        mVelocity.assign(n * mStride, 0.0f);
+        mAcceleration.assign(n * mStride, 0.0f);
+
+        Differentiate(mPosition, mVelocity);
+        Differentiate(mVelocity, mAcceleration);
+    }
+
+    /*
+     * @brief knots at frame rate from a motion clip, time starts at 0.
+     */
+    static std::shared_ptr<Trajectory> FromClip(const MotionClip& clip,
+        TrajectoryInterpolation interpolation = TRAJECTORY_CUBIC)
+    {
+        std::shared_ptr<Trajectory> trajectory(new Trajectory(clip.GetDof(), interpolation));
+        const double dt = 1.0 / clip.GetFrameRate();
+        for (uint32_t i = 0; i < clip.GetFrameNumber(); i++)
+        {
+            trajectory->AddKnot(i * dt, clip.GetFrame(i));
+        }
+        trajectory->Finalize();
+        return trajectory;
+    }
+
+    uint32_t GetDof() const
+    {
+        return mDof;
+    }
+
+    uint32_t GetStride() const
+    {
+        return mStride;
+    }
+
+    size_t GetKnotNumber() const
+    {
+        return mTime.size();
+    }
+
+    double GetStartTime() const
+    {
+        return mTime.front();
+    }
+
+    double GetEndTime() const
+    {
+        return mTime.back();
+    }
+
+    float* GetVelocity(size_t knot)
+    {
+        return &mVelocity[knot * mStride];
+    }
+
+    float* GetAcceleration(size_t knot)
+    {
+        return &mAcceleration[knot * mStride];
+    }
+
+    /*
+     * @brief evaluate at time, clamped to the knot range. q and dq hold
+     *        GetStride() floats, dq may be null. hint caches the segment
+     *        between calls of one caller.
+     */
+    void Evaluate(double time, float* q, float* dq, size_t* hint = nullptr) const
+    {
+        const size_t n = mTime.size();
+
+        if (!(time > mTime[0]))
+        {
+            Copy(0, q, dq);
+            return;
+        }
+        if (time >= mTime[n - 1])
+        {
+            Copy(n - 1, q, dq);
+            return;
+        }
+
+        /*
+         * playback moves forward, check the last segment before searching
+         */
+        size_t i = hint ? *hint : 0;
+        if (!(i + 1 < n && mTime[i] <= time && time < mTime[i + 1]))
+        {
+            if (i + 2 < n && mTime[i + 1] <= time && time < mTime[i + 2])
+            {
+                i++;
+            }
+            else
+            {
+                i = std::upper_bound(mTime.begin(), mTime.end(), time) - mTime.begin() - 1;
+            }
+        }
+        if (hint)
+        {
+            *hint = i;
+        }
+
+        const float h = (float)(mTime[i + 1] - mTime[i]);
+        const float s = (float)((time - mTime[i]) / h);
+
+        const float* __restrict p0 = &mPosition[i * mStride];
+        const float* __restrict p1 = p0 + mStride;
+
+        if (mInterpolation == TRAJECTORY_LINEAR)
+        {
+            for (uint32_t j = 0; j < mStride; j++)
+            {
+                q[j] = p0[j] + (p1[j] - p0[j]) * s;
+            }
+            if (dq)
+            {
+                for (uint32_t j = 0; j < mStride; j++)
+                {
+                    dq[j] = (p1[j] - p0[j]) / h;
+                }
+            }
+            return;
+        }
+
+        const float* __restrict v0 = &mVelocity[i * mStride];
+        const float* __restrict v1 = v0 + mStride;
+
+        if (mInterpolation == TRAJECTORY_CUBIC)
+        {
+            /*
+             * hermite basis and derivatives over s in [0, 1]
+             */
+            const float s2 = s * s, s3 = s2 * s;
+            const float h00 = 2 * s3 - 3 * s2 + 1, h10 = (s3 - 2 * s2 + s) * h;
+            const float h01 = -2 * s3 + 3 * s2, h11 = (s3 - s2) * h;
+            const float d00 = (6 * s2 - 6 * s) / h, d10 = 3 * s2 - 4 * s + 1;
+            const float d01 = (-6 * s2 + 6 * s) / h, d11 = 3 * s2 - 2 * s;
+
+            for (uint32_t j = 0; j < mStride; j++)
+            {
+                q[j] = h00 * p0[j] + h10 * v0[j] + h01 * p1[j] + h11 * v1[j];
+            }
+            if (dq)
+            {
+                for (uint32_t j = 0; j < mStride; j++)
+                {
+                    dq[j] = d00 * p0[j] + d10 * v0[j] + d01 * p1[j] + d11 * v1[j];
+                }
+            }
+            return;
+        }
+
+        const float* __restrict a0 = &mAcceleration[i * mStride];
+        const float* __restrict a1 = a0 + mStride;
+
+        /*
+         * quintic hermite basis
+         */
+        const float s2 = s * s, s3 = s2 * s, s4 = s3 * s, s5 = s4 * s;
+        const float hh = h * h;
+        const float b0 = 1 - 10 * s3 + 15 * s4 - 6 * s5;
+        const float b1 = (s - 6 * s3 + 8 * s4 - 3 * s5) * h;
+        const float b2 = (0.5f * s2 - 1.5f * s3 + 1.5f * s4 - 0.5f * s5) * hh;
+        const float b3 = 0.5f * (s3 - 2 * s4 + s5) * hh;
+        const float b4 = (-4 * s3 + 7 * s4 - 3 * s5) * h;
+        const float b5 = 10 * s3 - 15 * s4 + 6 * s5;
+
+        for (uint32_t j = 0; j < mStride; j++)
+        {
+            q[j] = b0 * p0[j] + b1 * v0[j] + b2 * a0[j] + b3 * a1[j] + b4 * v1[j] + b5 * p1[j];
+        }
+
+        if (dq)
+        {
+            const float e0 = (-30 * s2 + 60 * s3 - 30 * s4) / h;
+            const float e1 = 1 - 18 * s2 + 32 * s3 - 15 * s4;
+            const float e2 = (s - 4.5f * s2 + 6 * s3 - 2.5f * s4) * h;
+            const float e3 = 0.5f * (3 * s2 - 8 * s3 + 5 * s4) * h;
+            const float e4 = -12 * s2 + 28 * s3 - 15 * s4;
+            const float e5 = -e0;
+
+            for (uint32_t j = 0; j < mStride; j++)
+            {
+                dq[j] = e0 * p0[j] + e1 * v0[j] + e2 * a0[j] + e3 * a1[j] + e4 * v1[j] + e5 * p1[j];
+            }
+        }
+    }
+
+private:
+    void Differentiate(const std::vector<float>& x, std::vector<float>& dx) const
+    {
+        const size_t n = mTime.size();
+        for (size_t i = 1; i + 1 < n; i++)
+        {
+            const float inv = (float)(1.0 / (mTime[i + 1] - mTime[i - 1]));
+            const float* __restrict a = &x[(i - 1) * mStride];
+            const float* __restrict b = &x[(i + 1) * mStride];
+            float* __restrict d = &dx[i * mStride];
+            for (uint32_t j = 0; j < mStride; j++)
+            {
+                d[j] = (b[j] - a[j]) * inv;
+            }
+        }
+    }
+
+    void Copy(size_t knot, float* q, float* dq) const
+    {
+        std::copy(&mPosition[knot * mStride], &mPosition[knot * mStride] + mStride, q);
+        if (dq)
+        {
+            if (mInterpolation == TRAJECTORY_LINEAR || mVelocity.empty())
+            {
+                std::fill(dq, dq + mStride, 0.0f);
+            }
+            else
+            {
+                std::copy(&mVelocity[knot * mStride], &mVelocity[knot * mStride] + mStride, dq);
+            }
+        }
+    }
+
+private:
+    uint32_t mDof;
+    uint32_t mStride;
+    TrajectoryInterpolation mInterpolation;
+
+    std::vector<double> mTime;
+    std::vector<float> mPosition;
+    std::vector<float> mVelocity;
+    std::vector<float> mAcceleration;
+};
+
+using TrajectoryPtr = std::shared_ptr<const Trajectory>;
+
+/*
+ * TrajectoryPlayer
+ *
+ * Plays one trajectory at a time on a caller supplied clock. Play() switches
+ * to a new trajectory, cross-fading from the output at the switch time over
+ * blendTime with a smoothstep weight so position and velocity stay
+ * continuous. Play may be called from any thread, Evaluate from one.
+ */
+class TrajectoryPlayer
+{
+public:
+    explicit TrajectoryPlayer(uint32_t dof) :
+        mDof(dof), mStride(GetMotionClipStride(dof)), mStartTime(0.0), mBlendStart(0.0), mBlendTime(0.0),
+        mQ(mStride, 0.0f), mDq(mStride, 0.0f), mFromQ(mStride, 0.0f), mFromDq(mStride, 0.0f),
+        mTargetQ(mStride, 0.0f), mTargetDq(mStride, 0.0f)
+    {}
+
+    /*
+     * @brief hold a pose until the first Play, e.g. the measured joint state.
+     *        locked against Play only; Evaluate writes the pose outside the
+     *        lock, so call it before playback starts, not during Evaluate.
+     */
+    void SetPose(const float* q)
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+        std::copy(q, q + mDof, mQ.begin());
+        std::fill(mDq.begin(), mDq.end(), 0.0f);
+        mTrajectory.reset();
+        mPending.reset();
+    }
+
+    /*
+     * @brief start trajectory at time now (trajectory time 0 maps to now).
+     */
+    void Play(const TrajectoryPtr& trajectory, double now, double blendTime = 0.5)
+    {
+        UT_THROW_IF(trajectory->GetDof() != mDof, common::CommonException, "trajectory dof mismatch");
+
+        common::LockGuard<common::Mutex> guard(mMutex);
+        mPending = trajectory;
+        mPendingStart = now;
+        mPendingBlend = blendTime;
+    }
+
+    /*
+     * @brief evaluate at now. q and dq point to GetStride() floats owned by
+     *        the player, valid until the next Evaluate.
+     */
+    void Evaluate(double now, const float*& q, const float*& dq)
+    {
+        {
+            common::LockGuard<common::Mutex> guard(mMutex);
+            if (mPending)
+            {
+                /*
+                 * cross-fade from the last output, which already contains any
+                 * blend in progress, carried forward to the switch time
+                 */
+                const float lag = (float)std::max(0.0, mPendingStart - mLastTime);
+                for (uint32_t j = 0; j < mStride; j++)
+                {
+                    mFromQ[j] = mQ[j] + mDq[j] * lag;
+                    mFromDq[j] = mDq[j];
+                }
+                mTrajectory = mPending;
+                mHint = 0;
+                mStartTime = mPendingStart;
+                mBlendStart = mPendingStart;
+                mBlendTime = mPendingBlend;
+                mPending.reset();
+            }
+        }
+
+        q = mQ.data();
+        dq = mDq.data();
+        mLastTime = now;
+
+        if (!mTrajectory)
+        {
+            return;
+        }
+
+        mTrajectory->Evaluate(now - mStartTime + mTrajectory->GetStartTime(), mTargetQ.data(), mTargetDq.data(), &mHint);
+
+        const double elapsed = now - mBlendStart;
+        if (mBlendTime <= 0.0 || elapsed >= mBlendTime)
+        {
+            std::copy(mTargetQ.begin(), mTargetQ.end(), mQ.begin());
+            std::copy(mTargetDq.begin(), mTargetDq.end(), mDq.begin());
+            return;
+        }
+
+        /*
+         * the old side extrapolates the switch-time pose with its velocity
+         * fading out linearly, the weight follows smoothstep
+         */
+        const float t = (float)std::max(0.0, elapsed);
+        const float u = (float)(t / mBlendTime);
+        const float w = u * u * (3 - 2 * u);
+        const float dw = (float)(6 * u * (1 - u) / mBlendTime);
+        const float travel = t * (1.0f - 0.5f * u);
+        const float fade = 1.0f - u;
+
+        for (uint32_t j = 0; j < mStride; j++)
+        {
+            const float fromQ = mFromQ[j] + mFromDq[j] * travel;
+            const float fromDq = mFromDq[j] * fade;
+            mQ[j] = fromQ + (mTargetQ[j] - fromQ) * w;
+            mDq[j] = fromDq + (mTargetDq[j] - fromDq) * w + (mTargetQ[j] - fromQ) * dw;
+        }
+    }
+
+    /*
+     * @brief true once the current trajectory has reached its end.
+     */
+    bool IsFinished(double now)
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+        if (mPending)
+        {
+            return false;
+        }
+        return !mTrajectory || now - mStartTime >= mTrajectory->GetEndTime() - mTrajectory->GetStartTime();
+    }
+
+    uint32_t GetDof() const
+    {
+        return mDof;
+    }
+
+    uint32_t GetStride() const
+    {
+        return mStride;
+    }
+
+private:
+    uint32_t mDof;
+    uint32_t mStride;
+
+    common::Mutex mMutex;
+    TrajectoryPtr mPending;
+    double mPendingStart = 0.0;
+    double mPendingBlend = 0.0;
+
+    TrajectoryPtr mTrajectory;
+    double mStartTime;
+    double mBlendStart;
+    double mBlendTime;
+    size_t mHint = 0;
+    double mLastTime = 0.0;
+
+    std::vector<float> mQ;
+    std::vector<float> mDq;
+    std::vector<float> mFromQ;
+    std::vector<float> mFromDq;
+    std::vector<float> mTargetQ;
+    std::vector<float> mTargetDq;
+};
+
+}
+}
+}
+
+#endif//__UT_ROBOT_MOTION_TRAJECTORY_HPP__
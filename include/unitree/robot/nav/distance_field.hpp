@@ -0,0 +1,455 @@
+#ifndef __UT_ROBOT_NAV_DISTANCE_FIELD_HPP__
+#define __UT_ROBOT_NAV_DISTANCE_FIELD_HPP__
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include <unitree/idl/ros2/OccupancyGrid_.hpp>
+#include <unitree/common/thread/parallel_task.hpp>
+
+namespace unitree
+{
+namespace robot
+{
+namespace nav
+{
+/*
+ * OccupancyGrid_ cell value of an unknown cell (int8 -1 on the wire).
+ */
+const uint8_t UT_OCCUPANCY_UNKNOWN = 255;
+
+/*
+ * DistanceFieldParam
+ */
+struct DistanceFieldParam
+{
+    /*
+     * cells with value in [occupiedThreshold, 100] are obstacles.
+     */
+    uint8_t occupiedThreshold = 65;
+
+    /*
+     * treat unknown cells as obstacles.
+     */
+    bool unknownOccupied = false;
+
+    /*
+     * distances are clamped to +/- maxDistance meter. a finite value bounds
+     * how far a change can propagate and enables windowed recomputation.
+     */
+    float maxDistance = 2.0f;
+
+    /*
+     * worker threads (including caller), rows/columns are split between them.
+     */
+    uint32_t threadNumber = 1;
+};
+
+/*
+ * DistanceField
+ *
+ * Signed Euclidean distance field over an OccupancyGrid_, in meter:
+ * free cells hold the distance to the nearest obstacle, obstacle cells hold
+ * minus the distance to the nearest free cell.
+ *
+ * Uses the linear time squared distance transform of Felzenszwalb and
+ * Huttenlocher, one 1D pass along rows and one along columns, each split
+ * across threads. When a grid only changes inside a window, only the window
+ * dilated by maxDistance is rewritten, computed from the window dilated by
+ * 2 * maxDistance; the result is identical to a full recomputation because
+ * nothing farther than maxDistance can influence a clamped distance.
+ */
+class DistanceField
+{
+public:
+    explicit DistanceField(const DistanceFieldParam& param = DistanceFieldParam()) :
+        mParam(param), mParallel(param.threadNumber), mWidth(0), mHeight(0), mResolution(0.0f),
+        mOriginX(0.0), mOriginY(0.0)
+    {
+        mScratch.resize(mParallel.GetThreadNumber());
+    }
+
+    ~DistanceField()
+    {}
+
+    const DistanceFieldParam& GetParam() const
+    {
+        return mParam;
+    }
+
+    /*
+     * @brief update from a grid. if geometry is unchanged the changed window
+     *        is found by diffing against the previous grid.
+     * @return false if the grid is malformed.
+     */
+    bool Update(const nav_msgs::msg::dds_::OccupancyGrid_& grid)
+    {
+        if (!CheckGrid(grid))
+        {
+            return false;
+        }
+
+        if (!SameGeometry(grid))
+        {
+            return FullUpdate(grid);
+        }
+
+        const uint32_t w = mWidth, h = mHeight;
+        const uint8_t* cur = grid.data().data();
+        const uint8_t* prev = mPrevious.data();
+
+        uint32_t x0 = w, y0 = h, x1 = 0, y1 = 0;
+        for (uint32_t y = 0; y < h; y++)
+        {
+            const uint8_t* a = cur + (size_t)y * w;
+            const uint8_t* b = prev + (size_t)y * w;
+            if (memcmp(a, b, w) == 0)
+            {
+                continue;
+            }
+
+            uint32_t first = 0, last = w - 1;
+            while (a[first] == b[first])
+            {
+                first++;
+            }
+            while (a[last] == b[last])
+            {
+                last--;
+            }
+
+            x0 = std::min(x0, first);
+            x1 = std::max(x1, last + 1);
+            y0 = std::min(y0, y);
+            y1 = y + 1;
+        }
+
+        return WindowUpdate(grid, x0, y0, x1, y1);
+    }
+
+    /*
+     * @brief update from a grid whose cells changed only inside [x0, x1) x [y0, y1).
+     */
+    bool Update(const nav_msgs::msg::dds_::OccupancyGrid_& grid, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1)
+    {
+        if (!CheckGrid(grid))
+        {
+            return false;
+        }
+
+        if (!SameGeometry(grid))
+        {
+            return FullUpdate(grid);
+        }
+
+        return WindowUpdate(grid, std::min(x0, mWidth), std::min(y0, mHeight),
+            std::min(x1, mWidth), std::min(y1, mHeight));
+    }
+
+    uint32_t GetWidth() const
+    {
+        return mWidth;
+    }
+
+    uint32_t GetHeight() const
+    {
+        return mHeight;
+    }
+
+    float GetResolution() const
+    {
+        return mResolution;
+    }
+
+    /*
+     * @brief row major field, field[y * width + x].
+     */
+    const std::vector<float>& GetField() const
+    {
+        return mField;
+    }
+
+    float GetDistance(uint32_t x, uint32_t y) const
+    {
+        return mField[(size_t)y * mWidth + x];
+    }
+
+    /*
+     * @brief distance at a map frame position, maxDistance outside the grid.
+     *        the grid origin is assumed axis aligned.
+     */
+    float GetDistanceAt(double px, double py) const
+    {
+        if (mResolution <= 0.0f)
+        {
+            return mParam.maxDistance;
+        }
+
+        const double fx = std::floor((px - mOriginX) / mResolution);
+        const double fy = std::floor((py - mOriginY) / mResolution);
+        if (fx < 0 || fy < 0 || fx >= mWidth || fy >= mHeight)
+        {
+            return mParam.maxDistance;
+        }
+
+        return GetDistance((uint32_t)fx, (uint32_t)fy);
+    }
+
+    /*
+     * @brief cells rewritten by the last update, [x0, x1) x [y0, y1).
+     */
+    void GetUpdatedWindow(uint32_t& x0, uint32_t& y0, uint32_t& x1, uint32_t& y1) const
+    {
+        x0 = mUpdated[0];
+        y0 = mUpdated[1];
+        x1 = mUpdated[2];
+        y1 = mUpdated[3];
+    }
+
+private:
+    struct Scratch
+    {
+        std::vector<float> f;
+        std::vector<float> z;
+        std::vector<int32_t> v;
+
+        void Resize(size_t n)
+        {
+            if (f.size() < n)
+            {
+                f.resize(n);
+                z.resize(n + 1);
+                v.resize(n);
+            }
+        }
+    };
+
+    static constexpr float BIG = 1.0e20f;
+
+    bool CheckGrid(const nav_msgs::msg::dds_::OccupancyGrid_& grid) const
+    {
+        const auto& info = grid.info();
+        return info.width() > 0 && info.height() > 0 && info.resolution() > 0.0f &&
+            grid.data().size() == (size_t)info.width() * info.height();
+    }
+
+    bool SameGeometry(const nav_msgs::msg::dds_::OccupancyGrid_& grid) const
+    {
+        const auto& info = grid.info();
+        return info.width() == mWidth && info.height() == mHeight && info.resolution() == mResolution &&
+            info.origin().position().x() == mOriginX && info.origin().position().y() == mOriginY;
+    }
+
+    bool FullUpdate(const nav_msgs::msg::dds_::OccupancyGrid_& grid)
+    {
+        const auto& info = grid.info();
+        mWidth = info.width();
+        mHeight = info.height();
+        mResolution = info.resolution();
+        mOriginX = info.origin().position().x();
+        mOriginY = info.origin().position().y();
+
+        mField.resize((size_t)mWidth * mHeight);
+
+        Compute(grid.data().data(), 0, 0, mWidth, mHeight, 0, 0, mWidth, mHeight);
+        mPrevious = grid.data();
+
+        return true;
+    }
+
+    bool WindowUpdate(const nav_msgs::msg::dds_::OccupancyGrid_& grid, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1)
+    {
+        if (x0 >= x1 || y0 >= y1)
+        {
+            mUpdated = { { 0, 0, 0, 0 } };
+            return true;
+        }
+
+        const float cells = mParam.maxDistance / mResolution;
+        if (!(cells < (float)std::max(mWidth, mHeight)))
+        {
+            return FullUpdate(grid);
+        }
+
+        const uint32_t r = (uint32_t)std::ceil(cells);
+
+        auto lower = [](uint32_t v, uint32_t d) { return v > d ? v - d : 0; };
+        auto upper = [](uint32_t v, uint32_t d, uint32_t n) { return std::min(n, v + d); };
+
+        Compute(grid.data().data(),
+            lower(x0, 2 * r), lower(y0, 2 * r), upper(x1, 2 * r, mWidth), upper(y1, 2 * r, mHeight),
+            lower(x0, r), lower(y0, r), upper(x1, r, mWidth), upper(y1, r, mHeight));
+
+        for (uint32_t y = y0; y < y1; y++)
+        {
+            const size_t offset = (size_t)y * mWidth + x0;
+            memcpy(&mPrevious[offset], grid.data().data() + offset, x1 - x0);
+        }
+
+        return true;
+    }
+
+    bool IsOccupied(uint8_t value) const
+    {
+        if (value == UT_OCCUPANCY_UNKNOWN)
+        {
+            return mParam.unknownOccupied;
+        }
+        return value >= mParam.occupiedThreshold && value <= 100;
+    }
+
+    /*
+     * @brief transform region [sx0, sx1) x [sy0, sy1), write [ox0, ox1) x [oy0, oy1) into the field.
+     */
+    void Compute(const uint8_t* data, uint32_t sx0, uint32_t sy0, uint32_t sx1, uint32_t sy1,
+        uint32_t ox0, uint32_t oy0, uint32_t ox1, uint32_t oy1)
+    {
+        const uint32_t w = sx1 - sx0, h = sy1 - sy0;
+        const size_t n = (size_t)w * h;
+
+        mOccupied.resize(n);
+        mToObstacle.resize(n);
+        mToFree.resize(n);
+
+        for (Scratch& s : mScratch)
+        {
+            s.Resize(std::max(w, h));
+        }
+
+        /*
+         * pass 1: along x, squared distance to obstacle and to free space
+         */
+        mParallel.Range(h, [&](uint32_t part, size_t begin, size_t end) {
+            Scratch& s = mScratch[part];
+            for (size_t y = begin; y < end; y++)
+            {
+                const uint8_t* src = data + (sy0 + y) * (size_t)mWidth + sx0;
+                uint8_t* occ = &mOccupied[y * w];
+                for (uint32_t x = 0; x < w; x++)
+                {
+                    occ[x] = IsOccupied(src[x]);
+                }
+
+                for (uint32_t x = 0; x < w; x++)
+                {
+                    s.f[x] = occ[x] ? 0.0f : BIG;
+                }
+                Transform(s, w, &mToObstacle[y * w], 1);
+
+                for (uint32_t x = 0; x < w; x++)
+                {
+                    s.f[x] = occ[x] ? BIG : 0.0f;
+                }
+                Transform(s, w, &mToFree[y * w], 1);
+            }
+        });
+
+        /*
+         * pass 2: along y, only output columns are needed
+         */
+        const uint32_t cx0 = ox0 - sx0, cx1 = ox1 - sx0;
+        mParallel.Range(cx1 - cx0, [&](uint32_t part, size_t begin, size_t end) {
+            Scratch& s = mScratch[part];
+            for (size_t x = cx0 + begin; x < cx0 + end; x++)
+            {
+                for (std::vector<float>* buffer : { &mToObstacle, &mToFree })
+                {
+                    float* column = buffer->data() + x;
+                    for (uint32_t y = 0; y < h; y++)
+                    {
+                        s.f[y] = column[(size_t)y * w];
+                    }
+                    Transform(s, h, column, w);
+                }
+            }
+        });
+
+        const float res = mResolution;
+        const float limit = mParam.maxDistance;
+
+        mParallel.Range(oy1 - oy0, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t y = oy0 + begin; y < oy0 + end; y++)
+            {
+                const size_t row = (y - sy0) * w - sx0;
+                float* out = &mField[y * mWidth];
+                for (uint32_t x = ox0; x < ox1; x++)
+                {
+                    const size_t i = row + x;
+                    float d = mOccupied[i] ? -std::sqrt(mToFree[i]) * res : std::sqrt(mToObstacle[i]) * res;
+                    out[x] = std::max(-limit, std::min(limit, d));
+                }
+            }
+        });
+
+        mUpdated = { { ox0, oy0, ox1, oy1 } };
+    }
+
+    /*
+     * @brief 1D squared distance transform of s.f[0, n), written to out[i * stride].
+     */
+    static void Transform(Scratch& s, uint32_t n, float* out, size_t stride)
+    {
+        const float* f = s.f.data();
+        float* z = s.z.data();
+        int32_t* v = s.v.data();
+
+        int32_t k = 0;
+        v[0] = 0;
+        z[0] = -std::numeric_limits<float>::infinity();
+        z[1] = std::numeric_limits<float>::infinity();
+
+        for (int32_t q = 1; q < (int32_t)n; q++)
+        {
+            const float fq = f[q] + (float)q * q;
+            float sq = (fq - (f[v[k]] + (float)v[k] * v[k])) / (2.0f * (q - v[k]));
+            while (sq <= z[k])
+            {
+                k--;
+                sq = (fq - (f[v[k]] + (float)v[k] * v[k])) / (2.0f * (q - v[k]));
+            }
+            k++;
+            v[k] = q;
+            z[k] = sq;
+            z[k + 1] = std::numeric_limits<float>::infinity();
+        }
+
+        k = 0;
+        for (int32_t q = 0; q < (int32_t)n; q++)
+        {
+            while (z[k + 1] < q)
+            {
+                k++;
+            }
+            const float dq = (float)(q - v[k]);
+            out[q * stride] = dq * dq + f[v[k]];
+        }
+    }
+
+private:
+    DistanceFieldParam mParam;
+    common::ParallelTask mParallel;
+
+    uint32_t mWidth;
+    uint32_t mHeight;
+    float mResolution;
+    double mOriginX;
+    double mOriginY;
+
+    std::vector<float> mField;
+    std::vector<uint8_t> mPrevious;
+    std::array<uint32_t, 4> mUpdated = { { 0, 0, 0, 0 } };
+
+    std::vector<uint8_t> mOccupied;
+    std::vector<float> mToObstacle;
+    std::vector<float> mToFree;
+    std::vector<Scratch> mScratch;
+};
+
+using DistanceFieldPtr = std::shared_ptr<DistanceField>;
+
+}
+}
+}
+
+#endif//__UT_ROBOT_NAV_DISTANCE_FIELD_HPP__
@@ -0,0 +1,194 @@
+#ifndef __UT_ROBOT_SDK_CHUNKED_UPLOAD_RECEIVER_HPP__
+#define __UT_ROBOT_SDK_CHUNKED_UPLOAD_RECEIVER_HPP__
+
+#include <unitree/robot/server/server.hpp>
+#include <unitree/common/time/time_tool.hpp>
+
+#include <map>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * @brief  called once per completed upload with the reassembled payload.
+ */
+using UploadHandler = std::function<int32_t(const std::string& streamId, const std::string& parameter,
+    std::vector<uint8_t>& payload, std::string& data)>;
+
+/*
+ * @brief
+ * @class: ChunkedUploadReceiver
+ *
+ * Server side of ChunkedUploadClient. Chunks are accepted only at the
+ * committed offset (go-back-N), so the payload is reassembled in place in a
+ * buffer reserved once from the announced total. A finished stream is kept
+ * for expireMicrosec so a retransmitted last chunk is still acknowledged.
+ *
+ * A Server routes an upload api here from its ServerRequestHandler override:
+ *
+ *     if (request->header().identity().api_id() == MY_UPLOAD_API_ID)
+ *     {
+ *         SendResponse(mReceiver.Receive(*request));
+ *         return;
+ *     }
+ *     Server::ServerRequestHandler(request);
+ */
+class ChunkedUploadReceiver
+{
+public:
+    explicit ChunkedUploadReceiver(const UploadHandler& handler, uint64_t maxTotal = 64 * 1024 * 1024,
+        int64_t expireMicrosec = 10000000) :
+        mHandler(handler), mMaxTotal(maxTotal), mExpireMicrosec(expireMicrosec)
+    {}
+
+    ~ChunkedUploadReceiver()
+    {}
+
+    Response Receive(const Request& request)
+    {
+        Response response;
+        response.header().identity(request.header().identity());
+
+        UploadChunkParameter parameter;
+        UploadChunkData ack;
+        int32_t code = UT_ROBOT_OK;
+
+        try
+        {
+            common::FromJsonString(request.parameter(), parameter);
+        }
+        catch (const common::Exception&)
+        {
+            response.header().status().code(UT_ROBOT_ERR_SERVER_API_PARAMETER);
+            return response;
+        }
+
+        {
+            common::LockGuard<common::Mutex> guard(mMutex);
+            Expire();
+            code = Accept(parameter, request.binary(), ack);
+        }
+
+        response.header().status().code(code);
+        if (code == UT_ROBOT_OK)
+        {
+            response.data(common::ToJsonString(ack));
+        }
+
+        return response;
+    }
+
+    size_t GetStreamNumber()
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+        return mStreamMap.size();
+    }
+
+private:
+    struct Stream
+    {
+        uint64_t total = 0;
+        std::string parameter;
+        std::vector<uint8_t> payload;
+        bool complete = false;
+        std::string data;
+        int64_t updateTime = 0;
+    };
+
+    int32_t Accept(const UploadChunkParameter& parameter, const std::vector<uint8_t>& chunk, UploadChunkData& ack)
+    {
+        auto iter = mStreamMap.find(parameter.streamId);
+
+        if (parameter.sequence == ROBOT_UPLOAD_SEQUENCE_QUERY)
+        {
+            if (iter != mStreamMap.end() && iter->second.total == parameter.total)
+            {
+                ack.committed = iter->second.complete ? iter->second.total : iter->second.payload.size();
+                ack.complete = iter->second.complete;
+                ack.data = iter->second.data;
+            }
+            return UT_ROBOT_OK;
+        }
+
+        if (iter == mStreamMap.end())
+        {
+            if (parameter.offset != 0 || parameter.total > mMaxTotal)
+            {
+                return UT_ROBOT_ERR_SERVER_UPLOAD_STREAM;
+            }
+
+            iter = mStreamMap.emplace(parameter.streamId, Stream()).first;
+            iter->second.total = parameter.total;
+            iter->second.parameter = parameter.parameter;
+            iter->second.payload.reserve(parameter.total);
+        }
+
+        Stream& stream = iter->second;
+        if (stream.total != parameter.total)
+        {
+            return UT_ROBOT_ERR_SERVER_UPLOAD_STREAM;
+        }
+
+        stream.updateTime = common::GetCurrentMonotonicTimeMicrosecond();
+
+        /*
+         * append at the committed offset only, duplicates and gaps just ack
+         */
+        if (!stream.complete && parameter.offset == stream.payload.size() &&
+            stream.payload.size() + chunk.size() <= stream.total)
+        {
+            stream.payload.insert(stream.payload.end(), chunk.begin(), chunk.end());
+
+            if (stream.payload.size() == stream.total)
+            {
+                int32_t code = mHandler ? mHandler(parameter.streamId, stream.parameter, stream.payload, stream.data) : UT_ROBOT_OK;
+                if (code != UT_ROBOT_OK)
+                {
+                    mStreamMap.erase(iter);
+                    return code;
+                }
+
+                stream.complete = true;
+                std::vector<uint8_t>().swap(stream.payload);
+            }
+        }
+
+        ack.committed = stream.complete ? stream.total : stream.payload.size();
+        ack.complete = stream.complete;
+        ack.data = stream.data;
+
+        return UT_ROBOT_OK;
+    }
+
+    void Expire()
+    {
+        int64_t now = common::GetCurrentMonotonicTimeMicrosecond();
+        for (auto iter = mStreamMap.begin(); iter != mStreamMap.end();)
+        {
+            if (now - iter->second.updateTime > mExpireMicrosec)
+            {
+                iter = mStreamMap.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
+
+private:
+    UploadHandler mHandler;
+    uint64_t mMaxTotal;
+    int64_t mExpireMicrosec;
+
+    common::Mutex mMutex;
+    std::map<std::string,Stream> mStreamMap;
+};
+
+using ChunkedUploadReceiverPtr = std::shared_ptr<ChunkedUploadReceiver>;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_CHUNKED_UPLOAD_RECEIVER_HPP__
@@ -0,0 +1,177 @@
+#ifndef __UT_ROBOT_SDK_MOCK_SERVER_HPP__
+#define __UT_ROBOT_SDK_MOCK_SERVER_HPP__
+
+#include <unitree/robot/server/server.hpp>
+#include <unitree/common/time/sleep.hpp>
+
+#include <atomic>
+#include <random>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * MockServerParam
+ */
+struct MockServerParam
+{
+    /*
+     * delay before each request is handled, plus a uniform 0..jitter.
+     */
+    int64_t latencyMicrosec = 0;
+    int64_t jitterMicrosec = 0;
+
+    /*
+     * fraction of requests answered with failureCode instead of the handler.
+     */
+    float failureRate = 0.0f;
+    int32_t failureCode = UT_ROBOT_ERR_SERVER_INTERNAL;
+
+    /*
+     * fraction of requests never answered, the client runs into its timeout.
+     */
+    float dropRate = 0.0f;
+
+    /*
+     * bytes returned by apis that carry a payload, 0 for the api default.
+     */
+    size_t payloadSize = 0;
+
+    uint32_t seed = 1;
+};
+
+/*
+ * @brief
+ * @class: MockServer
+ *
+ * Server with latency, failure and drop injection in front of the
+ * registered handlers, base of the mock services that stand in for the
+ * robot's high level apis. Injection runs on the server's request thread,
+ * so latency delays the requests queued behind it as a busy service would.
+ *
+ * Derived mocks register handlers in Init as any Server does:
+ *
+ *     class MyMockServer : public MockServer
+ *     {
+ *     public:
+ *         MyMockServer() : MockServer(MY_SERVICE_NAME) {}
+ *
+ *         void Init()
+ *         {
+ *             SetApiVersion(MY_API_VERSION);
+ *             UT_ROBOT_SERVER_REG_API_HANDLER_NO_LEASE(MY_API_ID, &MyMockServer::Handler);
+ *         }
+ *     };
+ */
+class MockServer : public Server
+{
+public:
+    explicit MockServer(const std::string& name, const MockServerParam& param = MockServerParam()) :
+        Server(name), mParam(param), mRandom(param.seed), mRequestNumber(0), mFailureNumber(0), mDropNumber(0)
+    {}
+
+    virtual ~MockServer()
+    {}
+
+    /*
+     * @brief takes effect from the next request.
+     */
+    void SetParam(const MockServerParam& param)
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+        mParam = param;
+        mRandom.seed(param.seed);
+    }
+
+    MockServerParam GetParam()
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+        return mParam;
+    }
+
+    uint64_t GetRequestNumber() const
+    {
+        return mRequestNumber;
+    }
+
+    uint64_t GetFailureNumber() const
+    {
+        return mFailureNumber;
+    }
+
+    uint64_t GetDropNumber() const
+    {
+        return mDropNumber;
+    }
+
+protected:
+    void ServerRequestHandler(const RequestPtr& request)
+    {
+        MockServerParam param;
+        int64_t delay = 0;
+        float drop = 1.0f, failure = 1.0f;
+        {
+            common::LockGuard<common::Mutex> guard(mMutex);
+            param = mParam;
+            delay = param.latencyMicrosec;
+            if (param.jitterMicrosec > 0)
+            {
+                delay += std::uniform_int_distribution<int64_t>(0, param.jitterMicrosec)(mRandom);
+            }
+            drop = std::uniform_real_distribution<float>(0.0f, 1.0f)(mRandom);
+            failure = std::uniform_real_distribution<float>(0.0f, 1.0f)(mRandom);
+        }
+
+        mRequestNumber++;
+
+        if (delay > 0)
+        {
+            common::MicroSleep(delay);
+        }
+
+        if (drop < param.dropRate)
+        {
+            mDropNumber++;
+            return;
+        }
+
+        if (failure < param.failureRate)
+        {
+            mFailureNumber++;
+
+            Response response;
+            response.header().identity(request->header().identity());
+            response.header().status().code(param.failureCode);
+            SendResponse(response);
+            return;
+        }
+
+        Server::ServerRequestHandler(request);
+    }
+
+    /*
+     * @brief payload size for an api whose default is defaultSize.
+     */
+    size_t GetPayloadSize(size_t defaultSize)
+    {
+        common::LockGuard<common::Mutex> guard(mMutex);
+        return mParam.payloadSize > 0 ? mParam.payloadSize : defaultSize;
+    }
+
+private:
+    common::Mutex mMutex;
+    MockServerParam mParam;
+    std::mt19937 mRandom;
+
+    std::atomic<uint64_t> mRequestNumber;
+    std::atomic<uint64_t> mFailureNumber;
+    std::atomic<uint64_t> mDropNumber;
+};
+
+using MockServerPtr = std::shared_ptr<MockServer>;
+
+}
+}
+
+#endif//__UT_ROBOT_SDK_MOCK_SERVER_HPP__
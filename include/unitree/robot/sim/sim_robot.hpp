@@ -0,0 +1,386 @@
+#ifndef __UT_ROBOT_SIM_ROBOT_HPP__
+#define __UT_ROBOT_SIM_ROBOT_HPP__
+
+#include <unitree/robot/control/control_loop.hpp>
+#include <unitree/robot/model/robot_model.hpp>
+
+#include <cmath>
+
+namespace unitree
+{
+namespace robot
+{
+/*
+ * SimRobotParam
+ */
+struct SimRobotParam
+{
+    std::string cmdTopic = UT_CONTROL_LOWCMD_TOPIC;
+    std::string stateTopic = UT_CONTROL_LOWSTATE_TOPIC;
+
+    /*
+     * LowState_ rate in simulated time, 500 or 1000 like the robots.
+     */
+    double frequency = 500.0;
+
+    /*
+     * simulated seconds per wall second. 2 publishes at twice the wall
+     * rate, the controller has to be scaled the same way. <= 0 runs the
+     * loop as fast as it can.
+     */
+    double timeScale = 1.0;
+
+    /*
+     * dynamics steps per published state.
+     */
+    uint32_t substep = 1;
+
+    /*
+     * drop LowCmd_ with a wrong crc, as the robot does.
+     */
+    bool checkCrc = true;
+
+    int32_t cpuId = UT_CPU_ID_NONE;
+};
+
+/*
+ * SimJointDynamics
+ *
+ * Every joint of Model is an independent rigid rotor with inertia and
+ * viscous damping, driven by the motor's PD law
+ *
+ *     tau = kp * (q_des - q) + kd * (dq_des - dq) + tau_ff
+ *
+ * clamped to TAU_MAX, integrated with semi-implicit Euler, stopped at the
+ * position limits. A motor with mode 0 is unpowered. There is no gravity,
+ * contact or base motion; the IMU stays upright.
+ */
+template<typename Model>
+class SimJointDynamics
+{
+public:
+    using LowCmd = typename Model::LowCmd;
+    using LowState = typename Model::LowState;
+
+    explicit SimJointDynamics(float inertia = 0.05f, float damping = 0.1f)
+    {
+        mInertia.fill(inertia);
+        mDamping.fill(damping);
+        mQ = Model::DEFAULT_Q;
+        mDq.fill(0.0f);
+    }
+
+    void SetInertia(size_t joint, float inertia)
+    {
+        mInertia[joint] = inertia;
+    }
+
+    void SetDamping(size_t joint, float damping)
+    {
+        mDamping[joint] = damping;
+    }
+
+    /*
+     * @brief initial position, before Reset.
+     */
+    void SetPosition(size_t joint, float q)
+    {
+        mQ[joint] = model::ClampJoint<Model>(joint, q);
+    }
+
+    void Reset(LowState& state)
+    {
+        state.imu_state().quaternion()[0] = 1.0f;
+        model::ForEachJoint<Model>([&](auto joint)
+        {
+            auto& motor = state.motor_state()[Model::MOTOR_INDEX[joint]];
+            motor.q(mQ[joint]);
+            motor.dq(mDq[joint]);
+        });
+    }
+
+    void Step(const LowCmd& cmd, LowState& state, double dt)
+    {
+        const float h = (float)dt;
+
+        model::ForEachJoint<Model>([&](auto joint)
+        {
+            const auto& motorCmd = cmd.motor_cmd()[Model::MOTOR_INDEX[joint]];
+            auto& motor = state.motor_state()[Model::MOTOR_INDEX[joint]];
+
+            float tau = 0.0f;
+            if (motorCmd.mode() != 0)
+            {
+                tau = motorCmd.kp() * (motorCmd.q() - mQ[joint]) + motorCmd.kd() * (motorCmd.dq() - mDq[joint]) + motorCmd.tau();
+                tau = std::fmin(std::fmax(tau, -Model::TAU_MAX[joint]), Model::TAU_MAX[joint]);
+            }
+
+            const float ddq = (tau - mDamping[joint] * mDq[joint]) / mInertia[joint];
+            float dq = std::fmin(std::fmax(mDq[joint] + ddq * h, -Model::DQ_MAX[joint]), Model::DQ_MAX[joint]);
+            float q = mQ[joint] + dq * h;
+
+            if (q < Model::Q_MIN[joint] || q > Model::Q_MAX[joint])
+            {
+                q = model::ClampJoint<Model>(joint, q);
+                dq = 0.0f;
+            }
+
+            mQ[joint] = q;
+            mDq[joint] = dq;
+
+            motor.mode(motorCmd.mode());
+            motor.q(q);
+            motor.dq(dq);
+            motor.ddq(ddq);
+            motor.tau_est(tau);
+        });
+    }
+
+private:
+    std::array<float, Model::JOINT_NUMBER> mInertia;
+    std::array<float, Model::JOINT_NUMBER> mDamping;
+    std::array<float, Model::JOINT_NUMBER> mQ;
+    std::array<float, Model::JOINT_NUMBER> mDq;
+};
+
+/*
+ * SimCallbackDynamics
+ *
+ * Dynamics given as a callback, e.g. a step of an external physics engine.
+ * state holds the previous output; the callback updates it in place.
+ */
+template<typename Model>
+class SimCallbackDynamics
+{
+public:
+    using LowCmd = typename Model::LowCmd;
+    using LowState = typename Model::LowState;
+    using Callback = std::function<void(const LowCmd& cmd, LowState& state, double dt)>;
+
+    explicit SimCallbackDynamics(const Callback& callback) :
+        mCallback(callback)
+    {}
+
+    void Reset(LowState& state)
+    {
+        state.imu_state().quaternion()[0] = 1.0f;
+    }
+
+    void Step(const LowCmd& cmd, LowState& state, double dt)
+    {
+        mCallback(cmd, state, dt);
+    }
+
+private:
+    Callback mCallback;
+};
+
+/*
+ * SimRobot
+ *
+ * Stand-in for the robot's low level interface: subscribes LowCmd_, steps
+ * the dynamics with the newest command at a fixed rate and publishes
+ * LowState_ with tick and crc filled in. The command handler only copies
+ * into a triple buffer, the loop thread does the rest.
+ *
+ * Dynamics provides the message family and two calls:
+ *
+ *     struct MyDynamics
+ *     {
+ *         using LowCmd = unitree_go::msg::dds_::LowCmd_;
+ *         using LowState = unitree_go::msg::dds_::LowState_;
+ *
+ *         // before the first step
+ *         void Reset(LowState& state);
+ *         // advance dt simulated seconds, state holds the previous output
+ *         void Step(const LowCmd& cmd, LowState& state, double dt);
+ *     };
+ *
+ * Without Start, Step advances one period on the caller's thread; with the
+ * loopback transport this runs controller and robot in lockstep.
+ */
+template<typename Dynamics>
+class SimRobot
+{
+public:
+    using LowCmd = typename Dynamics::LowCmd;
+    using LowState = typename Dynamics::LowState;
+
+    explicit SimRobot(Dynamics& dynamics, const SimRobotParam& param = SimRobotParam()) :
+        mDynamics(dynamics), mParam(param), mTime(0), mQuit(false),
+        mStepNumber(0), mCmdNumber(0), mCrcErrorNumber(0)
+    {
+        if (mParam.substep == 0)
+        {
+            mParam.substep = 1;
+        }
+
+        mDynamics.Reset(mState);
+    }
+
+    ~SimRobot()
+    {
+        Stop();
+    }
+
+    void InitChannel()
+    {
+        mPublisherPtr.reset(new ChannelPublisher<LowState>(mParam.stateTopic));
+        mPublisherPtr->InitChannel();
+
+        mSubscriberPtr.reset(new ChannelSubscriber<LowCmd>(mParam.cmdTopic));
+        mSubscriberPtr->InitChannel(std::bind(&SimRobot::LowCmdHandler, this, std::placeholders::_1), 1);
+    }
+
+    void Start()
+    {
+        if (mThreadPtr)
+        {
+            return;
+        }
+
+        mQuit = false;
+        mThreadPtr = common::CreateThreadEx("simrobot", mParam.cpuId, &SimRobot::LoopThreadFunc, this);
+    }
+
+    void Stop()
+    {
+        if (mSubscriberPtr)
+        {
+            mSubscriberPtr->CloseChannel();
+            mSubscriberPtr.reset();
+        }
+
+        if (mThreadPtr)
+        {
+            mQuit = true;
+            mThreadPtr->Wait();
+            mThreadPtr.reset();
+        }
+    }
+
+    /*
+     * @brief hand a command to the robot, e.g. from another transport.
+     *        single writer: either this or InitChannel.
+     */
+    void SetCmd(const LowCmd& cmd)
+    {
+        mCmd.Write(cmd);
+    }
+
+    /*
+     * @brief one period: newest command, substep dynamics steps, publish.
+     *        not while the loop thread runs.
+     */
+    void Step()
+    {
+        mCmd.Update();
+
+        const double dt = 1.0 / (mParam.frequency * mParam.substep);
+        for (uint32_t i = 0; i < mParam.substep; i++)
+        {
+            mDynamics.Step(mCmd.GetReadBuffer(), mState, dt);
+        }
+
+        const int64_t step = ++mStepNumber;
+        mTime = step / mParam.frequency;
+
+        mState.tick((uint32_t)(step * 1000 / mParam.frequency));
+        mState.crc(common::Crc32Message(mState));
+
+        if (mPublisherPtr)
+        {
+            mPublisherPtr->Write(mState);
+        }
+    }
+
+    /*
+     * @brief last published state, for the thread calling Step.
+     */
+    const LowState& GetState() const
+    {
+        return mState;
+    }
+
+    /*
+     * @brief simulated seconds since construction.
+     */
+    double GetTime() const
+    {
+        return mTime;
+    }
+
+    uint64_t GetStepNumber() const
+    {
+        return mStepNumber;
+    }
+
+    uint64_t GetCmdNumber() const
+    {
+        return mCmdNumber;
+    }
+
+    uint64_t GetCrcErrorNumber() const
+    {
+        return mCrcErrorNumber;
+    }
+
+private:
+    void LowCmdHandler(const void* message)
+    {
+        const LowCmd& cmd = *(const LowCmd*)message;
+        if (mParam.checkCrc && cmd.crc() != common::Crc32Message(cmd))
+        {
+            mCrcErrorNumber++;
+            return;
+        }
+
+        mCmd.Write(cmd);
+        mCmdNumber++;
+    }
+
+    int32_t LoopThreadFunc()
+    {
+        if (mParam.timeScale <= 0)
+        {
+            while (!mQuit)
+            {
+                Step();
+            }
+            return 0;
+        }
+
+        common::DeadlineTimer timer((int64_t)(1e9 / (mParam.frequency * mParam.timeScale)));
+        timer.Start();
+
+        while (!mQuit)
+        {
+            timer.Wait();
+            Step();
+        }
+
+        return 0;
+    }
+
+private:
+    Dynamics& mDynamics;
+    SimRobotParam mParam;
+
+    common::TripleBuffer<LowCmd> mCmd;
+    LowState mState;
+    std::atomic<double> mTime;
+
+    std::shared_ptr<ChannelPublisher<LowState>> mPublisherPtr;
+    std::shared_ptr<ChannelSubscriber<LowCmd>> mSubscriberPtr;
+    common::ThreadPtr mThreadPtr;
+    std::atomic<bool> mQuit;
+
+    std::atomic<uint64_t> mStepNumber;
+    std::atomic<uint64_t> mCmdNumber;
+    std::atomic<uint64_t> mCrcErrorNumber;
+};
+
+}
+}
+
+#endif//__UT_ROBOT_SIM_ROBOT_HPP__